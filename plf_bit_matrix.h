@@ -0,0 +1,606 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_BIT_MATRIX_H
+#define PLF_BIT_MATRIX_H
+
+
+#include "plf_bitsetb.h" // row views, plf::popcount, plf::bitwise_words
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+#define PLF_CONSTEXPR
+#define PLF_CONSTFUNC
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1600
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+	#endif
+
+	#if _MSC_VER >= 1700
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+	#endif
+
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept(!user_supplied_buffer)
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L) && _MSC_VER >= 1929
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+		#define PLF_CPP20_SUPPORT
+	#endif
+
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 3) || __GNUC__ > 4
+			#define PLF_MOVE_SEMANTICS_SUPPORT
+		#endif
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept(!user_supplied_buffer)
+		#endif
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 7) || __GNUC__ > 4
+			#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#endif
+	#elif defined(__clang__)
+		#if !defined(__GLIBCXX__) && !defined(_LIBCPP_CXX03_LANG) && __clang_major__ >= 3
+			#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#endif
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept(!user_supplied_buffer)
+		#endif
+		#if __has_feature(cxx_rvalue_references) && !defined(_LIBCPP_HAS_NO_RVALUE_REFERENCES)
+			#define PLF_MOVE_SEMANTICS_SUPPORT
+		#endif
+	#else // Assume support for other compilers
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept(!user_supplied_buffer)
+	#endif
+
+	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	#if __cplusplus >= 202001L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) &&	_GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+		#define PLF_CPP20_SUPPORT
+	#endif
+#endif
+
+
+
+#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+	#define PLF_ALLOCATE(the_allocator, allocator_instance, size, hint)			std::allocator_traits<the_allocator>::allocate(allocator_instance, size, hint)
+	#define PLF_DEALLOCATE(the_allocator, allocator_instance, location, size)	std::allocator_traits<the_allocator>::deallocate(allocator_instance, location, size)
+#else
+	#define PLF_ALLOCATE(the_allocator, allocator_instance, size, hint)			(allocator_instance).allocate(size, hint)
+	#define PLF_DEALLOCATE(the_allocator, allocator_instance, location, size)	(allocator_instance).deallocate(location, size)
+#endif
+
+
+
+#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
+#define PLF_WORDS_PER_ROW_CALC(number_of_columns) (((number_of_columns) + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH) // ie. round up to nearest unit of storage
+#define PLF_ARRAY_CAPACITY (total_rows * words_per_row)
+
+
+#ifdef __AVX2__
+	#include <immintrin.h>
+#endif
+
+#include <cassert>
+#include <memory> // std::uninitialized_copy, allocator
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <limits>  // std::numeric_limits
+#include <algorithm> // std::fill_n, std::copy, std::equal, std::min
+
+#ifdef PLF_CPP20_SUPPORT
+	#include <type_traits> // std::is_constant_evaluated
+#endif
+
+
+
+namespace plf
+{
+
+
+// A rows x columns bit matrix stored row-major in a single buffer, each row padded to a whole number of storage_types, with the same buffer and allocator model as plf::bitsetb. row() returns a plf::bitsetb<true> view of a row, so the full bitset API is available on rows without copying.
+// As per plf::bitset, the padding bits at the end of each row are always zero.
+template<bool user_supplied_buffer = false, typename storage_type = unsigned long long, class allocator_type = std::allocator<storage_type>, bool hardened = false>
+class bit_matrix : private allocator_type // Empty base class optimisation - inheriting allocator functions
+{
+public:
+	typedef std::size_t size_type;
+	typedef bitsetb<true, storage_type, allocator_type, hardened> row_type;
+	typedef bit_matrix<false, storage_type, allocator_type, hardened> result_type;
+
+private:
+	storage_type *buffer;
+	size_type total_rows, total_columns, words_per_row;
+
+
+
+	PLF_CONSTFUNC void set_overflow_to_zero() PLF_NOEXCEPT
+	{
+		if (total_columns % PLF_TYPE_BITWIDTH == 0) return;
+
+		const storage_type mask = std::numeric_limits<storage_type>::max() >> ((words_per_row * PLF_TYPE_BITWIDTH) - total_columns);
+		for (size_type row = 0; row != total_rows; ++row) buffer[(row * words_per_row) + words_per_row - 1] &= mask;
+	}
+
+
+
+	PLF_CONSTFUNC void check_position_is_within_size(const size_type row, const size_type column) const
+	{
+		if (row >= total_rows || column >= total_columns)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::out_of_range("Position outside of bit_matrix");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	static PLF_CONSTFUNC void throw_length_error(const char * const error_message)
+	{
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			throw std::length_error(error_message);
+		#else
+			(void)error_message;
+			std::terminate();
+		#endif
+	}
+
+
+
+	// In-place transpose of a PLF_TYPE_BITWIDTH x PLF_TYPE_BITWIDTH block, ie. block[row] bit column becomes block[column] bit row. Swaps the off-diagonal halves, then quarters and so on down to single bits (Warren, "Hacker's Delight", 7-3):
+	static PLF_CONSTFUNC void transpose_block(storage_type * const block) PLF_NOEXCEPT
+	{
+		storage_type mask = std::numeric_limits<storage_type>::max() >> (PLF_TYPE_BITWIDTH / 2);
+
+		for (size_type width = PLF_TYPE_BITWIDTH / 2; width != 0; width >>= 1, mask = static_cast<storage_type>(mask ^ (mask << width)))
+		{
+			for (size_type index = 0; index != PLF_TYPE_BITWIDTH; index = ((index | width) + 1) & ~width)
+			{
+				const storage_type swapped = static_cast<storage_type>(((block[index] >> width) ^ block[index | width]) & mask);
+				block[index] ^= static_cast<storage_type>(swapped << width);
+				block[index | width] ^= swapped;
+			}
+		}
+	}
+
+
+
+	#ifdef __AVX2__
+		// As above, but transposes four adjacent 64 x 64 blocks at once, one per 64-bit lane:
+		static void transpose_blocks(__m256i * const block) PLF_NOEXCEPT
+		{
+			unsigned long long mask = 0xFFFFFFFFULL;
+
+			for (int width = 32; width != 0; width >>= 1, mask ^= mask << width)
+			{
+				const __m256i mask_vector = _mm256_set1_epi64x(static_cast<long long>(mask));
+
+				for (int index = 0; index != 64; index = ((index | width) + 1) & ~width)
+				{
+					const __m256i swapped = _mm256_and_si256(_mm256_xor_si256(_mm256_srli_epi64(block[index], width), block[index | width]), mask_vector);
+					block[index] = _mm256_xor_si256(block[index], _mm256_slli_epi64(swapped, width));
+					block[index | width] = _mm256_xor_si256(block[index | width], swapped);
+				}
+			}
+		}
+	#endif
+
+
+
+public:
+
+	// If reset_supplied_buffer is false, a user-supplied buffer's existing contents are adopted as-is, as per plf::bitsetb. A supplied buffer must hold rows * ((columns + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH) storage_types:
+	PLF_CONSTFUNC bit_matrix(const size_type rows, const size_type columns, storage_type * const supplied_buffer = NULL, const bool reset_supplied_buffer = true):
+		buffer((user_supplied_buffer) ? supplied_buffer : PLF_ALLOCATE(allocator_type, *this, rows * PLF_WORDS_PER_ROW_CALC(columns), this)),
+		total_rows(rows),
+		total_columns(columns),
+		words_per_row(PLF_WORDS_PER_ROW_CALC(columns))
+	{
+		if (!user_supplied_buffer || reset_supplied_buffer)
+		{
+			reset();
+		}
+		else
+		{
+			set_overflow_to_zero();
+		}
+	}
+
+
+
+	PLF_CONSTFUNC bit_matrix(const bit_matrix &source, storage_type * const supplied_buffer = NULL):
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+			allocator_type(std::allocator_traits<allocator_type>::select_on_container_copy_construction(source)),
+		#else
+			allocator_type(source),
+		#endif
+		buffer((user_supplied_buffer) ? supplied_buffer : PLF_ALLOCATE(allocator_type, *this, source.total_rows * source.words_per_row, this)),
+		total_rows(source.total_rows),
+		total_columns(source.total_columns),
+		words_per_row(source.words_per_row)
+	{
+		std::uninitialized_copy(source.buffer, source.buffer + PLF_ARRAY_CAPACITY, buffer);
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		PLF_CONSTFUNC bit_matrix(bit_matrix &&source) PLF_NOEXCEPT:
+			buffer(source.buffer),
+			total_rows(source.total_rows),
+			total_columns(source.total_columns),
+			words_per_row(source.words_per_row)
+		{
+			source.buffer = NULL;
+			source.total_rows = source.total_columns = source.words_per_row = 0;
+		}
+	#endif
+
+
+
+	PLF_CONSTFUNC ~bit_matrix() PLF_NOEXCEPT
+	{
+		if PLF_CONSTEXPR (!user_supplied_buffer)
+		{
+			PLF_DEALLOCATE(allocator_type, *this, buffer, PLF_ARRAY_CAPACITY);
+		}
+	}
+
+
+
+	PLF_CONSTFUNC bool test(const size_type row, const size_type column) const
+	{
+		if PLF_CONSTEXPR (hardened) check_position_is_within_size(row, column);
+		return static_cast<bool>((buffer[(row * words_per_row) + (column / PLF_TYPE_BITWIDTH)] >> (column % PLF_TYPE_BITWIDTH)) & storage_type(1));
+	}
+
+
+
+	PLF_CONSTFUNC void set(const size_type row, const size_type column)
+	{
+		if PLF_CONSTEXPR (hardened) check_position_is_within_size(row, column);
+		buffer[(row * words_per_row) + (column / PLF_TYPE_BITWIDTH)] |= storage_type(1) << (column % PLF_TYPE_BITWIDTH);
+	}
+
+
+
+	PLF_CONSTFUNC void set(const size_type row, const size_type column, const bool value)
+	{
+		if PLF_CONSTEXPR (hardened) check_position_is_within_size(row, column);
+
+		const size_type word_index = (row * words_per_row) + (column / PLF_TYPE_BITWIDTH), shift = column % PLF_TYPE_BITWIDTH;
+		buffer[word_index] = (buffer[word_index] & ~(storage_type(1) << shift)) | (static_cast<storage_type>(value) << shift);
+	}
+
+
+
+	PLF_CONSTFUNC void reset(const size_type row, const size_type column)
+	{
+		if PLF_CONSTEXPR (hardened) check_position_is_within_size(row, column);
+		buffer[(row * words_per_row) + (column / PLF_TYPE_BITWIDTH)] &= ~(storage_type(1) << (column % PLF_TYPE_BITWIDTH));
+	}
+
+
+
+	PLF_CONSTFUNC void reset() PLF_NOEXCEPT
+	{
+		std::fill_n(buffer, PLF_ARRAY_CAPACITY, storage_type(0));
+	}
+
+
+
+	// A plf::bitsetb view over the row's storage - changes made through the view change the matrix:
+	PLF_CONSTFUNC row_type row(const size_type row_index)
+	{
+		if PLF_CONSTEXPR (hardened) check_position_is_within_size(row_index, 0);
+		return row_type(total_columns, buffer + (row_index * words_per_row), false);
+	}
+
+
+
+	PLF_CONSTFUNC storage_type * row_data(const size_type row_index) PLF_NOEXCEPT
+	{
+		return buffer + (row_index * words_per_row);
+	}
+
+
+
+	PLF_CONSTFUNC const storage_type * row_data(const size_type row_index) const PLF_NOEXCEPT
+	{
+		return buffer + (row_index * words_per_row);
+	}
+
+
+
+	PLF_CONSTFUNC size_type row_count(const size_type row_index) const
+	{
+		if PLF_CONSTEXPR (hardened) check_position_is_within_size(row_index, 0);
+
+		size_type total = 0;
+		for (const storage_type *current = row_data(row_index), * const end = current + words_per_row; current != end; ++current) total += plf::popcount(*current);
+		return total;
+	}
+
+
+
+	PLF_CONSTFUNC size_type column_count(const size_type column) const
+	{
+		if PLF_CONSTEXPR (hardened) check_position_is_within_size(0, column);
+
+		size_type total = 0;
+		const storage_type * current = buffer + (column / PLF_TYPE_BITWIDTH);
+
+		for (size_type row = 0; row != total_rows; ++row, current += words_per_row) total += static_cast<size_type>((*current >> (column % PLF_TYPE_BITWIDTH)) & storage_type(1));
+		return total;
+	}
+
+
+
+	PLF_CONSTFUNC size_type count() const PLF_NOEXCEPT
+	{
+		size_type total = 0;
+		for (size_type current = 0, end = PLF_ARRAY_CAPACITY; current != end; ++current) total += plf::popcount(buffer[current]);
+		return total;
+	}
+
+
+
+	// Writes the transpose of *this into destination, which must have the swapped dimensions. Works through the matrix one band of PLF_TYPE_BITWIDTH rows at a time, so that each source cache line is fully consumed while it is resident. With AVX2 and 64-bit storage, four 64 x 64 blocks are transposed at once:
+	template <class destination_type>
+	PLF_CONSTFUNC void transpose_into(destination_type &destination) const
+	{
+		if (destination.rows() != total_columns || destination.columns() != total_rows) throw_length_error("Destination dimensions are not the transpose of *this.");
+
+		for (size_type band = 0, number_of_bands = PLF_WORDS_PER_ROW_CALC(total_rows); band != number_of_bands; ++band)
+		{
+			const size_type first_row = band * PLF_TYPE_BITWIDTH, rows_in_band = std::min<size_type>(PLF_TYPE_BITWIDTH, total_rows - first_row);
+			size_type word_index = 0;
+
+			#ifdef __AVX2__
+				#ifdef PLF_CPP20_SUPPORT
+					if (!std::is_constant_evaluated())
+				#endif
+				{
+					if (sizeof(storage_type) == 8)
+					{
+						__m256i blocks[64];
+						unsigned long long lanes[4];
+
+						for (; word_index + 4 <= words_per_row; word_index += 4)
+						{
+							for (size_type index = 0; index != 64; ++index) blocks[index] = (index < rows_in_band) ? _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row_data(first_row + index) + word_index)) : _mm256_setzero_si256();
+
+							transpose_blocks(blocks);
+
+							for (size_type index = 0; index != 64; ++index)
+							{
+								_mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), blocks[index]);
+
+								for (size_type lane = 0; lane != 4; ++lane)
+								{
+									const size_type destination_row = ((word_index + lane) * 64) + index;
+									if (destination_row < total_columns) destination.row_data(destination_row)[band] = static_cast<storage_type>(lanes[lane]);
+								}
+							}
+						}
+					}
+				}
+			#endif
+
+			storage_type block[PLF_TYPE_BITWIDTH];
+
+			for (; word_index != words_per_row; ++word_index)
+			{
+				for (size_type index = 0; index != PLF_TYPE_BITWIDTH; ++index) block[index] = (index < rows_in_band) ? row_data(first_row + index)[word_index] : storage_type(0);
+
+				transpose_block(block);
+
+				const size_type first_destination_row = word_index * PLF_TYPE_BITWIDTH, destination_rows = std::min<size_type>(PLF_TYPE_BITWIDTH, total_columns - first_destination_row);
+				for (size_type index = 0; index != destination_rows; ++index) destination.row_data(first_destination_row + index)[band] = block[index];
+			}
+		}
+	}
+
+
+
+	PLF_CONSTFUNC result_type transpose() const
+	{
+		result_type result(total_columns, total_rows);
+		transpose_into(result);
+		return result;
+	}
+
+
+
+	// Boolean matrix product, ie. result(i, j) = OR over k of (*this)(i, k) AND source(k, j). Uses the Four Russians method: for each group of 8 source rows, all 256 ORs of those rows are tabulated, then each result row ORs in the table entry selected by the corresponding byte of its row in *this. Zero bytes are skipped, so sparse matrices are cheap:
+	template <class matrix_type>
+	PLF_CONSTFUNC result_type multiply(const matrix_type &source) const
+	{
+		if (total_columns != source.rows()) throw_length_error("Number of columns is not equal to source's number of rows, cannot multiply.");
+
+		const size_type result_columns = source.columns();
+		result_type result(total_rows, result_columns), table(256, result_columns);
+
+		for (size_type group_begin = 0; group_begin < source.rows(); group_begin += 8)
+		{
+			const size_type group_size = std::min<size_type>(8, source.rows() - group_begin), word_index = group_begin / PLF_TYPE_BITWIDTH, shift = group_begin % PLF_TYPE_BITWIDTH;
+
+			// Entry 0 is always empty, and entries [2^bit, 2^(bit + 1)) are entries [0, 2^bit) with source row group_begin + bit added:
+			for (size_type bit = 0; bit != group_size; ++bit)
+			{
+				const size_type half = size_type(1) << bit;
+				for (size_type entry = 0; entry != half; ++entry) plf::bitwise_words<plf::or_operation>(table.row_data(half + entry), table.row_data(entry), source.row_data(group_begin + bit), result_columns);
+			}
+
+			for (size_type row = 0; row != total_rows; ++row)
+			{
+				const size_type entry = static_cast<size_type>((row_data(row)[word_index] >> shift) & 0xFF); // Bits beyond total_columns are zero, so entry < 2^group_size
+				if (entry != 0) plf::bitwise_words<plf::or_operation>(result.row_data(row), result.row_data(row), table.row_data(entry), result_columns);
+			}
+		}
+
+		return result;
+	}
+
+
+
+	// Replaces a square adjacency matrix with its transitive closure, ie. (i, j) is set if j is reachable from i via one or more edges. Uses Warshall's algorithm, with each inner step being a whole-row OR:
+	PLF_CONSTFUNC void transitive_closure()
+	{
+		if (total_rows != total_columns) throw_length_error("Matrix is not square, cannot compute transitive closure.");
+
+		for (size_type via = 0; via != total_rows; ++via)
+		{
+			const storage_type * const via_row = row_data(via), via_bit = storage_type(1) << (via % PLF_TYPE_BITWIDTH);
+			const size_type via_word = via / PLF_TYPE_BITWIDTH;
+
+			for (size_type row = 0; row != total_rows; ++row)
+			{
+				if (row_data(row)[via_word] & via_bit) plf::bitwise_words<plf::or_operation>(row_data(row), row_data(row), via_row, total_columns);
+			}
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void operator = (const bit_matrix &source)
+	{
+		if (source.total_rows != total_rows || source.total_columns != total_columns) throw_length_error("Source dimensions are not equal to dimensions of *this.");
+		std::copy(source.buffer, source.buffer + PLF_ARRAY_CAPACITY, buffer);
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		PLF_CONSTFUNC void operator = (bit_matrix &&source) PLF_NOEXCEPT
+		{
+			assert(source.buffer != NULL);
+			assert(&source != this);
+
+			if PLF_CONSTEXPR (!user_supplied_buffer)
+			{
+				PLF_DEALLOCATE(allocator_type, *this, buffer, PLF_ARRAY_CAPACITY);
+			}
+
+			buffer = source.buffer;
+			total_rows = source.total_rows;
+			total_columns = source.total_columns;
+			words_per_row = source.words_per_row;
+			source.buffer = NULL;
+			source.total_rows = source.total_columns = source.words_per_row = 0;
+		}
+	#endif
+
+
+
+	template <class matrix_type>
+ 	PLF_CONSTFUNC bool operator == (const matrix_type &source) const PLF_NOEXCEPT
+	{
+ 		return source.rows() == total_rows && source.columns() == total_columns && std::equal(buffer, buffer + PLF_ARRAY_CAPACITY, source.data());
+	}
+
+
+
+	template <class matrix_type>
+ 	PLF_CONSTFUNC bool operator != (const matrix_type &source) const PLF_NOEXCEPT
+	{
+		return !(*this == source);
+	}
+
+
+
+	PLF_CONSTFUNC size_type rows() const PLF_NOEXCEPT
+ 	{
+ 		return total_rows;
+ 	}
+
+
+
+	PLF_CONSTFUNC size_type columns() const PLF_NOEXCEPT
+ 	{
+ 		return total_columns;
+ 	}
+
+
+
+	PLF_CONSTFUNC storage_type * data() PLF_NOEXCEPT
+	{
+		return buffer;
+	}
+
+
+
+	PLF_CONSTFUNC const storage_type * data() const PLF_NOEXCEPT
+	{
+		return buffer;
+	}
+};
+
+
+} // plf namespace
+
+
+#undef PLF_MOVE_SEMANTICS_SUPPORT
+#undef PLF_ALLOCATOR_TRAITS_SUPPORT
+#undef PLF_CPP20_SUPPORT
+#undef PLF_CONSTFUNC
+#undef PLF_CONSTEXPR
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+
+#undef PLF_ALLOCATE
+#undef PLF_DEALLOCATE
+
+#undef PLF_TYPE_BITWIDTH
+#undef PLF_WORDS_PER_ROW_CALC
+#undef PLF_ARRAY_CAPACITY
+
+#endif // PLF_BIT_MATRIX_H
@@ -0,0 +1,258 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "plf_bit_matrix.h"
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+template <class matrix_type>
+void fill_randomly(matrix_type &matrix, const int one_in)
+{
+	for (std::size_t row = 0; row != matrix.rows(); ++row)
+	{
+		for (std::size_t column = 0; column != matrix.columns(); ++column)
+		{
+			if (rand() % one_in == 0) matrix.set(row, column);
+		}
+	}
+}
+
+
+
+template <typename storage_type>
+bool transpose_test(const std::size_t rows, const std::size_t columns)
+{
+	plf::bit_matrix<false, storage_type> matrix(rows, columns);
+	fill_randomly(matrix, 3);
+
+	const plf::bit_matrix<false, storage_type> transposed = matrix.transpose();
+	if (transposed.rows() != columns || transposed.columns() != rows) return false;
+
+	for (std::size_t row = 0; row != rows; ++row)
+	{
+		for (std::size_t column = 0; column != columns; ++column)
+		{
+			if (matrix.test(row, column) != transposed.test(column, row)) return false;
+		}
+	}
+
+	// Padding bits must remain zero, so that whole-row counts are exact:
+	for (std::size_t row = 0; row != columns; ++row)
+	{
+		if (transposed.row_count(row) != matrix.column_count(row)) return false;
+	}
+
+	return transposed.count() == matrix.count() && transposed.transpose() == matrix;
+}
+
+
+
+template <typename storage_type>
+bool multiply_test(const std::size_t rows, const std::size_t inner, const std::size_t columns, const int one_in)
+{
+	plf::bit_matrix<false, storage_type> a(rows, inner), b(inner, columns);
+	fill_randomly(a, one_in);
+	fill_randomly(b, one_in);
+
+	const plf::bit_matrix<false, storage_type> product = a.multiply(b);
+	if (product.rows() != rows || product.columns() != columns) return false;
+
+	for (std::size_t row = 0; row != rows; ++row)
+	{
+		for (std::size_t column = 0; column != columns; ++column)
+		{
+			bool expected = false;
+			for (std::size_t k = 0; k != inner && !expected; ++k) expected = a.test(row, k) && b.test(k, column);
+			if (product.test(row, column) != expected) return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+
+
+int main()
+{
+	srand(5);
+
+	{
+		message("Basic tests\n==================================\n\n");
+
+		plf::bit_matrix<> matrix(100, 70);
+		failpass("Empty test", matrix.count() == 0 && matrix.rows() == 100 && matrix.columns() == 70);
+
+		matrix.set(3, 69);
+		matrix.set(4, 0, true);
+		matrix.set(99, 5);
+		failpass("Set test", matrix.test(3, 69) && matrix.test(4, 0) && matrix.test(99, 5) && !matrix.test(3, 68) && matrix.count() == 3);
+
+		plf::bit_matrix<>::row_type row = matrix.row(10);
+		row.set_range(20, 70);
+		failpass("Row view test", matrix.row_count(10) == 50 && matrix.test(10, 20) && !matrix.test(10, 19) && matrix.column_count(20) == 1 && matrix.column_count(5) == 1);
+
+		matrix.reset(10, 20);
+		failpass("Row view aliasing test", !row.test(20) && row.count() == 49);
+
+		plf::bit_matrix<> copy(matrix);
+		failpass("Copy test", copy == matrix);
+		copy.reset();
+		failpass("Reset test", copy.count() == 0 && copy != matrix);
+	}
+
+
+	{
+		message("Transpose tests\n==================================\n\n");
+
+		failpass("Single block transpose test", transpose_test<unsigned long long>(64, 64) && transpose_test<unsigned int>(32, 32) && transpose_test<unsigned char>(8, 8));
+		failpass("Partial block transpose test", transpose_test<unsigned long long>(5, 3) && transpose_test<unsigned long long>(1, 130) && transpose_test<unsigned long long>(130, 1));
+		failpass("Multi-block transpose test", transpose_test<unsigned long long>(300, 1000) && transpose_test<unsigned long long>(1000, 300) && transpose_test<unsigned long long>(257, 513));
+		failpass("Other storage type transpose test", transpose_test<unsigned int>(100, 77) && transpose_test<unsigned char>(41, 90) && transpose_test<unsigned short>(200, 33));
+
+		plf::bit_matrix<> tall(10, 20);
+		bool length_error_thrown = false;
+
+		try
+		{
+			tall.transpose_into(tall);
+		}
+		catch (std::length_error &)
+		{
+			length_error_thrown = true;
+		}
+
+		failpass("Transpose dimensions test", length_error_thrown);
+	}
+
+
+	{
+		message("Multiply tests\n==================================\n\n");
+
+		failpass("Dense multiply test", multiply_test<unsigned long long>(70, 90, 130, 4) && multiply_test<unsigned int>(33, 65, 17, 3));
+		failpass("Sparse multiply test", multiply_test<unsigned long long>(200, 300, 100, 60) && multiply_test<unsigned char>(20, 7, 30, 10));
+
+		plf::bit_matrix<> identity(100, 100), other(100, 100);
+		for (std::size_t index = 0; index != 100; ++index) identity.set(index, index);
+		fill_randomly(other, 5);
+		failpass("Identity multiply test", identity.multiply(other) == other && other.multiply(identity) == other);
+
+		bool length_error_thrown = false;
+
+		try
+		{
+			identity.multiply(plf::bit_matrix<>(99, 100));
+		}
+		catch (std::length_error &)
+		{
+			length_error_thrown = true;
+		}
+
+		failpass("Multiply dimensions test", length_error_thrown);
+	}
+
+
+	{
+		message("Transitive closure tests\n==================================\n\n");
+
+		// A chain 0 -> 1 -> ... -> 199, plus a separate cycle 200 -> 201 -> 202 -> 200:
+		plf::bit_matrix<> graph(203, 203);
+		for (std::size_t node = 0; node != 199; ++node) graph.set(node, node + 1);
+		graph.set(200, 201);
+		graph.set(201, 202);
+		graph.set(202, 200);
+
+		graph.transitive_closure();
+
+		bool chain_passed = true;
+		for (std::size_t node = 0; node != 200; ++node) chain_passed = chain_passed && graph.row_count(node) == 199 - node && (node == 199 || graph.test(node, 199)) && !graph.test(node, node);
+		failpass("Chain closure test", chain_passed);
+		failpass("Cycle closure test", graph.row_count(200) == 3 && graph.test(200, 200) && graph.test(202, 201) && !graph.test(200, 0));
+
+		// Random graph checked against a depth-first search from every node:
+		plf::bit_matrix<> random_graph(150, 150);
+		fill_randomly(random_graph, 120);
+		plf::bit_matrix<> closure(random_graph);
+		closure.transitive_closure();
+
+		bool random_passed = true;
+
+		for (std::size_t start = 0; start != 150; ++start)
+		{
+			std::vector<bool> reached(150, false);
+			std::vector<std::size_t> stack(1, start);
+
+			while (!stack.empty())
+			{
+				const std::size_t node = stack.back();
+				stack.pop_back();
+
+				for (std::size_t next = 0; next != 150; ++next)
+				{
+					if (random_graph.test(node, next) && !reached[next])
+					{
+						reached[next] = true;
+						stack.push_back(next);
+					}
+				}
+			}
+
+			for (std::size_t node = 0; node != 150; ++node) random_passed = random_passed && closure.test(start, node) == reached[node];
+		}
+
+		failpass("Random closure test", random_passed);
+	}
+
+
+	{
+		message("User-supplied buffer tests\n==================================\n\n");
+
+		std::vector<unsigned long long> buffer(40 * 2, ~0ULL);
+		{
+			plf::bit_matrix<true> matrix(40, 100, &buffer[0]);
+			failpass("Reset supplied buffer test", matrix.count() == 0);
+			matrix.set(39, 99);
+			matrix.set(0, 0);
+		}
+
+		plf::bit_matrix<true> reopened(40, 100, &buffer[0], false);
+		failpass("Adopt supplied buffer test", reopened.test(39, 99) && reopened.test(0, 0) && reopened.count() == 2);
+
+		plf::bit_matrix<> transposed(100, 40);
+		reopened.transpose_into(transposed);
+		failpass("Mixed buffer transpose test", transposed.test(99, 39) && transposed.test(0, 0) && transposed.count() == 2);
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
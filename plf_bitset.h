@@ -57,88 +57,904 @@
 
 	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 202302L) && _MSC_VER >= 1944
 		#define PLF_CONSTEVAL_SUPPORT
+		#define PLF_IF_CONSTEVAL if consteval
+	#elif defined(PLF_CPP20_SUPPORT)
+		#define PLF_CONSTEVAL_SUPPORT
+		#define PLF_IF_CONSTEVAL if (std::is_constant_evaluated())
+	#endif
+
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+			#define PLF_CPP11_SUPPORT
+		#endif
+	#elif defined(__clang__)
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+			#define PLF_CPP11_SUPPORT
+		#endif
+	#else // Assume support for other compilers
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+		#define PLF_CPP11_SUPPORT
+	#endif
+
+	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
 	#endif
 
-#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
-	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
-		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
-			#undef PLF_NOEXCEPT
-			#define PLF_NOEXCEPT noexcept
-			#define PLF_CPP11_SUPPORT
-		#endif
-	#elif defined(__clang__)
-		#if __has_feature(cxx_noexcept)
-			#undef PLF_NOEXCEPT
-			#define PLF_NOEXCEPT noexcept
-			#define PLF_CPP11_SUPPORT
-		#endif
-	#else // Assume support for other compilers
-		#undef PLF_NOEXCEPT
-		#define PLF_NOEXCEPT noexcept
-		#define PLF_CPP11_SUPPORT
-	#endif
+	// The following line is a little different from other plf:: containers because we need constexpr basic_string in order to make the to_string function constexpr:
+	#if __cplusplus >= 202001L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) &&	_GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+		#define PLF_CPP20_SUPPORT
+	#endif
+
+	#if __cplusplus >= 202302L && ((defined(__clang__) && __clang_major__ >= 14) || (defined(__GNUC__) && (__GNUC__ >= 12)))
+		#define PLF_CONSTEVAL_SUPPORT
+		#define PLF_IF_CONSTEVAL if consteval
+	#elif defined(PLF_CPP20_SUPPORT) // std::is_constant_evaluated is sufficient to select the constexpr-friendly branches
+		#define PLF_CONSTEVAL_SUPPORT
+		#define PLF_IF_CONSTEVAL if (std::is_constant_evaluated())
+	#endif
+#endif
+
+
+#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
+#define PLF_ARRAY_CAPACITY ((total_size + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH) // ie. round up to nearest unit of storage
+#define PLF_ARRAY_CAPACITY_BITS (PLF_ARRAY_CAPACITY * PLF_TYPE_BITWIDTH)
+#define PLF_ARRAY_CAPACITY_BYTES (PLF_ARRAY_CAPACITY * sizeof(storage_type))
+
+
+#include <cassert>
+#include <string>	// std::basic_string
+#include <stdexcept> // std::out_of_range
+#include <limits>  // std::numeric_limits
+#include <ostream>
+#include <cstring>	// memset, size_t
+#include <memory> // std::allocator, for as_view()
+#include <algorithm> // std::copy, std::equal
+#include <functional> // std::hash
+#include <utility> // std::pair
+
+#if defined(__AVX2__)
+	#include <immintrin.h> // copy_bits/move_bits funnel shifts
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+#endif
+
+#ifdef PLF_CPP20_SUPPORT
+	#include <bit>  // std::pop_count, std::countr_one, std::countr_zero
+	#include <compare> // std::strong_ordering
+	#include <type_traits> // std::is_constant_evaluated
+#endif
+
+
+
+namespace plf
+{
+
+
+#ifndef PLF_BITSET_TOOLS
+	#define PLF_BITSET_TOOLS
+
+	template <typename storage_type>
+	static PLF_CONSTFUNC storage_type popcount(storage_type value)
+	{
+		#ifdef PLF_CPP20_SUPPORT
+			return std::popcount(value); // leverage CPU intrinsics for faster performance
+		#else
+			storage_type total = 0;
+			for (; value; ++total) value &= value - 1; // Kernighan's algorithm
+			return total;
+		#endif
+	}
+
+
+	// 64 x 64 -> 128-bit multiply with the high and low halves folded together, as per wyhash:
+	inline PLF_CONSTFUNC unsigned long long hash_mix(const unsigned long long a, const unsigned long long b)
+	{
+		#ifdef __SIZEOF_INT128__
+			__extension__ const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+			return static_cast<unsigned long long>(product) ^ static_cast<unsigned long long>(product >> 64);
+		#else
+			const unsigned long long a_low = a & 0xFFFFFFFFULL, a_high = a >> 32, b_low = b & 0xFFFFFFFFULL, b_high = b >> 32;
+			const unsigned long long low_low = a_low * b_low, low_high = a_low * b_high, high_low = a_high * b_low, high_high = a_high * b_high;
+			const unsigned long long middle = (low_low >> 32) + (low_high & 0xFFFFFFFFULL) + (high_low & 0xFFFFFFFFULL);
+			return ((middle << 32) | (low_low & 0xFFFFFFFFULL)) ^ (high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32));
+		#endif
+	}
+
+
+
+	// Packs as many storage_type words as fit into 64 bits, starting at word_index. The final word of the buffer has last_word_mask applied so that unused bits never contribute:
+	template <typename storage_type>
+	static PLF_CONSTFUNC unsigned long long hash_load(const storage_type * const words, std::size_t word_index, const std::size_t number_of_words, const storage_type last_word_mask)
+	{
+		unsigned long long value = 0;
+
+		for (std::size_t shift = 0; shift != sizeof(unsigned long long) * 8 && word_index != number_of_words; shift += sizeof(storage_type) * 8, ++word_index)
+		{
+			value |= static_cast<unsigned long long>((word_index == number_of_words - 1) ? static_cast<storage_type>(words[word_index] & last_word_mask) : words[word_index]) << shift;
+		}
+
+		return value;
+	}
+
+
+
+	// wyhash-style hash of a word buffer. Three independent multiply chains are run over the bulk of the buffer so that the multiplies can overlap in the CPU pipeline. storage_type must be no larger than 64 bits:
+	template <typename storage_type>
+	static PLF_CONSTFUNC unsigned long long hash_words(const storage_type * const words, const std::size_t number_of_words, const storage_type last_word_mask, const unsigned long long seed)
+	{
+		const unsigned long long secret0 = 0xa0761d6478bd642fULL, secret1 = 0xe7037ed1a0b428dbULL, secret2 = 0x8ebc6af09c88c6e3ULL, secret3 = 0x589965cc75374cc3ULL;
+		const std::size_t words_per_lane = sizeof(unsigned long long) / sizeof(storage_type), number_of_lanes = (number_of_words + words_per_lane - 1) / words_per_lane;
+		unsigned long long chain0 = seed ^ hash_mix(seed ^ secret0, secret1), chain1 = chain0, chain2 = chain0;
+		std::size_t lane = 0;
+
+		if (words_per_lane == 1) // Fast path - no packing required. The final lane is always left for the tail code below, which applies the mask
+		{
+			for (; lane + 6 < number_of_lanes; lane += 6)
+			{
+				chain0 = hash_mix(static_cast<unsigned long long>(words[lane]) ^ secret1, static_cast<unsigned long long>(words[lane + 1]) ^ chain0);
+				chain1 = hash_mix(static_cast<unsigned long long>(words[lane + 2]) ^ secret2, static_cast<unsigned long long>(words[lane + 3]) ^ chain1);
+				chain2 = hash_mix(static_cast<unsigned long long>(words[lane + 4]) ^ secret3, static_cast<unsigned long long>(words[lane + 5]) ^ chain2);
+			}
+		}
+		else
+		{
+			for (; lane + 6 < number_of_lanes; lane += 6)
+			{
+				chain0 = hash_mix(hash_load(words, lane * words_per_lane, number_of_words, last_word_mask) ^ secret1, hash_load(words, (lane + 1) * words_per_lane, number_of_words, last_word_mask) ^ chain0);
+				chain1 = hash_mix(hash_load(words, (lane + 2) * words_per_lane, number_of_words, last_word_mask) ^ secret2, hash_load(words, (lane + 3) * words_per_lane, number_of_words, last_word_mask) ^ chain1);
+				chain2 = hash_mix(hash_load(words, (lane + 4) * words_per_lane, number_of_words, last_word_mask) ^ secret3, hash_load(words, (lane + 5) * words_per_lane, number_of_words, last_word_mask) ^ chain2);
+			}
+		}
+
+		chain0 ^= chain1 ^ chain2;
+
+		for (; lane + 2 < number_of_lanes; lane += 2)
+		{
+			chain0 = hash_mix(hash_load(words, lane * words_per_lane, number_of_words, last_word_mask) ^ secret1, hash_load(words, (lane + 1) * words_per_lane, number_of_words, last_word_mask) ^ chain0);
+		}
+
+		const unsigned long long first = (lane != number_of_lanes) ? hash_load(words, lane * words_per_lane, number_of_words, last_word_mask) : 0, second = (lane + 1 < number_of_lanes) ? hash_load(words, (lane + 1) * words_per_lane, number_of_words, last_word_mask) : 0;
+		return hash_mix(secret1 ^ static_cast<unsigned long long>(number_of_lanes), hash_mix(first ^ secret1, second ^ chain0));
+	}
+
+
+	// Compares two equal-length word buffers as unsigned integers, from the most-significant word downward, returning -1, 0 or 1. Blocks of four words are checked for any difference without branching (which the compiler can vectorise) before the first differing word is located:
+	template <typename storage_type>
+	static PLF_CONSTFUNC int compare_words(const storage_type * const a, const storage_type * const b, std::size_t current)
+	{
+		for (; current >= 4; current -= 4)
+		{
+			if (((a[current - 1] ^ b[current - 1]) | (a[current - 2] ^ b[current - 2]) | (a[current - 3] ^ b[current - 3]) | (a[current - 4] ^ b[current - 4])) != 0) break;
+		}
+
+		while (current != 0)
+		{
+			--current;
+			if (a[current] != b[current]) return (a[current] < b[current]) ? -1 : 1;
+		}
+
+		return 0;
+	}
+
+
+	// Returns true if any bit is set in ((a ^ a_invert) & (b ^ b_invert)) over number_of_words. Blocks of four words are combined without branching (which the compiler can vectorise) before the early-exit check:
+	template <typename storage_type>
+	static PLF_CONSTFUNC bool any_intersection(const storage_type * const a, const storage_type * const b, const std::size_t number_of_words, const storage_type a_invert, const storage_type b_invert)
+	{
+		std::size_t current = 0;
+
+		for (; current + 4 <= number_of_words; current += 4)
+		{
+			if ((((a[current] ^ a_invert) & (b[current] ^ b_invert)) | ((a[current + 1] ^ a_invert) & (b[current + 1] ^ b_invert)) | ((a[current + 2] ^ a_invert) & (b[current + 2] ^ b_invert)) | ((a[current + 3] ^ a_invert) & (b[current + 3] ^ b_invert))) != 0) return true;
+		}
+
+		for (; current != number_of_words; ++current)
+		{
+			if (((a[current] ^ a_invert) & (b[current] ^ b_invert)) != 0) return true;
+		}
+
+		return false;
+	}
+
+
+	inline PLF_CONSTFUNC void check_operand_sizes(const std::size_t destination_size, const std::size_t a_size, const std::size_t b_size)
+	{
+		if (destination_size != a_size || destination_size != b_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Operand sizes are not equal.");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+	// Word operations ie. result = operation_type::apply(a, b), passed as template parameters to plf::bitwise_words and the other word-at-a-time algorithms:
+	struct and_operation
+	{
+		template <typename storage_type>
+		static PLF_CONSTFUNC storage_type apply(const storage_type a, const storage_type b) { return static_cast<storage_type>(a & b); }
+	};
+
+
+	struct or_operation
+	{
+		template <typename storage_type>
+		static PLF_CONSTFUNC storage_type apply(const storage_type a, const storage_type b) { return static_cast<storage_type>(a | b); }
+	};
+
+
+	struct xor_operation
+	{
+		template <typename storage_type>
+		static PLF_CONSTFUNC storage_type apply(const storage_type a, const storage_type b) { return static_cast<storage_type>(a ^ b); }
+	};
+
+
+	struct andnot_operation
+	{
+		template <typename storage_type>
+		static PLF_CONSTFUNC storage_type apply(const storage_type a, const storage_type b) { return static_cast<storage_type>(a & ~b); }
+	};
+
+
+	struct ornot_operation
+	{
+		template <typename storage_type>
+		static PLF_CONSTFUNC storage_type apply(const storage_type a, const storage_type b) { return static_cast<storage_type>(a | ~b); }
+	};
+
+
+	struct assign_operation
+	{
+		template <typename storage_type>
+		static PLF_CONSTFUNC storage_type apply(const storage_type, const storage_type b) { return b; }
+	};
+
+
+
+	// destination = operation_type::apply(a, b) for each word. Both operand words are read before each destination word is written, so the destination may be the same buffer as either operand:
+	template <class operation_type, typename storage_type>
+	static PLF_CONSTFUNC void bitwise_words(storage_type * const destination, const storage_type * const a, const storage_type * const b, const std::size_t total_size)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8, number_of_words = (total_size + bitwidth - 1) / bitwidth;
+
+		for (std::size_t current = 0; current != number_of_words; ++current) destination[current] = operation_type::apply(a[current], b[current]);
+
+		if (operation_type::apply(storage_type(0), storage_type(0)) != 0 && total_size % bitwidth != 0) // Clear the overflow bits set by an operation which inverts b
+		{
+			destination[number_of_words - 1] &= static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> ((number_of_words * bitwidth) - total_size));
+		}
+	}
+
+
+	// Non-allocating three-operand bitwise operations ie. destination = a OP b. The destination may be the same object as either operand, and plf::bitset and plf::bitsetb may be mixed freely provided sizes and storage_types match:
+	template <class destination_type, class a_type, class b_type>
+	PLF_CONSTFUNC void bitwise_and(destination_type &destination, const a_type &a, const b_type &b)
+	{
+		plf::check_operand_sizes(destination.size(), a.size(), b.size());
+		plf::bitwise_words<plf::and_operation>(destination.data(), a.data(), b.data(), destination.size());
+	}
+
+
+	template <class destination_type, class a_type, class b_type>
+	PLF_CONSTFUNC void bitwise_or(destination_type &destination, const a_type &a, const b_type &b)
+	{
+		plf::check_operand_sizes(destination.size(), a.size(), b.size());
+		plf::bitwise_words<plf::or_operation>(destination.data(), a.data(), b.data(), destination.size());
+	}
+
+
+	template <class destination_type, class a_type, class b_type>
+	PLF_CONSTFUNC void bitwise_xor(destination_type &destination, const a_type &a, const b_type &b)
+	{
+		plf::check_operand_sizes(destination.size(), a.size(), b.size());
+		plf::bitwise_words<plf::xor_operation>(destination.data(), a.data(), b.data(), destination.size());
+	}
+
+
+	// destination = a & ~b:
+	template <class destination_type, class a_type, class b_type>
+	PLF_CONSTFUNC void bitwise_andnot(destination_type &destination, const a_type &a, const b_type &b)
+	{
+		plf::check_operand_sizes(destination.size(), a.size(), b.size());
+		plf::bitwise_words<plf::andnot_operation>(destination.data(), a.data(), b.data(), destination.size());
+	}
+
+
+	// destination = a | ~b:
+	template <class destination_type, class a_type, class b_type>
+	PLF_CONSTFUNC void bitwise_ornot(destination_type &destination, const a_type &a, const b_type &b)
+	{
+		plf::check_operand_sizes(destination.size(), a.size(), b.size());
+		plf::bitwise_words<plf::ornot_operation>(destination.data(), a.data(), b.data(), destination.size());
+	}
+
+
+	inline PLF_CONSTFUNC void check_bit_range(const std::size_t total_size, const std::size_t position, const std::size_t length)
+	{
+		if (position > total_size || length > total_size - position)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::out_of_range("Bit range is not within bitset.");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+	// The length (<= bitwidth) bits of words starting at bit position, returned in the low bits:
+	template <typename storage_type>
+	static PLF_CONSTFUNC storage_type read_bits_words(const storage_type * const words, const std::size_t position, const std::size_t length)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8, index = position / bitwidth, shift = position % bitwidth;
+		storage_type value = static_cast<storage_type>(words[index] >> shift);
+		if (shift + length > bitwidth) value |= static_cast<storage_type>(words[index + 1] << (bitwidth - shift));
+		return (length == bitwidth) ? value : static_cast<storage_type>(value & static_cast<storage_type>((storage_type(1) << length) - 1));
+	}
+
+
+	// Overwrites length bits of word starting at shift with the low bits of value, where shift + length <= bitwidth:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void write_bits_word(storage_type &word, const std::size_t shift, const std::size_t length, const storage_type value)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8;
+		const storage_type mask = static_cast<storage_type>(static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> (bitwidth - length)) << shift);
+		word = static_cast<storage_type>((word & ~mask) | (static_cast<storage_type>(value << shift) & mask));
+	}
+
+
+	// out[current] = the bitwidth bits of in starting at bit shift (> 0) of in[current], for current in [0, number_of_words). Each block of source words is read before the corresponding destination words are written, so out may overlap in provided out <= in:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void funnel_shift_words_forwards(storage_type * const out, const storage_type * const in, const std::size_t number_of_words, const std::size_t shift)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8;
+		std::size_t current = 0;
+
+		#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+			#ifdef PLF_CPP20_SUPPORT
+				if (!std::is_constant_evaluated())
+			#endif
+			if (sizeof(storage_type) == 8)
+			{
+				const __m128i right = _mm_cvtsi32_si128(static_cast<int>(shift)), left = _mm_cvtsi32_si128(static_cast<int>(64 - shift));
+
+				#ifdef __AVX2__
+					for (; current + 4 <= number_of_words; current += 4)
+					{
+						const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + current)), high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + current + 1));
+						_mm256_storeu_si256(reinterpret_cast<__m256i *>(out + current), _mm256_or_si256(_mm256_srl_epi64(low, right), _mm256_sll_epi64(high, left)));
+					}
+				#else
+					for (; current + 2 <= number_of_words; current += 2)
+					{
+						const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + current)), high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + current + 1));
+						_mm_storeu_si128(reinterpret_cast<__m128i *>(out + current), _mm_or_si128(_mm_srl_epi64(low, right), _mm_sll_epi64(high, left)));
+					}
+				#endif
+			}
+		#endif
+
+		for (; current != number_of_words; ++current) out[current] = static_cast<storage_type>((in[current] >> shift) | static_cast<storage_type>(in[current + 1] << (bitwidth - shift)));
+	}
+
+
+	// As above for *(out - current) and *(in - current), current in [1, number_of_words], highest words first, so out may overlap in provided out >= in:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void funnel_shift_words_backwards(storage_type * const out, const storage_type * const in, const std::size_t number_of_words, const std::size_t shift)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8;
+		std::size_t current = 1;
+
+		#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+			#ifdef PLF_CPP20_SUPPORT
+				if (!std::is_constant_evaluated())
+			#endif
+			if (sizeof(storage_type) == 8)
+			{
+				const __m128i right = _mm_cvtsi32_si128(static_cast<int>(shift)), left = _mm_cvtsi32_si128(static_cast<int>(64 - shift));
+
+				#ifdef __AVX2__
+					for (; current + 3 <= number_of_words; current += 4)
+					{
+						const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in - current - 3)), high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in - current - 2));
+						_mm256_storeu_si256(reinterpret_cast<__m256i *>(out - current - 3), _mm256_or_si256(_mm256_srl_epi64(low, right), _mm256_sll_epi64(high, left)));
+					}
+				#else
+					for (; current + 1 <= number_of_words; current += 2)
+					{
+						const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in - current - 1)), high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in - current));
+						_mm_storeu_si128(reinterpret_cast<__m128i *>(out - current - 1), _mm_or_si128(_mm_srl_epi64(low, right), _mm_sll_epi64(high, left)));
+					}
+				#endif
+			}
+		#endif
+
+		for (; current <= number_of_words; ++current) *(out - current) = static_cast<storage_type>((*(in - current) >> shift) | static_cast<storage_type>(*(in - current + 1) << (bitwidth - shift)));
+	}
+
+
+	// Copies source bits [source_position, source_position + length) to destination bits [destination_position, destination_position + length), lowest bits first. The destination is written a whole word at a time once aligned, each word being funnel-shifted from two adjacent source words. Safe for overlapping ranges only if the destination range starts at or before the source range:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void copy_bits_words_forwards(storage_type * const destination, std::size_t destination_position, const storage_type * const source, std::size_t source_position, std::size_t length)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8, head_shift = destination_position % bitwidth;
+
+		if (head_shift != 0 && length != 0)
+		{
+			const std::size_t head_length = (length < bitwidth - head_shift) ? length : bitwidth - head_shift;
+			plf::write_bits_word(destination[destination_position / bitwidth], head_shift, head_length, plf::read_bits_words(source, source_position, head_length));
+			destination_position += head_length;
+			source_position += head_length;
+			length -= head_length;
+		}
+
+		storage_type * const out = destination + (destination_position / bitwidth);
+		const storage_type * const in = source + (source_position / bitwidth);
+		const std::size_t shift = source_position % bitwidth, number_of_words = length / bitwidth;
+
+		if (shift == 0)
+		{
+			std::copy(in, in + number_of_words, out);
+		}
+		else
+		{
+			plf::funnel_shift_words_forwards(out, in, number_of_words, shift);
+		}
+
+		if (length % bitwidth != 0) plf::write_bits_word(out[number_of_words], 0, length % bitwidth, plf::read_bits_words(source, source_position + (number_of_words * bitwidth), length % bitwidth));
+	}
+
+
+	// As above but highest bits first, for overlapping ranges where the destination range starts after the source range:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void copy_bits_words_backwards(storage_type * const destination, const std::size_t destination_position, const storage_type * const source, const std::size_t source_position, std::size_t length)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8;
+		std::size_t destination_end = destination_position + length, source_end = source_position + length;
+
+		if (destination_end % bitwidth != 0 && length != 0)
+		{
+			const std::size_t tail_shift = destination_end % bitwidth, tail_length = (length < tail_shift) ? length : tail_shift;
+			plf::write_bits_word(destination[(destination_end - 1) / bitwidth], tail_shift - tail_length, tail_length, plf::read_bits_words(source, source_end - tail_length, tail_length));
+			destination_end -= tail_length;
+			source_end -= tail_length;
+			length -= tail_length;
+		}
+
+		storage_type * const out = destination + (destination_end / bitwidth);
+		const std::size_t shift = source_end % bitwidth, number_of_words = length / bitwidth;
+		const storage_type * const in = source + (source_end / bitwidth);
+
+		if (shift == 0)
+		{
+			std::copy_backward(in - number_of_words, in, out);
+		}
+		else
+		{
+			plf::funnel_shift_words_backwards(out, in, number_of_words, shift);
+		}
+
+		if (length % bitwidth != 0) plf::write_bits_word(destination[destination_position / bitwidth], destination_position % bitwidth, length % bitwidth, plf::read_bits_words(source, source_position, length % bitwidth));
+	}
+
+
+	// Copies length bits from source, starting at source_position, to destination, starting at destination_position. Any combination of plf::bitset and plf::bitsetb (or views of either) may be used provided storage_types match. If the ranges overlap in memory the result is unspecified - use move_bits:
+	template <class destination_type, class source_type>
+	PLF_CONSTFUNC void copy_bits(destination_type &destination, const std::size_t destination_position, const source_type &source, const std::size_t source_position, const std::size_t length)
+	{
+		plf::check_bit_range(destination.size(), destination_position, length);
+		plf::check_bit_range(source.size(), source_position, length);
+		plf::copy_bits_words_forwards(destination.data(), destination_position, source.data(), source_position, length);
+	}
+
+
+	// As per copy_bits, but the ranges may overlap, eg. when shifting part of a bitset within itself:
+	template <class destination_type, class source_type>
+	PLF_CONSTFUNC void move_bits(destination_type &destination, const std::size_t destination_position, const source_type &source, const std::size_t source_position, const std::size_t length)
+	{
+		plf::check_bit_range(destination.size(), destination_position, length);
+		plf::check_bit_range(source.size(), source_position, length);
+
+		// Only copy highest bits first if the destination range starts within the source range:
+		const std::size_t bitwidth = sizeof(*source.data()) * 8;
+		const void * const source_start = source.data() + (source_position / bitwidth), * const source_end = source.data() + ((source_position + length + bitwidth - 1) / bitwidth), * const destination_start = destination.data() + (destination_position / bitwidth);
+
+		if ((std::less<const void *>()(source_start, destination_start) && std::less<const void *>()(destination_start, source_end)) || (source_start == destination_start && source_position % bitwidth < destination_position % bitwidth))
+		{
+			plf::copy_bits_words_backwards(destination.data(), destination_position, source.data(), source_position, length);
+		}
+		else
+		{
+			plf::copy_bits_words_forwards(destination.data(), destination_position, source.data(), source_position, length);
+		}
+	}
+
+
+	template <typename storage_type>
+	static PLF_CONSTFUNC storage_type reverse_bytes(storage_type value)
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+			if (sizeof(storage_type) == 8) return static_cast<storage_type>(__builtin_bswap64(static_cast<unsigned long long>(value)));
+			if (sizeof(storage_type) == 4) return static_cast<storage_type>(__builtin_bswap32(static_cast<unsigned int>(value)));
+			if (sizeof(storage_type) == 2) return static_cast<storage_type>(__builtin_bswap16(static_cast<unsigned short>(value)));
+		#endif
+
+		storage_type mask = std::numeric_limits<storage_type>::max();
+
+		for (std::size_t shift = sizeof(storage_type) * 4; shift >= 8; shift /= 2) // Swap halves, then quarters and so on down to adjacent bytes
+		{
+			mask ^= static_cast<storage_type>(mask << shift); // ie. 0x00000000FFFFFFFF, 0x0000FFFF0000FFFF, 0x00FF00FF00FF00FF
+			value = static_cast<storage_type>(((value >> shift) & mask) | static_cast<storage_type>((value & mask) << shift));
+		}
+
+		return value;
+	}
+
+
+	// Reverses the order of the bits in value, via a per-byte bit reversal (swaps of adjacent bits, bit pairs and nibbles) followed by a byte-order reversal:
+	template <typename storage_type>
+	static PLF_CONSTFUNC storage_type reverse_bits(storage_type value)
+	{
+		const storage_type bits = static_cast<storage_type>(std::numeric_limits<storage_type>::max() / 3), pairs = static_cast<storage_type>(std::numeric_limits<storage_type>::max() / 5), nibbles = static_cast<storage_type>(std::numeric_limits<storage_type>::max() / 17); // ie. 0x55.., 0x33.., 0x0F..
+		value = static_cast<storage_type>(((value >> 1) & bits) | static_cast<storage_type>((value & bits) << 1));
+		value = static_cast<storage_type>(((value >> 2) & pairs) | static_cast<storage_type>((value & pairs) << 2));
+		value = static_cast<storage_type>(((value >> 4) & nibbles) | static_cast<storage_type>((value & nibbles) << 4));
+		return plf::reverse_bytes(value);
+	}
+
+
+	// As per write_bits_word, but the bits may span two words:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void write_bits_words(storage_type * const words, const std::size_t position, const std::size_t length, const storage_type value)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8, index = position / bitwidth, shift = position % bitwidth;
+
+		if (shift + length <= bitwidth)
+		{
+			plf::write_bits_word(words[index], shift, length, value);
+		}
+		else
+		{
+			plf::write_bits_word(words[index], shift, bitwidth - shift, value);
+			plf::write_bits_word(words[index + 1], 0, length - (bitwidth - shift), static_cast<storage_type>(value >> (bitwidth - shift)));
+		}
+	}
+
+
+	// Reverses the order of bits [0, total_size) of words. Whole words are swapped end-for-end and bit-reversed, after which the bits occupy the top total_size bits of the buffer and are shifted down. Bits beyond total_size must be zero, and remain so:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void reverse_words(storage_type * const words, const std::size_t total_size)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8, number_of_words = (total_size + bitwidth - 1) / bitwidth;
+		std::size_t low = 0, high = number_of_words;
+
+		#if defined(__GFNI__) && defined(__AVX2__) // On little-endian x86 reversing a run of words' bits is reversing its byte order, then each byte's bits - the latter via a single affine transform
+			#ifdef PLF_CPP20_SUPPORT
+				if (!std::is_constant_evaluated())
+			#endif
+			{
+				const std::size_t words_per_vector = 32 / sizeof(storage_type);
+				const __m256i byte_order = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0), bit_order = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+
+				for (; low + (2 * words_per_vector) <= high; low += words_per_vector, high -= words_per_vector) // Comparisons rather than high - low, so that the compiler can see high >= low
+				{
+					__m256i low_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + low)), high_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + high - words_per_vector));
+					low_vector = _mm256_gf2p8affine_epi64_epi8(_mm256_permute4x64_epi64(_mm256_shuffle_epi8(low_vector, byte_order), 0x4E), bit_order, 0);
+					high_vector = _mm256_gf2p8affine_epi64_epi8(_mm256_permute4x64_epi64(_mm256_shuffle_epi8(high_vector, byte_order), 0x4E), bit_order, 0);
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(words + low), high_vector);
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(words + high - words_per_vector), low_vector);
+				}
+			}
+		#endif
+
+		for (; low + 1 < high; ++low)
+		{
+			const storage_type temp = plf::reverse_bits(words[low]);
+			words[low] = plf::reverse_bits(words[--high]);
+			words[high] = temp;
+		}
+
+		if (low < high) words[low] = plf::reverse_bits(words[low]);
+
+		const std::size_t overflow = (number_of_words * bitwidth) - total_size;
+
+		if (overflow != 0)
+		{
+			plf::copy_bits_words_forwards(words, 0, words, overflow, total_size);
+			words[number_of_words - 1] &= static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> overflow);
+		}
+	}
+
+
+	// Reverses the order of bits [begin, end) of words by swapping bitwidth-bit chunks from either end of the range, then successively smaller chunks in the middle:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void reverse_range_words(storage_type * const words, std::size_t begin, std::size_t end)
+	{
+		const std::size_t bitwidth = sizeof(storage_type) * 8;
+
+		while (end - begin >= 2)
+		{
+			const std::size_t chunk = (end - begin >= 2 * bitwidth) ? bitwidth : (end - begin) / 2;
+			const storage_type low_bits = plf::read_bits_words(words, begin, chunk), high_bits = plf::read_bits_words(words, end - chunk, chunk);
+			end -= chunk;
+			plf::write_bits_words(words, begin, chunk, static_cast<storage_type>(plf::reverse_bits(high_bits) >> (bitwidth - chunk)));
+			plf::write_bits_words(words, end, chunk, static_cast<storage_type>(plf::reverse_bits(low_bits) >> (bitwidth - chunk)));
+			begin += chunk;
+		}
+	}
+
+
+	// Writes bits [0, total_size) of words to destination as a big-endian unsigned integer of (total_size + 7) / 8 bytes, ie. most significant byte first, where bit total_size - 1 is the most significant bit. Any unused high bits of the first byte are zero:
+	template <typename storage_type>
+	static PLF_CONSTFUNC void big_endian_bytes_words(const storage_type * const words, const std::size_t total_size, unsigned char * const destination)
+	{
+		const std::size_t number_of_bytes = (total_size + 7) / 8, number_of_words = number_of_bytes / sizeof(storage_type);
+		unsigned char *out = destination + number_of_bytes;
+
+		for (std::size_t word_index = 0; word_index != number_of_words; ++word_index)
+		{
+			out -= sizeof(storage_type);
+
+			#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_MSC_VER)
+				#ifdef PLF_CPP20_SUPPORT
+					if (!std::is_constant_evaluated())
+				#endif
+				{
+					const storage_type word = plf::reverse_bytes(words[word_index]);
+					std::memcpy(static_cast<void *>(out), static_cast<const void *>(&word), sizeof(storage_type));
+					continue;
+				}
+			#endif
+
+			for (std::size_t byte = 0; byte != sizeof(storage_type); ++byte) out[sizeof(storage_type) - 1 - byte] = static_cast<unsigned char>(words[word_index] >> (byte * 8));
+		}
+
+		for (std::size_t byte = 0; out != destination; ++byte) *--out = static_cast<unsigned char>(words[number_of_words] >> (byte * 8)); // remaining bytes of a partial last word
+	}
+
+
+	template <typename storage_type>
+	static PLF_CONSTFUNC std::size_t count_trailing_zeros(const storage_type value)
+	{
+		#ifdef PLF_CPP20_SUPPORT
+			return static_cast<std::size_t>(std::countr_zero(value));
+		#else
+			return static_cast<std::size_t>(plf::popcount(static_cast<storage_type>(static_cast<storage_type>(value & static_cast<storage_type>(0 - value)) - 1))); // value & -value isolates the lowest set bit, so subtracting one sets only the trailing zeroes - or every bit, if value is zero
+		#endif
+	}
+
+
+	template <typename storage_type>
+	static PLF_CONSTFUNC std::size_t count_trailing_ones(const storage_type value)
+	{
+		#ifdef PLF_CPP20_SUPPORT
+			return static_cast<std::size_t>(std::countr_one(value));
+		#else
+			if (value == std::numeric_limits<storage_type>::max()) return sizeof(storage_type) * 8;
+			return static_cast<std::size_t>(plf::popcount(static_cast<storage_type>(static_cast<storage_type>(value ^ static_cast<storage_type>(value + 1)) >> 1))); // value + 1 clears the trailing ones and sets the bit above them
+		#endif
+	}
+
+
+	template <typename storage_type>
+	static PLF_CONSTFUNC std::size_t count_leading_ones(const storage_type value)
+	{
+		#ifdef PLF_CPP20_SUPPORT
+			return static_cast<std::size_t>(std::countl_one(value));
+		#else
+			std::size_t total = 0;
+			for (std::size_t bit_index = sizeof(storage_type) * 8; bit_index-- != 0 && ((value >> bit_index) & storage_type(1)); ++total) {}
+			return total;
+		#endif
+	}
+
+
+	// Returns the first index >= from at which length consecutive bits with the value !invert begin, or std::numeric_limits<std::size_t>::max() if there is no such run. Words which are entirely part of a run are consumed in one step, runs crossing word boundaries are tracked via each word's trailing and leading ones, and runs within a single word are found by shift-and-AND, ie. after starts &= starts >> shift, each set bit in starts marks a run at least shift bits longer than before:
+	template <typename storage_type>
+	static PLF_CONSTFUNC std::size_t find_run_words(const storage_type * const words, const std::size_t total_size, const std::size_t length, const std::size_t from, const bool invert)
+	{
+		if (from >= total_size) return std::numeric_limits<std::size_t>::max();
+		if (length == 0) return from;
+
+		const std::size_t bitwidth = sizeof(storage_type) * 8, first_word = from / bitwidth, last_word = (total_size - 1) / bitwidth;
+		const storage_type all_ones = std::numeric_limits<storage_type>::max(), flip = (invert) ? all_ones : storage_type(0);
+		std::size_t run_begin = 0, run_length = 0; // a run which continues up to the end of the previous word
+
+		for (std::size_t word_index = first_word; word_index <= last_word; ++word_index)
+		{
+			storage_type word = static_cast<storage_type>(words[word_index] ^ flip);
+			if (word_index == first_word) word &= static_cast<storage_type>(all_ones << (from % bitwidth));
+			if (word_index == last_word) word &= static_cast<storage_type>(all_ones >> ((bitwidth - 1) - ((total_size - 1) % bitwidth))); // bits beyond total_size are never part of a run
+
+			if (word == all_ones)
+			{
+				if (run_length == 0) run_begin = word_index * bitwidth;
+				if ((run_length += bitwidth) >= length) return run_begin;
+				continue;
+			}
+
+			if (run_length != 0 && run_length + plf::count_trailing_ones(word) >= length) return run_begin;
+
+			if (length <= bitwidth)
+			{
+				storage_type starts = word;
+
+				for (std::size_t covered = 1; covered < length && starts != 0;)
+				{
+					const std::size_t shift = (covered < length - covered) ? covered : length - covered;
+					starts &= static_cast<storage_type>(starts >> shift);
+					covered += shift;
+				}
+
+				if (starts != 0) return (word_index * bitwidth) + plf::count_trailing_ones(static_cast<storage_type>(~starts));
+			}
+
+			run_length = plf::count_leading_ones(word);
+			run_begin = ((word_index + 1) * bitwidth) - run_length;
+		}
+
+		return std::numeric_limits<std::size_t>::max();
+	}
+
+
+	#ifdef PLF_BITSET_STATISTICS // Opt-in operation statistics and tracing hooks. Define PLF_BITSET_STATISTICS before including plf_bitset.h/plf_bitsetb.h to enable them, otherwise the instrumentation compiles to nothing:
+		struct bitset_statistics
+		{
+			enum operation_type { set_range_operation, reset_range_operation, flip_range_operation, count_operation, shift_operation, search_operation, allocation_operation, number_of_operations };
+			typedef void (*hook_type)(operation_type operation, std::size_t words, void *user_data);
+
+			struct totals_type
+			{
+				unsigned long long calls, words, bytes; // words/bytes are storage_type units touched (or allocated, for allocation_operation)
+			};
+
+			totals_type totals[number_of_operations];
+			hook_type begin_hook, end_hook; // If either is non-NULL, both are called around every sample_interval'th traced operation, eg. for latency sampling
+			void *hook_user_data;
+			unsigned long long sample_interval, calls_until_sample;
+
+			static const char * operation_name(const operation_type operation)
+			{
+				static const char * const names[number_of_operations] = { "set_range", "reset_range", "flip_range", "count", "shift", "search", "allocation" };
+				return names[operation];
+			}
+		};
+
+
+		// Statistics are per-thread under C++11 and above, so recording needs no synchronization:
+		inline bitset_statistics & get_bitset_statistics()
+		{
+			#ifdef PLF_CPP11_SUPPORT
+				static thread_local bitset_statistics statistics = bitset_statistics();
+			#else
+				static bitset_statistics statistics = bitset_statistics();
+			#endif
+
+			return statistics;
+		}
 
-	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
-		#undef PLF_CONSTEXPR
-		#define PLF_CONSTEXPR constexpr
-	#endif
 
-	// The following line is a little different from other plf:: containers because we need constexpr basic_string in order to make the to_string function constexpr:
-	#if __cplusplus >= 202001L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) &&	_GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
-		#undef PLF_CONSTFUNC
-		#define PLF_CONSTFUNC constexpr
-		#define PLF_CPP20_SUPPORT
-	#endif
+		inline void reset_bitset_statistics()
+		{
+			bitset_statistics &statistics = get_bitset_statistics();
 
-	#if __cplusplus >= 202302L && ((defined(__clang__) && __clang_major__ >= 14) || (defined(__GNUC__) && (__GNUC__ >= 12)))
-		#define PLF_CONSTEVAL_SUPPORT
-	#endif
-#endif
+			for (int operation = 0; operation != bitset_statistics::number_of_operations; ++operation)
+			{
+				statistics.totals[operation].calls = statistics.totals[operation].words = statistics.totals[operation].bytes = 0;
+			}
+		}
 
 
-#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
-#define PLF_ARRAY_CAPACITY ((total_size + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH) // ie. round up to nearest unit of storage
-#define PLF_ARRAY_CAPACITY_BITS (PLF_ARRAY_CAPACITY * PLF_TYPE_BITWIDTH)
-#define PLF_ARRAY_CAPACITY_BYTES (PLF_ARRAY_CAPACITY * sizeof(storage_type))
+		inline void set_bitset_hooks(const bitset_statistics::hook_type begin_hook, const bitset_statistics::hook_type end_hook, void * const user_data = NULL, const unsigned long long sample_interval = 1)
+		{
+			bitset_statistics &statistics = get_bitset_statistics();
+			statistics.begin_hook = begin_hook;
+			statistics.end_hook = end_hook;
+			statistics.hook_user_data = user_data;
+			statistics.sample_interval = statistics.calls_until_sample = (sample_interval == 0) ? 1 : sample_interval;
+		}
 
 
-#include <cmath> // log10
-#include <cassert>
-#include <string>	// std::basic_string
-#include <stdexcept> // std::out_of_range
-#include <limits>  // std::numeric_limits
-#include <ostream>
-#include <cstring>	// memset, size_t
-#include <algorithm> // std::copy, std::equal
+		// The number of storage_types spanned by the bit range [begin, end):
+		inline PLF_CONSTFUNC std::size_t bitset_range_words(const std::size_t begin, const std::size_t end, const std::size_t bitwidth)
+		{
+			return (begin >= end) ? 0 : (((end - 1) / bitwidth) - (begin / bitwidth)) + 1;
+		}
 
-#ifdef PLF_CPP20_SUPPORT
-	#include <bit>  // std::pop_count, std::countr_one, std::countr_zero
-#endif
 
+		template <std::size_t word_bytes>
+		PLF_CONSTFUNC void record_bitset_words(const bitset_statistics::operation_type operation, const std::size_t words)
+		{
+			#ifdef PLF_CPP20_SUPPORT
+				if (!std::is_constant_evaluated())
+			#endif
+			{
+				bitset_statistics::totals_type &totals = get_bitset_statistics().totals[operation];
+				totals.words += words;
+				totals.bytes += static_cast<unsigned long long>(words) * word_bytes;
+			}
+		}
 
 
-namespace plf
-{
+		// Records one call of an operation on destruction, calling the hooks around the operation's scope if sampled:
+		template <std::size_t word_bytes>
+		class bitset_tracer
+		{
+		public:
+			PLF_CONSTFUNC bitset_tracer(const bitset_statistics::operation_type traced_operation, const std::size_t traced_words):
+				operation(traced_operation),
+				words(traced_words),
+				sampled(false)
+			{
+				#ifdef PLF_CPP20_SUPPORT
+					if (!std::is_constant_evaluated())
+				#endif
+				{
+					bitset_statistics &statistics = get_bitset_statistics();
+
+					if ((statistics.begin_hook != NULL || statistics.end_hook != NULL) && --statistics.calls_until_sample == 0)
+					{
+						statistics.calls_until_sample = statistics.sample_interval;
+						sampled = true;
+						if (statistics.begin_hook != NULL) statistics.begin_hook(operation, words, statistics.hook_user_data);
+					}
+				}
+			}
+
+
+			PLF_CONSTFUNC ~bitset_tracer()
+			{
+				#ifdef PLF_CPP20_SUPPORT
+					if (!std::is_constant_evaluated())
+				#endif
+				{
+					bitset_statistics &statistics = get_bitset_statistics();
+					++statistics.totals[operation].calls;
+					record_bitset_words<word_bytes>(operation, words);
+					if (sampled && statistics.end_hook != NULL) statistics.end_hook(operation, words, statistics.hook_user_data);
+				}
+			}
+
+		private:
+			const bitset_statistics::operation_type operation;
+			const std::size_t words;
+			bool sampled;
+		};
+
+
+		#define PLF_BITSET_TRACE(operation, words) plf::bitset_tracer<sizeof(storage_type)> plf_bitset_tracer(plf::bitset_statistics::operation, (words))
+		#define PLF_BITSET_RECORD_WORDS(operation, words) plf::record_bitset_words<sizeof(storage_type)>(plf::bitset_statistics::operation, (words))
+	#else
+		#define PLF_BITSET_TRACE(operation, words)
+		#define PLF_BITSET_RECORD_WORDS(operation, words)
+	#endif
 
 
-#ifndef PLF_BITSET_TOOLS
-	#define PLF_BITSET_TOOLS
 
-	template <typename storage_type>
-	static PLF_CONSTFUNC storage_type popcount(storage_type value)
-	{
-		#ifdef PLF_CPP20_SUPPORT
-			return std::popcount(value); // leverage CPU intrinsics for faster performance
-		#else
-			size_type total = 0;
-			for (; value; ++total) value &= value - 1; // Kernighan's algorithm
-			return total;
-		#endif
-	}
 #endif
 
 
 
+template<bool user_supplied_buffer, typename storage_type, class allocator_type, bool hardened>
+class bitsetb; // see plf_bitsetb.h, for as_view()
+
+template<typename storage_type, bool hardened>
+class bitset_slice; // see plf_bitset_slice.h, for slice()
+
+
+
 template<std::size_t total_size, typename storage_type = std::size_t, bool hardened = false>
 class bitset
 {
@@ -147,13 +963,11 @@ private:
 	storage_type buffer[PLF_ARRAY_CAPACITY];
 
 
-	// These two function calls should be optimized out by the compiler (under C++20) if total_size is a multiple of storage_type bitwidth, but if the "if" statement can't be constexpr due to lack of C++20 support, avoid the CPU penalty of the branch instruction and just perform the operation anyway. The idea is that there may be some remainder in the final storage_type which is unused in the bitset. By default we keep this at 0 for all bits, however some operations require them to be 1 in order to perform optimally. For those operations we set the remainder (overflow) to 1, then back to 0 at the end of the function:
+	// These two function calls are optimized out by the compiler if total_size is a multiple of storage_type bitwidth, as the condition is a compile-time constant (and must be checked, as set_overflow_to_one would otherwise shift by the full width of storage_type). The idea is that there may be some remainder in the final storage_type which is unused in the bitset. By default we keep this at 0 for all bits, however some operations require them to be 1 in order to perform optimally. For those operations we set the remainder (overflow) to 1, then back to 0 at the end of the function:
 
 	PLF_CONSTFUNC void set_overflow_to_one() PLF_NOEXCEPT
 	{ // If total_size < array bit capacity, set all bits > size to 1
-		#ifdef PLF_CPP20_SUPPORT
-			if constexpr (total_size % PLF_TYPE_BITWIDTH != 0)
-		#endif
+		if PLF_CONSTEXPR (total_size % PLF_TYPE_BITWIDTH != 0)
 		{
 			buffer[PLF_ARRAY_CAPACITY - 1] |= std::numeric_limits<storage_type>::max() << (PLF_TYPE_BITWIDTH - (PLF_ARRAY_CAPACITY_BITS - total_size));
 		}
@@ -163,9 +977,7 @@ private:
 
 	PLF_CONSTFUNC void set_overflow_to_zero() PLF_NOEXCEPT
 	{ // If total_size < array bit capacity, set all bits > size to 0
-		#ifdef PLF_CPP20_SUPPORT
-			if constexpr (total_size % PLF_TYPE_BITWIDTH != 0)
-		#endif
+		if PLF_CONSTEXPR (total_size % PLF_TYPE_BITWIDTH != 0)
 		{
 			buffer[PLF_ARRAY_CAPACITY - 1] &= std::numeric_limits<storage_type>::max() >> (PLF_ARRAY_CAPACITY_BITS - total_size);
 		}
@@ -189,6 +1001,20 @@ private:
 	}
 
 
+	PLF_CONSTFUNC void check_source_size_is_equal(const size_type source_size) const
+	{
+		if (source_size != total_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Source size is not equal to size of *this.");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
 public:
 
 	PLF_CONSTFUNC bitset() PLF_NOEXCEPT
@@ -224,7 +1050,7 @@ public:
 	PLF_CONSTFUNC void set() PLF_NOEXCEPT
 	{
 		#ifdef PLF_CONSTEVAL_SUPPORT
-			if consteval
+			PLF_IF_CONSTEVAL
 			{
 				std::fill_n(buffer, PLF_ARRAY_CAPACITY, std::numeric_limits<storage_type>::max()); // fill_n is very slow compared to memset under gcc, particularly in debug mode, but memset isn't constexpr
 			}
@@ -259,6 +1085,8 @@ public:
 
 	PLF_CONSTFUNC void set_range(const size_type begin, const size_type end)
 	{
+		PLF_BITSET_TRACE(set_range_operation, plf::bitset_range_words(begin, end, PLF_TYPE_BITWIDTH));
+
 		if PLF_CONSTEXPR (hardened)
 		{
 			check_index_is_within_size(begin);
@@ -273,7 +1101,7 @@ public:
 			return;
 		}
 
-		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = PLF_TYPE_BITWIDTH - (end % PLF_TYPE_BITWIDTH);
+		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH);
 
 		if (begin_type_index != end_type_index) // ie. if first and last bit to be set are not in the same storage_type unit
 		{
@@ -282,7 +1110,7 @@ public:
 
 			// Fill all intermediate storage_type's (if any):
 			#ifdef PLF_CONSTEVAL_SUPPORT
-				if consteval
+				PLF_IF_CONSTEVAL
 				{
 					std::fill_n(buffer + begin_type_index + 1, (end_type_index - 1) - begin_type_index, std::numeric_limits<storage_type>::max());
 				}
@@ -317,10 +1145,71 @@ public:
 
 
 
+	// Sets multiple [begin, end) ranges in one call. The ranges must be sorted and non-overlapping, and are supplied as bidirectional iterators to std::pair-like elements (.first == begin, .second == end), eg. from a std::vector or std::span. Only the first begin and last end are bounds-checked when hardened, and writes to a storage_type shared between adjacent ranges are merged into a single write:
+	template <class iterator_type>
+	PLF_CONSTFUNC void set_ranges(iterator_type current, const iterator_type end)
+	{
+		if (current == end) return;
+		PLF_BITSET_TRACE(set_range_operation, 0);
+
+		if PLF_CONSTEXPR (hardened)
+		{
+			iterator_type last = end;
+			check_index_is_within_size(current->first);
+			check_index_is_within_size((--last)->second);
+		}
+
+		size_type pending_index = 0;
+		storage_type pending_word = 0;
+
+		for (; current != end; ++current)
+		{
+			const size_type range_begin = current->first, range_end = current->second;
+			if (range_begin == range_end) continue;
+
+			const size_type begin_type_index = range_begin / PLF_TYPE_BITWIDTH, end_type_index = (range_end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = range_begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((range_end - 1) % PLF_TYPE_BITWIDTH);
+			PLF_BITSET_RECORD_WORDS(set_range_operation, (end_type_index - begin_type_index) + 1);
+
+			if (begin_type_index != pending_index)
+			{
+				buffer[pending_index] |= pending_word;
+				pending_index = begin_type_index;
+				pending_word = 0;
+			}
+
+			if (begin_type_index != end_type_index)
+			{
+				buffer[begin_type_index] |= pending_word | (std::numeric_limits<storage_type>::max() << begin_subindex);
+
+				#ifdef PLF_CONSTEVAL_SUPPORT
+					PLF_IF_CONSTEVAL
+					{
+						std::fill_n(buffer + begin_type_index + 1, (end_type_index - 1) - begin_type_index, std::numeric_limits<storage_type>::max());
+					}
+					else
+				#endif
+				{
+					std::memset(static_cast<void *>(buffer + begin_type_index + 1), std::numeric_limits<unsigned char>::max(), ((end_type_index - 1) - begin_type_index) * sizeof(storage_type));
+				}
+
+				pending_index = end_type_index;
+				pending_word = std::numeric_limits<storage_type>::max() >> distance_to_end_storage;
+			}
+			else
+			{
+				pending_word |= (std::numeric_limits<storage_type>::max() << begin_subindex) & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage);
+			}
+		}
+
+		buffer[pending_index] |= pending_word;
+	}
+
+
+
 	PLF_CONSTFUNC void reset() PLF_NOEXCEPT
 	{
 		#ifdef PLF_CONSTEVAL_SUPPORT
-			if consteval
+			PLF_IF_CONSTEVAL
 			{
 				std::fill_n(buffer, PLF_ARRAY_CAPACITY, 0);
 			}
@@ -344,6 +1233,8 @@ public:
 
 	PLF_CONSTFUNC void reset_range(const size_type begin, const size_type end)
 	{
+		PLF_BITSET_TRACE(reset_range_operation, plf::bitset_range_words(begin, end, PLF_TYPE_BITWIDTH));
+
 		if PLF_CONSTEXPR (hardened)
 		{
 			check_index_is_within_size(begin);
@@ -358,14 +1249,14 @@ public:
 			return;
 		}
 
-		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = PLF_TYPE_BITWIDTH - (end % PLF_TYPE_BITWIDTH);
+		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH);
 
 		if (begin_type_index != end_type_index)
 		{
 			buffer[begin_type_index] &= ~(std::numeric_limits<storage_type>::max() << begin_subindex);
 
 			#ifdef PLF_CONSTEVAL_SUPPORT
-				if consteval
+				PLF_IF_CONSTEVAL
 				{
 					std::fill_n(buffer + begin_type_index + 1, (end_type_index - 1) - begin_type_index, 0);
 				}
@@ -385,6 +1276,67 @@ public:
 
 
 
+	// See set_ranges for the requirements on ranges:
+	template <class iterator_type>
+	PLF_CONSTFUNC void reset_ranges(iterator_type current, const iterator_type end)
+	{
+		if (current == end) return;
+		PLF_BITSET_TRACE(reset_range_operation, 0);
+
+		if PLF_CONSTEXPR (hardened)
+		{
+			iterator_type last = end;
+			check_index_is_within_size(current->first);
+			check_index_is_within_size((--last)->second);
+		}
+
+		size_type pending_index = 0;
+		storage_type pending_word = 0; // bits to be cleared
+
+		for (; current != end; ++current)
+		{
+			const size_type range_begin = current->first, range_end = current->second;
+			if (range_begin == range_end) continue;
+
+			const size_type begin_type_index = range_begin / PLF_TYPE_BITWIDTH, end_type_index = (range_end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = range_begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((range_end - 1) % PLF_TYPE_BITWIDTH);
+			PLF_BITSET_RECORD_WORDS(reset_range_operation, (end_type_index - begin_type_index) + 1);
+
+			if (begin_type_index != pending_index)
+			{
+				buffer[pending_index] &= ~pending_word;
+				pending_index = begin_type_index;
+				pending_word = 0;
+			}
+
+			if (begin_type_index != end_type_index)
+			{
+				buffer[begin_type_index] &= ~(pending_word | (std::numeric_limits<storage_type>::max() << begin_subindex));
+
+				#ifdef PLF_CONSTEVAL_SUPPORT
+					PLF_IF_CONSTEVAL
+					{
+						std::fill_n(buffer + begin_type_index + 1, (end_type_index - 1) - begin_type_index, 0);
+					}
+					else
+				#endif
+				{
+					std::memset(static_cast<void *>(buffer + begin_type_index + 1), 0, ((end_type_index - 1) - begin_type_index) * sizeof(storage_type));
+				}
+
+				pending_index = end_type_index;
+				pending_word = std::numeric_limits<storage_type>::max() >> distance_to_end_storage;
+			}
+			else
+			{
+				pending_word |= (std::numeric_limits<storage_type>::max() << begin_subindex) & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage);
+			}
+		}
+
+		buffer[pending_index] &= ~pending_word;
+	}
+
+
+
 	PLF_CONSTFUNC void flip() PLF_NOEXCEPT
 	{
 		for (size_type current = 0, end = PLF_ARRAY_CAPACITY; current != end; ++current) buffer[current] = ~buffer[current];
@@ -400,8 +1352,120 @@ public:
 
 
 
+	PLF_CONSTFUNC void flip_range(const size_type begin, const size_type end)
+	{
+		PLF_BITSET_TRACE(flip_range_operation, plf::bitset_range_words(begin, end, PLF_TYPE_BITWIDTH));
+
+		if PLF_CONSTEXPR (hardened)
+		{
+			check_index_is_within_size(begin);
+			check_index_is_within_size(end);
+		}
+
+		if (begin == end)
+		#ifdef PLF_CPP20_SUPPORT
+			[[unlikely]]
+		#endif
+		{
+			return;
+		}
+
+		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH);
+
+		if (begin_type_index != end_type_index)
+		{
+			buffer[begin_type_index] ^= std::numeric_limits<storage_type>::max() << begin_subindex;
+
+			for (size_type current = begin_type_index + 1; current != end_type_index; ++current) buffer[current] = ~buffer[current];
+
+			buffer[end_type_index] ^= std::numeric_limits<storage_type>::max() >> distance_to_end_storage;
+		}
+		else
+		{
+			buffer[begin_type_index] ^= (std::numeric_limits<storage_type>::max() << begin_subindex) & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage);
+		}
+	}
+
+
+
+	// Reverses the order of the bits, ie. bit 0 becomes bit size() - 1 and vice versa:
+	PLF_CONSTFUNC void reverse() PLF_NOEXCEPT
+	{
+		plf::reverse_words(buffer, total_size);
+	}
+
+
+
+	// Reverses the order of the bits in [begin, end):
+	PLF_CONSTFUNC void reverse_range(const size_type begin, const size_type end)
+	{
+		if PLF_CONSTEXPR (hardened) plf::check_bit_range(total_size, begin, end - begin);
+		plf::reverse_range_words(buffer, begin, end);
+	}
+
+
+
+	// See set_ranges for the requirements on ranges:
+	template <class iterator_type>
+	PLF_CONSTFUNC void flip_ranges(iterator_type current, const iterator_type end)
+	{
+		if (current == end) return;
+		PLF_BITSET_TRACE(flip_range_operation, 0);
+
+		if PLF_CONSTEXPR (hardened)
+		{
+			iterator_type last = end;
+			check_index_is_within_size(current->first);
+			check_index_is_within_size((--last)->second);
+		}
+
+		size_type pending_index = 0;
+		storage_type pending_word = 0;
+
+		for (; current != end; ++current)
+		{
+			const size_type range_begin = current->first, range_end = current->second;
+			if (range_begin == range_end) continue;
+
+			const size_type begin_type_index = range_begin / PLF_TYPE_BITWIDTH, end_type_index = (range_end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = range_begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((range_end - 1) % PLF_TYPE_BITWIDTH);
+			PLF_BITSET_RECORD_WORDS(flip_range_operation, (end_type_index - begin_type_index) + 1);
+
+			if (begin_type_index != pending_index)
+			{
+				buffer[pending_index] ^= pending_word;
+				pending_index = begin_type_index;
+				pending_word = 0;
+			}
+
+			if (begin_type_index != end_type_index)
+			{
+				buffer[begin_type_index] ^= pending_word ^ (std::numeric_limits<storage_type>::max() << begin_subindex);
+
+				for (size_type word = begin_type_index + 1; word != end_type_index; ++word) buffer[word] = ~buffer[word];
+
+				pending_index = end_type_index;
+				pending_word = std::numeric_limits<storage_type>::max() >> distance_to_end_storage;
+			}
+			else
+			{
+				pending_word ^= (std::numeric_limits<storage_type>::max() << begin_subindex) & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage);
+			}
+		}
+
+		buffer[pending_index] ^= pending_word;
+	}
+
+
+
 	PLF_CONSTFUNC bool all() PLF_NOEXCEPT
 	{
+		if PLF_CONSTEXPR (PLF_ARRAY_CAPACITY <= 4) // Small bitsets: combine all words without branching, rather than toggling the overflow bits
+		{
+			storage_type combined = static_cast<storage_type>(buffer[PLF_ARRAY_CAPACITY - 1] | ~(std::numeric_limits<storage_type>::max() >> (PLF_ARRAY_CAPACITY_BITS - total_size)));
+			for (size_type current = 0; current != PLF_ARRAY_CAPACITY - 1; ++current) combined &= buffer[current];
+			return combined == std::numeric_limits<storage_type>::max();
+		}
+
 		set_overflow_to_one();
 
 		for (size_type current = 0, end = PLF_ARRAY_CAPACITY; current != end; ++current)
@@ -437,7 +1501,7 @@ public:
 			return false;
 		}
 
-		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = PLF_TYPE_BITWIDTH - (end % PLF_TYPE_BITWIDTH);
+		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH);
 
 		if (begin_type_index != end_type_index) // ie. if first and last bit to be set are not in the same storage_type unit
 		{
@@ -480,8 +1544,15 @@ public:
 
 
 
-	PLF_CONSTFUNC bool any() const PLF_NOEXCEPT
-	{
+	PLF_CONSTFUNC bool any() const PLF_NOEXCEPT
+	{
+		if PLF_CONSTEXPR (PLF_ARRAY_CAPACITY <= 4)
+		{
+			storage_type combined = buffer[0];
+			for (size_type current = 1; current != PLF_ARRAY_CAPACITY; ++current) combined |= buffer[current];
+			return combined != 0;
+		}
+
 		for (size_type current = 0, end = PLF_ARRAY_CAPACITY; current != end; ++current)
 		{
 			if (buffer[current] != 0) return true;
@@ -508,7 +1579,7 @@ public:
 			return false;
 		}
 
-		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = PLF_TYPE_BITWIDTH - (end % PLF_TYPE_BITWIDTH);
+		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH);
 
 		if (begin_type_index != end_type_index)
 		{
@@ -548,11 +1619,13 @@ public:
 
 	PLF_CONSTFUNC size_type count() const PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(count_operation, PLF_ARRAY_CAPACITY);
+
 		size_type total = 0;
 
 		for (size_type current = 0, end = PLF_ARRAY_CAPACITY; current != end; ++current)
 		{
-			total += plf::popcount(buffer[current]);
+			total += plf::popcount<storage_type>(buffer[current]);
 		}
 
 		return total;
@@ -562,6 +1635,8 @@ public:
 
 	PLF_CONSTFUNC size_type count_range(const size_type begin, const size_type end) const
 	{
+		PLF_BITSET_TRACE(count_operation, plf::bitset_range_words(begin, end, PLF_TYPE_BITWIDTH));
+
 		if PLF_CONSTEXPR (hardened)
 		{
 			check_index_is_within_size(begin);
@@ -576,27 +1651,79 @@ public:
 			return 0;
 		}
 
-		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = PLF_TYPE_BITWIDTH - (end % PLF_TYPE_BITWIDTH);
+		const size_type begin_type_index = begin / PLF_TYPE_BITWIDTH, end_type_index = (end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH);
 
 		if (begin_type_index != end_type_index) // ie. if first and last bit to be set are not in the same storage_type unit
 		{
 			// Count first storage_type:
-			size_type total = plf::popcount(buffer[begin_type_index] & (std::numeric_limits<storage_type>::max() << begin_subindex));
+			size_type total = plf::popcount<storage_type>(buffer[begin_type_index] & (std::numeric_limits<storage_type>::max() << begin_subindex));
 
 			// Count all intermediate storage_type's (if any):
 			for (size_type current = begin_type_index + 1; current != end_type_index; ++current)
 			{
-				total += plf::popcount(buffer[current]);
+				total += plf::popcount<storage_type>(buffer[current]);
 			}
 
 			// Count last storage_type:
-			total += plf::popcount(buffer[end_type_index] & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage));
+			total += plf::popcount<storage_type>(buffer[end_type_index] & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage));
 			return total;
 		}
 		else
 		{
-			return plf::popcount(buffer[begin_type_index] & ((std::numeric_limits<storage_type>::max() << begin_subindex) & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage)));
+			return plf::popcount<storage_type>(buffer[begin_type_index] & ((std::numeric_limits<storage_type>::max() << begin_subindex) & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage)));
+		}
+	}
+
+
+
+	// Total count of all supplied ranges. See set_ranges for the requirements on ranges:
+	template <class iterator_type>
+	PLF_CONSTFUNC size_type count_ranges(iterator_type current, const iterator_type end) const
+	{
+		if (current == end) return 0;
+		PLF_BITSET_TRACE(count_operation, 0);
+
+		if PLF_CONSTEXPR (hardened)
+		{
+			iterator_type last = end;
+			check_index_is_within_size(current->first);
+			check_index_is_within_size((--last)->second);
+		}
+
+		size_type total = 0, pending_index = 0;
+		storage_type pending_word = 0; // bits to be counted
+
+		for (; current != end; ++current)
+		{
+			const size_type range_begin = current->first, range_end = current->second;
+			if (range_begin == range_end) continue;
+
+			const size_type begin_type_index = range_begin / PLF_TYPE_BITWIDTH, end_type_index = (range_end - 1) / PLF_TYPE_BITWIDTH, begin_subindex = range_begin % PLF_TYPE_BITWIDTH, distance_to_end_storage = (PLF_TYPE_BITWIDTH - 1) - ((range_end - 1) % PLF_TYPE_BITWIDTH);
+			PLF_BITSET_RECORD_WORDS(count_operation, (end_type_index - begin_type_index) + 1);
+
+			if (begin_type_index != pending_index)
+			{
+				total += plf::popcount<storage_type>(buffer[pending_index] & pending_word);
+				pending_index = begin_type_index;
+				pending_word = 0;
+			}
+
+			if (begin_type_index != end_type_index)
+			{
+				total += plf::popcount<storage_type>(buffer[begin_type_index] & (pending_word | (std::numeric_limits<storage_type>::max() << begin_subindex)));
+
+				for (size_type word = begin_type_index + 1; word != end_type_index; ++word) total += plf::popcount<storage_type>(buffer[word]);
+
+				pending_index = end_type_index;
+				pending_word = std::numeric_limits<storage_type>::max() >> distance_to_end_storage;
+			}
+			else
+			{
+				pending_word |= (std::numeric_limits<storage_type>::max() << begin_subindex) & (std::numeric_limits<storage_type>::max() >> distance_to_end_storage);
+			}
 		}
+
+		return total + plf::popcount<storage_type>(buffer[pending_index] & pending_word);
 	}
 
 
@@ -604,14 +1731,17 @@ public:
 private:
 
 
-	PLF_CONSTFUNC size_type search_one_forwards(size_type word_index) const PLF_NOEXCEPT
+	PLF_CONSTFUNC size_type search_one_forwards(const size_type first_word) const PLF_NOEXCEPT
 	{
+		size_type word_index = first_word;
 		const size_type end = PLF_ARRAY_CAPACITY;
 
 		do
 		{
 			if (buffer[word_index] != 0)
 			{
+				PLF_BITSET_RECORD_WORDS(search_operation, (word_index - first_word) + 1);
+
 				#ifdef PLF_CPP20_SUPPORT
 					return (word_index * PLF_TYPE_BITWIDTH) + std::countr_zero(buffer[word_index]);
 				#else
@@ -623,17 +1753,22 @@ private:
 			}
 		} while (++word_index != end);
 
+		PLF_BITSET_RECORD_WORDS(search_operation, end - first_word);
 		return std::numeric_limits<size_type>::max();
 	}
 
 
 
-	PLF_CONSTFUNC size_type search_one_backwards(size_type word_index) const PLF_NOEXCEPT
+	PLF_CONSTFUNC size_type search_one_backwards(const size_type first_word) const PLF_NOEXCEPT
 	{
+		size_type word_index = first_word;
+
 		do
 		{
 			if (buffer[word_index] != 0)
 			{
+				PLF_BITSET_RECORD_WORDS(search_operation, (first_word - word_index) + 1);
+
 				#ifdef PLF_CPP20_SUPPORT
 					return (((word_index + 1) * PLF_TYPE_BITWIDTH) - std::countl_zero(buffer[word_index])) - 1;
 				#else
@@ -645,13 +1780,15 @@ private:
 			}
 		} while (word_index-- != 0);
 
+		PLF_BITSET_RECORD_WORDS(search_operation, first_word + 1);
 		return std::numeric_limits<size_type>::max();
 	}
 
 
 
-	PLF_CONSTFUNC size_type search_zero_forwards(size_type word_index) PLF_NOEXCEPT
+	PLF_CONSTFUNC size_type search_zero_forwards(const size_type first_word) PLF_NOEXCEPT
 	{
+		size_type word_index = first_word;
 		const size_type end = PLF_ARRAY_CAPACITY;
 		size_type index = std::numeric_limits<size_type>::max();
 		set_overflow_to_one();
@@ -665,7 +1802,11 @@ private:
 				#else
 					for (storage_type bit_index = 0, value = buffer[word_index]; ; ++bit_index)
 					{
-						if (!(value & (storage_type(1) << bit_index))) index = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+						if (!(value & (storage_type(1) << bit_index)))
+						{
+							index = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+							break;
+						}
 					}
 				#endif
 
@@ -673,13 +1814,15 @@ private:
 			}
 		} while (++word_index != end);
 
+		PLF_BITSET_RECORD_WORDS(search_operation, (index != std::numeric_limits<size_type>::max()) ? (word_index - first_word) + 1 : end - first_word);
 		return index;
 	}
 
 
 
-	PLF_CONSTFUNC size_type search_zero_backwards(size_type word_index) PLF_NOEXCEPT
+	PLF_CONSTFUNC size_type search_zero_backwards(const size_type first_word) PLF_NOEXCEPT
 	{
+		size_type word_index = first_word;
 		size_type index = std::numeric_limits<size_type>::max();
 		set_overflow_to_one();
 
@@ -692,7 +1835,11 @@ private:
 				#else
 					for (storage_type bit_index = PLF_TYPE_BITWIDTH - 1, value = buffer[word_index]; ; --bit_index)
 					{
-						if (!(value & (storage_type(1) << bit_index))) index = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+						if (!(value & (storage_type(1) << bit_index)))
+						{
+							index = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+							break;
+						}
 					}
 				#endif
 
@@ -701,15 +1848,58 @@ private:
 		} while (word_index-- != 0);
 
 		set_overflow_to_zero();
+		PLF_BITSET_RECORD_WORDS(search_operation, (index != std::numeric_limits<size_type>::max()) ? (first_word - word_index) + 1 : first_word + 1);
 		return index;
 	}
 
 
 
+	// Returns the index one past the end of the run of ones which contains index:
+	PLF_CONSTFUNC size_type search_run_end(const size_type index) const PLF_NOEXCEPT
+	{
+		size_type word_index = index / PLF_TYPE_BITWIDTH;
+		const size_type subindex = index % PLF_TYPE_BITWIDTH;
+		const storage_type current_word = static_cast<storage_type>(buffer[word_index] >> subindex);
+
+		if (current_word != static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> subindex)) // ie. run ends within the current word
+		{
+			#ifdef PLF_CPP20_SUPPORT
+				return index + std::countr_one(current_word);
+			#else
+				for (size_type bit_index = 0; ; ++bit_index)
+				{
+					if (!(current_word & (storage_type(1) << bit_index))) return index + bit_index;
+				}
+			#endif
+		}
+
+		// Overflow bits are always zero, so the run cannot extend past total_size unless total_size is a multiple of PLF_TYPE_BITWIDTH:
+		for (const size_type end = PLF_ARRAY_CAPACITY; ++word_index != end;)
+		{
+			if (buffer[word_index] != std::numeric_limits<storage_type>::max())
+			{
+				#ifdef PLF_CPP20_SUPPORT
+					return (word_index * PLF_TYPE_BITWIDTH) + std::countr_one(buffer[word_index]);
+				#else
+					for (size_type bit_index = 0, value = buffer[word_index]; ; ++bit_index)
+					{
+						if (!(value & (storage_type(1) << bit_index))) return (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+					}
+				#endif
+			}
+		}
+
+		return total_size;
+	}
+
+
+
 public:
 
 	PLF_CONSTFUNC size_type first_one() const PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(search_operation, 0);
+
 		return search_one_forwards(0);
 	}
 
@@ -717,6 +1907,8 @@ public:
 
 	PLF_CONSTFUNC size_type next_one(size_type index) const PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(search_operation, 1);
+
 		if (index >= total_size) return std::numeric_limits<size_type>::max();
 
 		size_type word_index = index / PLF_TYPE_BITWIDTH;
@@ -744,6 +1936,8 @@ public:
 
 	PLF_CONSTFUNC size_type last_one() const PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(search_operation, 0);
+
 		return search_one_backwards(PLF_ARRAY_CAPACITY - 1);
 	}
 
@@ -751,14 +1945,16 @@ public:
 
 	PLF_CONSTFUNC size_type prev_one(size_type index) const PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(search_operation, 1);
+
 		if (index >= total_size) return std::numeric_limits<size_type>::max();
 
 		const size_type word_index = index / PLF_TYPE_BITWIDTH;
 		index %= PLF_TYPE_BITWIDTH;
 
-		const storage_type current_word = buffer[word_index] << (PLF_TYPE_BITWIDTH - index);
+		const storage_type current_word = (index != 0) ? static_cast<storage_type>(buffer[word_index] << (PLF_TYPE_BITWIDTH - index)) : storage_type(0); // a shift by the full width is undefined
 
-		if (index != 0 && current_word != 0)
+		if (current_word != 0)
 		{
 			#ifdef PLF_CPP20_SUPPORT
 				return ((word_index * PLF_TYPE_BITWIDTH) + index - 1) - std::countl_zero(current_word);
@@ -770,7 +1966,7 @@ public:
 			#endif
 		}
 
-		if (word_index == 0) return std::numeric_limits<storage_type>::max();
+		if (word_index == 0) return std::numeric_limits<size_type>::max();
 
 		return search_one_backwards(word_index - 1);
 	}
@@ -779,6 +1975,8 @@ public:
 
 	PLF_CONSTFUNC size_type first_zero() PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(search_operation, 0);
+
 		return search_zero_forwards(0);
 	}
 
@@ -786,6 +1984,8 @@ public:
 
 	PLF_CONSTFUNC size_type next_zero(size_type index) PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(search_operation, 1);
+
 		if (index >= total_size) return std::numeric_limits<size_type>::max();
 		set_overflow_to_one();
 
@@ -800,7 +2000,11 @@ public:
 			#else
 				for (storage_type bit_index = 0; ; ++bit_index)
 				{
-					if (!(current_word & (storage_type(1) << bit_index))) index = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+					if (!(current_word & (storage_type(1) << bit_index)))
+					{
+						index = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+						break;
+					}
 				}
 			#endif
 
@@ -817,6 +2021,8 @@ public:
 
 	PLF_CONSTFUNC size_type last_zero() PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(search_operation, 0);
+
 		return search_zero_backwards(PLF_ARRAY_CAPACITY - 1);
 	}
 
@@ -824,6 +2030,8 @@ public:
 
 	PLF_CONSTFUNC size_type prev_zero(size_type index) PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(search_operation, 1);
+
 		if (index >= total_size) return std::numeric_limits<size_type>::max();
 		set_overflow_to_one();
 
@@ -839,7 +2047,11 @@ public:
 			#else
 				for (storage_type bit_index = PLF_TYPE_BITWIDTH - 1; ; --bit_index)
 				{
-					if (!(current_word & (storage_type(1) << bit_index))) index = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+					if (!(current_word & (storage_type(1) << bit_index)))
+					{
+						index = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+						break;
+					}
 				}
 			#endif
 
@@ -847,13 +2059,58 @@ public:
 			return index;
 		}
 
-		if (word_index == 0) return std::numeric_limits<storage_type>::max();
+		if (word_index == 0)
+		{
+			set_overflow_to_zero();
+			return std::numeric_limits<size_type>::max();
+		}
 
 		return search_zero_backwards(word_index - 1);
 	}
 
 
 
+	// Returns the [begin, end) of the next run of ones, searching from index onwards, or a pair of std::numeric_limits<size_type>::max() if there are no further ones:
+	PLF_CONSTFUNC std::pair<size_type, size_type> next_run(const size_type index) const PLF_NOEXCEPT
+	{
+		const size_type begin = next_one(index);
+		if (begin == std::numeric_limits<size_type>::max()) return std::pair<size_type, size_type>(begin, begin);
+		return std::pair<size_type, size_type>(begin, search_run_end(begin));
+	}
+
+
+
+	// Calls function(begin, end) for every maximal run of ones in the bitset, in ascending order:
+	template <class function_type>
+	PLF_CONSTFUNC void for_each_run(function_type function) const
+	{
+		for (size_type begin = search_one_forwards(0); begin != std::numeric_limits<size_type>::max();)
+		{
+			const size_type end = search_run_end(begin);
+			function(begin, end);
+			begin = next_one(end);
+		}
+	}
+
+
+	// Returns the first index >= from at which a run of at least length set bits begins, or std::numeric_limits<size_type>::max() if there is none, eg. for finding free extents in an occupancy map:
+	PLF_CONSTFUNC size_type find_one_run(const size_type length, const size_type from = 0) const PLF_NOEXCEPT
+	{
+		PLF_BITSET_TRACE(search_operation, 1);
+		return plf::find_run_words(buffer, total_size, length, from, false);
+	}
+
+
+
+	PLF_CONSTFUNC size_type find_zero_run(const size_type length, const size_type from = 0) const PLF_NOEXCEPT
+	{
+		PLF_BITSET_TRACE(search_operation, 1);
+		return plf::find_run_words(buffer, total_size, length, from, true);
+	}
+
+
+
+
 	PLF_CONSTFUNC void operator = (const bitset &source) PLF_NOEXCEPT
 	{
 		std::copy(source.buffer, source.buffer + PLF_ARRAY_CAPACITY, buffer);
@@ -863,6 +2120,13 @@ public:
 
  	PLF_CONSTFUNC bool operator == (const bitset &source) const PLF_NOEXCEPT
 	{
+		if PLF_CONSTEXPR (PLF_ARRAY_CAPACITY <= 4)
+		{
+			storage_type difference = buffer[0] ^ source.buffer[0];
+			for (size_type current = 1; current != PLF_ARRAY_CAPACITY; ++current) difference |= buffer[current] ^ source.buffer[current];
+			return difference == 0;
+		}
+
 		return std::equal(source.buffer, source.buffer + PLF_ARRAY_CAPACITY, buffer);
 	}
 
@@ -874,6 +2138,42 @@ public:
 	}
 
 
+	// Ordering is that of the bitsets as unsigned integers ie. the most-significant (highest-index) differing bit decides. This is the same order as comparing to_string() output:
+	#ifdef PLF_CPP20_SUPPORT
+		PLF_CONSTFUNC std::strong_ordering operator <=> (const bitset &source) const PLF_NOEXCEPT
+		{
+			return plf::compare_words(buffer, source.buffer, PLF_ARRAY_CAPACITY) <=> 0;
+		}
+	#else
+		PLF_CONSTFUNC bool operator < (const bitset &source) const PLF_NOEXCEPT
+		{
+			return plf::compare_words(buffer, source.buffer, PLF_ARRAY_CAPACITY) < 0;
+		}
+
+
+
+		PLF_CONSTFUNC bool operator > (const bitset &source) const PLF_NOEXCEPT
+		{
+			return source < *this;
+		}
+
+
+
+		PLF_CONSTFUNC bool operator <= (const bitset &source) const PLF_NOEXCEPT
+		{
+			return !(source < *this);
+		}
+
+
+
+		PLF_CONSTFUNC bool operator >= (const bitset &source) const PLF_NOEXCEPT
+		{
+			return !(*this < source);
+		}
+	#endif
+
+
+
 
 	PLF_CONSTFUNC size_type size() const PLF_NOEXCEPT
  	{
@@ -881,6 +2181,48 @@ public:
  	}
 
 
+	PLF_CONSTFUNC storage_type * data() PLF_NOEXCEPT
+	{
+		return buffer;
+	}
+
+
+
+	PLF_CONSTFUNC const storage_type * data() const PLF_NOEXCEPT
+	{
+		return buffer;
+	}
+
+
+	// Returns a plf::bitsetb<true> over this bitset's buffer, eg. to pass a fixed-size bitset to a function taking a bitsetb, without copying. Changes made through the view are made to *this, and the view must not outlive it. plf_bitsetb.h must be included to call this:
+	PLF_CONSTFUNC bitsetb<true, storage_type, std::allocator<storage_type>, hardened> as_view() PLF_NOEXCEPT
+	{
+		return bitsetb<true, storage_type, std::allocator<storage_type>, hardened>(total_size, buffer, false);
+	}
+
+
+	// Returns a plf::bitset_slice over the bits [offset, offset + length), which can be searched, counted, shifted and combined with other bitsets in place, without copying. offset need not be aligned to storage_type. Changes made through the slice are made to *this, and the slice must not outlive it. plf_bitset_slice.h must be included to call this:
+	bitset_slice<storage_type, hardened> slice(const size_type offset, const size_type length)
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			if (offset > total_size || length > total_size - offset)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Slice is not within bitset");
+				#else
+					std::terminate();
+				#endif
+			}
+		}
+
+		return bitset_slice<storage_type, hardened>(buffer, offset, length);
+	}
+
+
+
+
+
 
 	PLF_CONSTFUNC bitset & operator &= (const bitset& source) PLF_NOEXCEPT
 	{
@@ -941,9 +2283,135 @@ public:
 	}
 
 
+	// The following templated operators accept any plf bitset type with the same storage_type and size as *this, eg. a plf::bitsetb of runtime size or another bitset's as_view(). The non-template overloads above are used when both operands are the same type:
+	template <class bitset_type>
+	PLF_CONSTFUNC bitset & operator &= (const bitset_type &source)
+	{
+		check_source_size_is_equal(source.size());
+		plf::bitwise_words<plf::and_operation>(buffer, buffer, source.data(), total_size);
+		return *this;
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC bitset operator & (const bitset_type &source) const
+	{
+		check_source_size_is_equal(source.size());
+		bitset result;
+		plf::bitwise_words<plf::and_operation>(result.buffer, buffer, source.data(), total_size);
+		return result;
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC bitset & operator |= (const bitset_type &source)
+	{
+		check_source_size_is_equal(source.size());
+		plf::bitwise_words<plf::or_operation>(buffer, buffer, source.data(), total_size);
+		return *this;
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC bitset operator | (const bitset_type &source) const
+	{
+		check_source_size_is_equal(source.size());
+		bitset result;
+		plf::bitwise_words<plf::or_operation>(result.buffer, buffer, source.data(), total_size);
+		return result;
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC bitset & operator ^= (const bitset_type &source)
+	{
+		check_source_size_is_equal(source.size());
+		plf::bitwise_words<plf::xor_operation>(buffer, buffer, source.data(), total_size);
+		return *this;
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC bitset operator ^ (const bitset_type &source) const
+	{
+		check_source_size_is_equal(source.size());
+		bitset result;
+		plf::bitwise_words<plf::xor_operation>(result.buffer, buffer, source.data(), total_size);
+		return result;
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC void operator = (const bitset_type &source)
+	{
+		check_source_size_is_equal(source.size());
+		std::copy(source.data(), source.data() + PLF_ARRAY_CAPACITY, buffer);
+	}
+
+
+	// The following four functions accept any plf bitset type with the same storage_type and size as *this eg. plf::bitset and plf::bitsetb may be mixed:
+	template <class bitset_type>
+	PLF_CONSTFUNC bool is_subset_of(const bitset_type &source) const
+	{
+		check_source_size_is_equal(source.size());
+		return !plf::any_intersection(buffer, source.data(), PLF_ARRAY_CAPACITY, storage_type(0), std::numeric_limits<storage_type>::max());
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC bool is_superset_of(const bitset_type &source) const
+	{
+		check_source_size_is_equal(source.size());
+		return !plf::any_intersection(buffer, source.data(), PLF_ARRAY_CAPACITY, std::numeric_limits<storage_type>::max(), storage_type(0));
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC bool intersects(const bitset_type &source) const
+	{
+		check_source_size_is_equal(source.size());
+		return plf::any_intersection(buffer, source.data(), PLF_ARRAY_CAPACITY, storage_type(0), storage_type(0));
+	}
+
+
+
+	template <class bitset_type>
+	PLF_CONSTFUNC bool is_disjoint(const bitset_type &source) const
+	{
+		return !intersects(source);
+	}
+
+
+
 
 	PLF_CONSTFUNC bitset & operator >>= (size_type shift_amount) PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(shift_operation, PLF_ARRAY_CAPACITY);
+
+		if PLF_CONSTEXPR (PLF_ARRAY_CAPACITY == 1) // Single-word bitsets: shift the word directly
+		{
+			buffer[0] = (shift_amount < total_size) ? static_cast<storage_type>(buffer[0] >> shift_amount) : storage_type(0);
+			return *this;
+		}
+		#ifdef __SIZEOF_INT128__
+			else if PLF_CONSTEXPR (PLF_ARRAY_CAPACITY == 2 && PLF_TYPE_BITWIDTH <= 64) // Two-word bitsets: shift both words as a single 128-bit integer
+			{
+				__extension__ typedef unsigned __int128 uint128_type;
+				const uint128_type value = (shift_amount < total_size) ? ((static_cast<uint128_type>(buffer[1]) << PLF_TYPE_BITWIDTH) | buffer[0]) >> shift_amount : 0;
+				buffer[0] = static_cast<storage_type>(value);
+				buffer[1] = static_cast<storage_type>(value >> PLF_TYPE_BITWIDTH);
+				return *this;
+			}
+		#endif
+
 		size_type end = PLF_ARRAY_CAPACITY - 1;
 
 		if (shift_amount >= PLF_TYPE_BITWIDTH)
@@ -980,7 +2448,7 @@ public:
 			}
 
 			#ifdef PLF_CONSTEVAL_SUPPORT
-				if consteval
+				PLF_IF_CONSTEVAL
 				{
 					std::fill_n(buffer + current, PLF_ARRAY_CAPACITY - current, 0);
 				}
@@ -1018,6 +2486,8 @@ public:
 	// >>= but only from a given index onwards
 	PLF_CONSTFUNC void shift_left_range (size_type shift_amount, const size_type first) PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(shift_operation, PLF_ARRAY_CAPACITY - (first / PLF_TYPE_BITWIDTH));
+
 		assert(first < total_size);
 
 		size_type end = PLF_ARRAY_CAPACITY - 1;
@@ -1058,7 +2528,7 @@ public:
 			}
 
 			#ifdef PLF_CONSTEVAL_SUPPORT
-				if consteval
+				PLF_IF_CONSTEVAL
 				{
 					std::fill_n(buffer + current, PLF_ARRAY_CAPACITY - current, 0);
 				}
@@ -1082,7 +2552,7 @@ public:
 
 		// Restore X bits to first word
 		const storage_type remainder = static_cast<storage_type>(first - (first_word_index * PLF_TYPE_BITWIDTH));
-  		buffer[first_word_index] = (buffer[first_word_index] & (std::numeric_limits<storage_type>::max() << remainder)) | (first_word & (std::numeric_limits<storage_type>::max() >> (PLF_TYPE_BITWIDTH - remainder)));
+  		buffer[first_word_index] = (buffer[first_word_index] & (std::numeric_limits<storage_type>::max() << remainder)) | (first_word & ~(std::numeric_limits<storage_type>::max() << remainder));
 	}
 
 
@@ -1090,6 +2560,8 @@ public:
 	// An optimization of the above for shifting by 1:
 	PLF_CONSTFUNC void shift_left_range_one (const size_type first) PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(shift_operation, PLF_ARRAY_CAPACITY - (first / PLF_TYPE_BITWIDTH));
+
 		assert(first < total_size);
 
 		const size_type end = PLF_ARRAY_CAPACITY - 1, first_word_index = first / PLF_TYPE_BITWIDTH;
@@ -1104,13 +2576,33 @@ public:
 
 		// Restore X bits to first word
 		const storage_type remainder = static_cast<storage_type>(first - (first_word_index * PLF_TYPE_BITWIDTH));
-  		buffer[first_word_index] = (buffer[first_word_index] & (std::numeric_limits<storage_type>::max() << remainder)) | (first_word & (std::numeric_limits<storage_type>::max() >> (PLF_TYPE_BITWIDTH - remainder)));
+  		buffer[first_word_index] = (buffer[first_word_index] & (std::numeric_limits<storage_type>::max() << remainder)) | (first_word & ~(std::numeric_limits<storage_type>::max() << remainder));
 	}
 
 
 
 	PLF_CONSTFUNC bitset & operator <<= (size_type shift_amount) PLF_NOEXCEPT
 	{
+		PLF_BITSET_TRACE(shift_operation, PLF_ARRAY_CAPACITY);
+
+		if PLF_CONSTEXPR (PLF_ARRAY_CAPACITY == 1)
+		{
+			buffer[0] = (shift_amount < total_size) ? static_cast<storage_type>(buffer[0] << shift_amount) : storage_type(0);
+			set_overflow_to_zero();
+			return *this;
+		}
+		#ifdef __SIZEOF_INT128__
+			else if PLF_CONSTEXPR (PLF_ARRAY_CAPACITY == 2 && PLF_TYPE_BITWIDTH <= 64)
+			{
+				__extension__ typedef unsigned __int128 uint128_type;
+				const uint128_type value = (shift_amount < total_size) ? ((static_cast<uint128_type>(buffer[1]) << PLF_TYPE_BITWIDTH) | buffer[0]) << shift_amount : 0;
+				buffer[0] = static_cast<storage_type>(value);
+				buffer[1] = static_cast<storage_type>(value >> PLF_TYPE_BITWIDTH);
+				set_overflow_to_zero();
+				return *this;
+			}
+		#endif
+
 		size_type current = PLF_ARRAY_CAPACITY;
 
 		if (shift_amount < total_size)
@@ -1141,7 +2633,7 @@ public:
 		}
 
 		#ifdef PLF_CONSTEVAL_SUPPORT
-			if consteval
+			PLF_IF_CONSTEVAL
 			{
 				std::fill_n(buffer, current, 0);
 			}
@@ -1258,7 +2750,7 @@ private:
 	template <typename number_type>
 	PLF_CONSTFUNC void check_bitset_representable() const
 	{
-		if (total_size > static_cast<size_type>(std::log10(static_cast<double>(std::numeric_limits<number_type>::max()))) + 1)
+		if (total_size > static_cast<size_type>(std::numeric_limits<number_type>::digits10) + 1) // ie. number of decimal digits in the maximum value, computed without std::log10 so that this can be constexpr
 		{
 			#ifdef PLF_EXCEPTIONS_SUPPORT
 				throw std::overflow_error("Bitset cannot be represented by this type due to the size of the bitset");
@@ -1332,10 +2824,26 @@ public:
 	#endif
 
 
+
+	// Writes the bitset to destination as a big-endian unsigned integer of (size() + 7) / 8 bytes, eg. for MSB-first network formats. Bit size() - 1 is the most significant bit, and any unused high bits of destination[0] are zero:
+	PLF_CONSTFUNC void to_big_endian_bytes(unsigned char * const destination) const PLF_NOEXCEPT
+	{
+		plf::big_endian_bytes_words(buffer, total_size, destination);
+	}
+
+
 	PLF_CONSTFUNC void swap(bitset &source) PLF_NOEXCEPT
 	{
 		for (size_type current = 0, end = PLF_ARRAY_CAPACITY; current != end; ++current) std::swap(buffer[current], source.buffer[current]);
 	}
+
+
+
+	// Fast 64-bit hash of the bitset's contents and size. Bits beyond size() never contribute. Bitsets of equal size and contents have the same fingerprint regardless of bitset type or storage_type:
+	PLF_CONSTFUNC unsigned long long fingerprint() const PLF_NOEXCEPT
+	{
+		return plf::hash_words(buffer, PLF_ARRAY_CAPACITY, static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> (PLF_ARRAY_CAPACITY_BITS - total_size)), total_size);
+	}
 };
 
 
@@ -1357,10 +2865,24 @@ namespace std
 	{
 		return os << bs.to_string();
 	}
+
+
+
+	#ifdef PLF_CPP11_SUPPORT
+		template<std::size_t total_size, typename storage_type, bool hardened>
+		struct hash<plf::bitset<total_size, storage_type, hardened> >
+		{
+			std::size_t operator () (const plf::bitset<total_size, storage_type, hardened> &bs) const PLF_NOEXCEPT
+			{
+				return static_cast<std::size_t>(bs.fingerprint());
+			}
+		};
+	#endif
 }
 
 
 #undef PLF_CONSTEVAL_SUPPORT
+#undef PLF_IF_CONSTEVAL
 #undef PLF_CPP11_SUPPORT
 #undef PLF_CPP20_SUPPORT
 #undef PLF_CONSTFUNC
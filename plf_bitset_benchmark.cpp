@@ -0,0 +1,631 @@
+// Per-operation microbenchmarks for plf::bitset, plf::bitsetb, std::bitset, std::vector<bool> and (if available) boost::dynamic_bitset.
+// Requires C++11. No external dependencies. Build with optimizations on, eg. g++ -std=c++20 -O2 -march=native plf_bitset_benchmark.cpp
+// Usage: plf_bitset_benchmark [quick] [large] [json] [out=filename]
+// "quick" uses fewer/shorter samples and only the smaller sizes, "large" adds 1G-bit bitsets (requires ~512MB of memory).
+// Output is CSV (or a JSON array if "json" is specified) on stdout or to the given file: container, storage type, size in bits, density, operation, ns/op, GB/s, relative standard deviation (%) across samples,
+// then per-operation hardware counter results (cycles, instructions, L1D read misses, last-level cache misses, branch misses). The counters are Linux-only (perf_event_open) and are left empty/null if unavailable, eg. due to /proc/sys/kernel/perf_event_paranoid > 2, or in containers/VMs without PMU access.
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <bitset>
+#include <string>
+#include <utility>
+#include "plf_bitset.h"
+#include "plf_bitsetb.h"
+
+#if defined(__linux__)
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#define PLF_BENCHMARK_PERF_EVENTS
+#endif
+
+#if defined(__has_include)
+	#if __has_include(<boost/dynamic_bitset.hpp>)
+		#include <boost/dynamic_bitset.hpp>
+		#define PLF_BENCHMARK_BOOST
+	#endif
+#endif
+
+
+
+namespace
+{
+	unsigned int number_of_samples = 9;
+	double minimum_sample_nanoseconds = 2000000;
+	unsigned long long random_state = 0x9E3779B97F4A7C15ull;
+	FILE *output = stdout;
+	bool json_output = false, first_row = true;
+
+
+	inline unsigned long long xorshift()
+	{
+		random_state ^= random_state << 13;
+		random_state ^= random_state >> 7;
+		random_state ^= random_state << 17;
+		return random_state;
+	}
+
+
+	// Prevents the compiler from optimizing away a result:
+	template <class value_type>
+	inline void do_not_optimize(const value_type &value)
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : "r,m"(value) : "memory");
+		#else
+			static volatile const void *sink;
+			sink = &value;
+		#endif
+	}
+
+
+	inline void clobber_memory()
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : : "memory");
+		#endif
+	}
+
+
+
+	// Hardware performance counters, opened as a single group so that all counters cover the same interval. User-space only, so that the measurement works under perf_event_paranoid == 2. Individual counters the CPU/kernel doesn't support are skipped:
+	class performance_counters
+	{
+	public:
+		enum { cycles, instructions, l1d_read_misses, llc_misses, branch_misses, number_of_counters };
+
+		performance_counters(): leader(-1), number_opened(0)
+		{
+			for (int counter = 0; counter != number_of_counters; ++counter) group_position[counter] = -1;
+
+			#ifdef PLF_BENCHMARK_PERF_EVENTS
+				const unsigned int types[number_of_counters] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE };
+				const unsigned long long configs[number_of_counters] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+				for (int counter = 0; counter != number_of_counters; ++counter)
+				{
+					perf_event_attr attributes;
+					std::memset(&attributes, 0, sizeof(attributes));
+					attributes.size = sizeof(attributes);
+					attributes.type = types[counter];
+					attributes.config = configs[counter];
+					attributes.disabled = (leader == -1) ? 1 : 0; // group is enabled/disabled via the leader
+					attributes.exclude_kernel = 1;
+					attributes.exclude_hv = 1;
+					attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+					const int descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0));
+					if (descriptor == -1) continue;
+
+					descriptors[number_opened] = descriptor;
+					group_position[counter] = number_opened++;
+					if (leader == -1) leader = descriptor;
+				}
+			#endif
+		}
+
+
+		~performance_counters()
+		{
+			#ifdef PLF_BENCHMARK_PERF_EVENTS
+				for (int counter = 0; counter != number_opened; ++counter) close(descriptors[counter]);
+			#endif
+		}
+
+
+		bool available() const
+		{
+			return leader != -1;
+		}
+
+
+		bool counter_available(const int counter) const
+		{
+			return group_position[counter] != -1;
+		}
+
+
+		void start()
+		{
+			#ifdef PLF_BENCHMARK_PERF_EVENTS
+				if (leader == -1) return;
+				ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+				ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			#endif
+		}
+
+
+		// Stops counting and writes each counter's total into totals, scaled up if the kernel had to multiplex the counters:
+		void stop(double (&totals)[number_of_counters])
+		{
+			for (int counter = 0; counter != number_of_counters; ++counter) totals[counter] = 0;
+
+			#ifdef PLF_BENCHMARK_PERF_EVENTS
+				if (leader == -1) return;
+				ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+				unsigned long long buffer[3 + number_of_counters]; // number of counters, time enabled, time running, values
+				if (read(leader, buffer, sizeof(buffer)) < static_cast<ssize_t>(sizeof(unsigned long long) * (3 + number_opened)) || buffer[2] == 0) return;
+
+				const double scale = static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]);
+
+				for (int counter = 0; counter != number_of_counters; ++counter)
+				{
+					if (group_position[counter] != -1) totals[counter] = static_cast<double>(buffer[3 + group_position[counter]]) * scale;
+				}
+			#endif
+		}
+
+	private:
+		int leader, number_opened, descriptors[number_of_counters], group_position[number_of_counters];
+	};
+
+
+	performance_counters *counters = NULL;
+
+
+
+	struct measurement
+	{
+		double nanoseconds_per_operation, gigabytes_per_second, relative_deviation, counters_per_operation[performance_counters::number_of_counters];
+	};
+
+
+	// Calls function repeatedly, doubling the number of calls per sample until a sample takes at least minimum_sample_nanoseconds, then takes number_of_samples samples:
+	template <class function_type>
+	measurement measure(function_type function, const double operations_per_call, const double bytes_per_call)
+	{
+		typedef std::chrono::steady_clock clock_type;
+		unsigned long long calls_per_sample = 1;
+
+		while (true)
+		{
+			const clock_type::time_point start = clock_type::now();
+			for (unsigned long long call = 0; call != calls_per_sample; ++call) function();
+			clobber_memory();
+			const double elapsed = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+
+			if (elapsed >= minimum_sample_nanoseconds || calls_per_sample >= (1ull << 40)) break;
+			calls_per_sample *= (elapsed * 8 < minimum_sample_nanoseconds) ? 8 : 2;
+		}
+
+		std::vector<double> samples(number_of_samples);
+		double mean = 0, variance = 0, counter_totals[performance_counters::number_of_counters];
+
+		counters->start();
+
+		for (unsigned int sample = 0; sample != number_of_samples; ++sample)
+		{
+			const clock_type::time_point start = clock_type::now();
+			for (unsigned long long call = 0; call != calls_per_sample; ++call) function();
+			clobber_memory();
+			samples[sample] = std::chrono::duration<double, std::nano>(clock_type::now() - start).count() / static_cast<double>(calls_per_sample);
+			mean += samples[sample];
+		}
+
+		counters->stop(counter_totals);
+		mean /= number_of_samples;
+
+		for (unsigned int sample = 0; sample != number_of_samples; ++sample) variance += (samples[sample] - mean) * (samples[sample] - mean);
+		variance /= number_of_samples;
+
+		measurement result;
+		result.nanoseconds_per_operation = mean / operations_per_call;
+		result.gigabytes_per_second = bytes_per_call / mean; // bytes per nanosecond == GB/s
+		result.relative_deviation = (mean != 0) ? (std::sqrt(variance) / mean) * 100 : 0;
+
+		for (int counter = 0; counter != performance_counters::number_of_counters; ++counter)
+		{
+			result.counters_per_operation[counter] = counter_totals[counter] / (static_cast<double>(calls_per_sample) * number_of_samples * operations_per_call);
+		}
+
+		return result;
+	}
+
+
+	const char * const counter_names[performance_counters::number_of_counters] = { "cycles_per_op", "instructions_per_op", "l1d_read_misses_per_op", "llc_misses_per_op", "branch_misses_per_op" };
+
+
+	void report_header()
+	{
+		if (json_output)
+		{
+			fprintf(output, "[\n");
+			return;
+		}
+
+		fprintf(output, "container,storage_type,size,density,operation,ns_per_op,gb_per_s,relative_deviation_percent");
+		for (int counter = 0; counter != performance_counters::number_of_counters; ++counter) fprintf(output, ",%s", counter_names[counter]);
+		fprintf(output, "\n");
+	}
+
+
+	void report(const char *container, const char *storage, const std::size_t size, const double density, const char *operation, const measurement &result)
+	{
+		if (json_output)
+		{
+			fprintf(output, "%s\t{\"container\": \"%s\", \"storage_type\": \"%s\", \"size\": %zu, \"density\": %g, \"operation\": \"%s\", \"ns_per_op\": %.3f, \"gb_per_s\": %.3f, \"relative_deviation_percent\": %.2f", first_row ? "" : ",\n", container, storage, size, density, operation, result.nanoseconds_per_operation, result.gigabytes_per_second, result.relative_deviation);
+
+			for (int counter = 0; counter != performance_counters::number_of_counters; ++counter)
+			{
+				if (counters->counter_available(counter)) fprintf(output, ", \"%s\": %.4f", counter_names[counter], result.counters_per_operation[counter]);
+				else fprintf(output, ", \"%s\": null", counter_names[counter]);
+			}
+
+			fprintf(output, "}");
+		}
+		else
+		{
+			fprintf(output, "%s,%s,%zu,%g,%s,%.3f,%.3f,%.2f", container, storage, size, density, operation, result.nanoseconds_per_operation, result.gigabytes_per_second, result.relative_deviation);
+
+			for (int counter = 0; counter != performance_counters::number_of_counters; ++counter)
+			{
+				if (counters->counter_available(counter)) fprintf(output, ",%.4f", result.counters_per_operation[counter]);
+				else fprintf(output, ",");
+			}
+
+			fprintf(output, "\n");
+		}
+
+		first_row = false;
+		fflush(output);
+	}
+
+
+	void report_footer()
+	{
+		if (json_output) fprintf(output, "\n]\n");
+	}
+
+
+
+	// Uniform bit-setting across container types:
+	template <class bitset_type>
+	inline void assign_bit(bitset_type &values, const std::size_t index, const bool value)
+	{
+		values.set(index, value);
+	}
+
+
+	inline void assign_bit(std::vector<bool> &values, const std::size_t index, const bool value)
+	{
+		values[index] = value;
+	}
+
+
+	template <class bitset_type>
+	void fill(bitset_type &values, const std::size_t size, const double density)
+	{
+		const unsigned long long threshold = static_cast<unsigned long long>(density * 18446744073709551615.0);
+		for (std::size_t index = 0; index != size; ++index) assign_bit(values, index, xorshift() < threshold);
+	}
+
+
+
+	// Random indexes and [begin, end) ranges shared by all containers of a given size:
+	struct workload
+	{
+		std::vector<std::size_t> indexes, shifts;
+		std::vector<std::pair<std::size_t, std::size_t> > ranges, sorted_ranges;
+		double average_range_bytes, sorted_range_bytes;
+
+		explicit workload(const std::size_t size): indexes(1024), shifts(64), ranges(64), average_range_bytes(0), sorted_range_bytes(0)
+		{
+			for (std::size_t &index : indexes) index = xorshift() % size;
+			for (std::size_t &shift : shifts) shift = (xorshift() % ((size < 512) ? size : 512));
+
+			for (std::pair<std::size_t, std::size_t> &range : ranges)
+			{
+				range.first = xorshift() % size;
+				range.second = range.first + (xorshift() % (size - range.first)) + 1;
+				if (range.second == size) --range.second; // hardened end-index checks treat size as out of range
+				if (range.second == range.first) range.first = 0;
+				average_range_bytes += static_cast<double>(range.second - range.first) / 8;
+			}
+
+			average_range_bytes /= static_cast<double>(ranges.size());
+
+			// Sorted, non-overlapping ranges for the multi-range functions:
+			std::vector<std::size_t> boundaries(128);
+			for (std::size_t &boundary : boundaries) boundary = xorshift() % size;
+			std::sort(boundaries.begin(), boundaries.end());
+			boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+			for (std::size_t index = 0; index + 1 < boundaries.size(); index += 2)
+			{
+				sorted_ranges.push_back(std::make_pair(boundaries[index], boundaries[index + 1]));
+				sorted_range_bytes += static_cast<double>(boundaries[index + 1] - boundaries[index]) / 8;
+			}
+		}
+	};
+
+
+
+	// Operations with the same interface in plf::bitset/bitsetb, std::bitset and boost::dynamic_bitset:
+	template <class bitset_type>
+	void benchmark_common(const char *container, const char *storage, const std::size_t size, const double density, bitset_type &values, bitset_type &values2, const workload &work)
+	{
+		const double bytes = static_cast<double>(size) / 8, indexes = static_cast<double>(work.indexes.size());
+		std::size_t shift_number = 0;
+
+		fill(values, size, density);
+		fill(values2, size, density);
+
+		report(container, storage, size, density, "set(index)", measure([&] { for (const std::size_t index : work.indexes) values.set(index); }, indexes, 0));
+		report(container, storage, size, density, "reset(index)", measure([&] { for (const std::size_t index : work.indexes) values.reset(index); }, indexes, 0));
+		report(container, storage, size, density, "flip(index)", measure([&] { for (const std::size_t index : work.indexes) values.flip(index); }, indexes, 0));
+		report(container, storage, size, density, "set(index, value)", measure([&] { for (const std::size_t index : work.indexes) values.set(index, (index & 1) != 0); }, indexes, 0));
+		fill(values, size, density);
+		report(container, storage, size, density, "operator[]", measure([&] { std::size_t total = 0; for (const std::size_t index : work.indexes) total += values[index]; do_not_optimize(total); }, indexes, 0));
+		report(container, storage, size, density, "test", measure([&] { std::size_t total = 0; for (const std::size_t index : work.indexes) total += values.test(index); do_not_optimize(total); }, indexes, 0));
+		report(container, storage, size, density, "count", measure([&] { do_not_optimize(values.count()); }, 1, bytes));
+		report(container, storage, size, density, "any", measure([&] { do_not_optimize(values.any()); }, 1, bytes));
+		report(container, storage, size, density, "none", measure([&] { do_not_optimize(values.none()); }, 1, bytes));
+		report(container, storage, size, density, "all", measure([&] { do_not_optimize(values.all()); }, 1, bytes));
+		report(container, storage, size, density, "operator ==", measure([&] { do_not_optimize(values == values2); }, 1, bytes * 2));
+		report(container, storage, size, density, "operator &=", measure([&] { values &= values2; }, 1, bytes * 3));
+		report(container, storage, size, density, "operator |=", measure([&] { values |= values2; }, 1, bytes * 3));
+		report(container, storage, size, density, "operator ^=", measure([&] { values ^= values2; }, 1, bytes * 3));
+		report(container, storage, size, density, "operator >>=", measure([&] { values >>= work.shifts[shift_number++ & 63]; }, 1, bytes * 2));
+		report(container, storage, size, density, "operator <<=", measure([&] { values <<= work.shifts[shift_number++ & 63]; }, 1, bytes * 2));
+		report(container, storage, size, density, "copy assignment", measure([&] { values = values2; clobber_memory(); }, 1, bytes * 2));
+		report(container, storage, size, density, "set()", measure([&] { values.set(); clobber_memory(); }, 1, bytes));
+		report(container, storage, size, density, "reset()", measure([&] { values.reset(); clobber_memory(); }, 1, bytes));
+		report(container, storage, size, density, "flip()", measure([&] { values.flip(); clobber_memory(); }, 1, bytes * 2));
+	}
+
+
+	template <class bitset_type>
+	void benchmark_to_string(const char *container, const char *storage, const std::size_t size, const double density, bitset_type &values)
+	{
+		if (size <= (1u << 24)) report(container, storage, size, density, "to_string", measure([&] { do_not_optimize(values.to_string().size()); }, 1, static_cast<double>(size) / 8));
+	}
+
+
+
+	// Functions specific to plf::bitset/bitsetb:
+	template <class bitset_type>
+	void benchmark_plf_specific(const char *container, const char *storage, const std::size_t size, const double density, bitset_type &values, bitset_type &values2, bitset_type &destination, const workload &work)
+	{
+		const double bytes = static_cast<double>(size) / 8, ranges = static_cast<double>(work.ranges.size()), range_bytes = work.average_range_bytes * ranges, sorted_ranges = static_cast<double>(work.sorted_ranges.size());
+		const double indexes = static_cast<double>(work.indexes.size());
+		std::size_t shift_number = 0;
+		std::vector<unsigned char> bytes_destination((size + 7) / 8);
+
+		fill(values, size, density);
+		fill(values2, size, density);
+
+		report(container, storage, size, density, "set_range", measure([&] { for (const std::pair<std::size_t, std::size_t> &range : work.ranges) values.set_range(range.first, range.second); }, ranges, range_bytes));
+		report(container, storage, size, density, "reset_range", measure([&] { for (const std::pair<std::size_t, std::size_t> &range : work.ranges) values.reset_range(range.first, range.second); }, ranges, range_bytes));
+		report(container, storage, size, density, "flip_range", measure([&] { for (const std::pair<std::size_t, std::size_t> &range : work.ranges) values.flip_range(range.first, range.second); }, ranges, range_bytes));
+		fill(values, size, density);
+		report(container, storage, size, density, "count_range", measure([&] { std::size_t total = 0; for (const std::pair<std::size_t, std::size_t> &range : work.ranges) total += values.count_range(range.first, range.second); do_not_optimize(total); }, ranges, range_bytes));
+		report(container, storage, size, density, "any_range", measure([&] { std::size_t total = 0; for (const std::pair<std::size_t, std::size_t> &range : work.ranges) total += values.any_range(range.first, range.second); do_not_optimize(total); }, ranges, range_bytes));
+		report(container, storage, size, density, "all_range", measure([&] { std::size_t total = 0; for (const std::pair<std::size_t, std::size_t> &range : work.ranges) total += values.all_range(range.first, range.second); do_not_optimize(total); }, ranges, range_bytes));
+		report(container, storage, size, density, "none_range", measure([&] { std::size_t total = 0; for (const std::pair<std::size_t, std::size_t> &range : work.ranges) total += values.none_range(range.first, range.second); do_not_optimize(total); }, ranges, range_bytes));
+		report(container, storage, size, density, "set_ranges", measure([&] { values.set_ranges(work.sorted_ranges.begin(), work.sorted_ranges.end()); clobber_memory(); }, sorted_ranges, work.sorted_range_bytes));
+		report(container, storage, size, density, "reset_ranges", measure([&] { values.reset_ranges(work.sorted_ranges.begin(), work.sorted_ranges.end()); clobber_memory(); }, sorted_ranges, work.sorted_range_bytes));
+		report(container, storage, size, density, "flip_ranges", measure([&] { values.flip_ranges(work.sorted_ranges.begin(), work.sorted_ranges.end()); clobber_memory(); }, sorted_ranges, work.sorted_range_bytes));
+		fill(values, size, density);
+		report(container, storage, size, density, "count_ranges", measure([&] { do_not_optimize(values.count_ranges(work.sorted_ranges.begin(), work.sorted_ranges.end())); }, sorted_ranges, work.sorted_range_bytes));
+		report(container, storage, size, density, "first_one", measure([&] { do_not_optimize(values.first_one()); }, 1, 0));
+		report(container, storage, size, density, "last_one", measure([&] { do_not_optimize(values.last_one()); }, 1, 0));
+		report(container, storage, size, density, "first_zero", measure([&] { do_not_optimize(values.first_zero()); }, 1, 0));
+		report(container, storage, size, density, "last_zero", measure([&] { do_not_optimize(values.last_zero()); }, 1, 0));
+
+		const double ones = static_cast<double>(values.count()) + 1;
+		report(container, storage, size, density, "next_one iteration", measure([&] { std::size_t total = 0; for (std::size_t index = values.first_one(); index != std::numeric_limits<std::size_t>::max(); index = values.next_one(index + 1)) total += index; do_not_optimize(total); }, ones, bytes));
+		// prev_one is exclusive in plf::bitset and inclusive in plf::bitsetb, so test the preceding bit first to work with either:
+		report(container, storage, size, density, "prev_one iteration", measure([&] { std::size_t total = 0; for (std::size_t index = values.last_one(); index != std::numeric_limits<std::size_t>::max() && index != 0; index = values.test(index - 1) ? index - 1 : values.prev_one(index - 1)) total += index; do_not_optimize(total); }, ones, bytes));
+		report(container, storage, size, density, "next_zero iteration", measure([&] { std::size_t total = 0; for (std::size_t index = values.first_zero(); index < size - 1; index = values.next_zero(index + 1)) total += index; do_not_optimize(total); }, static_cast<double>(size) - ones + 2, bytes));
+		report(container, storage, size, density, "prev_zero(index)", measure([&] { std::size_t total = 0; for (const std::size_t index : work.indexes) total += values.prev_zero(index); do_not_optimize(total); }, indexes, 0));
+		report(container, storage, size, density, "next_run iteration", measure([&] { std::size_t total = 0; for (std::pair<std::size_t, std::size_t> run = values.next_run(0); run.first != std::numeric_limits<std::size_t>::max(); run = values.next_run(run.second)) total += run.second - run.first; do_not_optimize(total); }, 1, bytes));
+		report(container, storage, size, density, "for_each_run", measure([&] { std::size_t total = 0; values.for_each_run([&](const std::size_t begin, const std::size_t end) { total += end - begin; }); do_not_optimize(total); }, 1, bytes));
+		report(container, storage, size, density, "find_one_run(8)", measure([&] { do_not_optimize(values.find_one_run(8)); }, 1, 0));
+		report(container, storage, size, density, "find_zero_run(8)", measure([&] { do_not_optimize(values.find_zero_run(8)); }, 1, 0));
+		report(container, storage, size, density, "operator <", measure([&] { do_not_optimize(values < values2); }, 1, bytes * 2));
+		report(container, storage, size, density, "fingerprint", measure([&] { do_not_optimize(values.fingerprint()); }, 1, bytes));
+		report(container, storage, size, density, "is_subset_of", measure([&] { do_not_optimize(values.is_subset_of(values2)); }, 1, bytes * 2));
+		report(container, storage, size, density, "is_superset_of", measure([&] { do_not_optimize(values.is_superset_of(values2)); }, 1, bytes * 2));
+		report(container, storage, size, density, "intersects", measure([&] { do_not_optimize(values.intersects(values2)); }, 1, bytes * 2));
+		report(container, storage, size, density, "is_disjoint", measure([&] { do_not_optimize(values.is_disjoint(values2)); }, 1, bytes * 2));
+		report(container, storage, size, density, "bitwise_and", measure([&] { plf::bitwise_and(destination, values, values2); clobber_memory(); }, 1, bytes * 3));
+		report(container, storage, size, density, "bitwise_or", measure([&] { plf::bitwise_or(destination, values, values2); clobber_memory(); }, 1, bytes * 3));
+		report(container, storage, size, density, "bitwise_xor", measure([&] { plf::bitwise_xor(destination, values, values2); clobber_memory(); }, 1, bytes * 3));
+		report(container, storage, size, density, "bitwise_andnot", measure([&] { plf::bitwise_andnot(destination, values, values2); clobber_memory(); }, 1, bytes * 3));
+		report(container, storage, size, density, "bitwise_ornot", measure([&] { plf::bitwise_ornot(destination, values, values2); clobber_memory(); }, 1, bytes * 3));
+		report(container, storage, size, density, "operator &", measure([&] { do_not_optimize((values & values2).data()); }, 1, bytes * 3));
+		report(container, storage, size, density, "operator |", measure([&] { do_not_optimize((values | values2).data()); }, 1, bytes * 3));
+		report(container, storage, size, density, "operator ^", measure([&] { do_not_optimize((values ^ values2).data()); }, 1, bytes * 3));
+		report(container, storage, size, density, "operator ~", measure([&] { do_not_optimize((~values).data()); }, 1, bytes * 2));
+		report(container, storage, size, density, "copy_bits", measure([&] { for (const std::pair<std::size_t, std::size_t> &range : work.ranges) plf::copy_bits(destination, range.first, values, size - range.second, range.second - range.first); clobber_memory(); }, ranges, range_bytes * 2));
+		report(container, storage, size, density, "move_bits", measure([&] { for (const std::pair<std::size_t, std::size_t> &range : work.ranges) plf::move_bits(destination, range.first, destination, size - range.second, range.second - range.first); clobber_memory(); }, ranges, range_bytes * 2));
+		if (size <= (1u << 24)) report(container, storage, size, density, "to_rstring", measure([&] { do_not_optimize(values.to_rstring().size()); }, 1, bytes));
+		report(container, storage, size, density, "to_big_endian_bytes", measure([&] { values.to_big_endian_bytes(&bytes_destination[0]); clobber_memory(); }, 1, bytes * 2));
+		report(container, storage, size, density, "reverse", measure([&] { values.reverse(); clobber_memory(); }, 1, bytes * 2));
+		report(container, storage, size, density, "reverse_range", measure([&] { for (const std::pair<std::size_t, std::size_t> &range : work.ranges) values.reverse_range(range.first, range.second); clobber_memory(); }, ranges, range_bytes * 2));
+		report(container, storage, size, density, "shift_left_range", measure([&] { const std::size_t first = work.indexes[shift_number & 1023]; values.shift_left_range(work.shifts[shift_number++ & 63], first); }, 1, bytes * 2));
+		report(container, storage, size, density, "shift_left_range_one", measure([&] { values.shift_left_range_one(work.indexes[shift_number++ & 1023]); }, 1, bytes * 2));
+		report(container, storage, size, density, "swap", measure([&] { values.swap(values2); clobber_memory(); }, 1, bytes * 4));
+	}
+
+
+
+	template <std::size_t size, typename storage_type>
+	void benchmark_plf_bitset(const char *storage, const double density, const workload &work)
+	{
+		typedef plf::bitset<size, storage_type> bitset_type;
+		std::vector<bitset_type> values(3); // heap-allocated, as large bitsets won't fit on the stack
+
+		benchmark_common("plf::bitset", storage, size, density, values[0], values[1], work);
+		benchmark_to_string("plf::bitset", storage, size, density, values[0]);
+		benchmark_plf_specific("plf::bitset", storage, size, density, values[0], values[1], values[2], work);
+
+		// Functions only plf::bitset has, and the mixed-type operators against a plf::bitsetb of the same size and storage_type:
+		const double bytes = static_cast<double>(size) / 8;
+		std::size_t shift_number = 0;
+		plf::bitsetb<false, storage_type> other(size);
+		fill(values[0], size, density);
+		fill(other, size, density);
+
+		report("plf::bitset", storage, size, density, "operator <<", measure([&] { do_not_optimize((values[0] << work.shifts[shift_number++ & 63]).data()); }, 1, bytes * 2));
+		report("plf::bitset", storage, size, density, "operator >>", measure([&] { do_not_optimize((values[0] >> work.shifts[shift_number++ & 63]).data()); }, 1, bytes * 2));
+		report("plf::bitset", storage, size, density, "as_view", measure([&] { do_not_optimize(values[0].as_view().count()); }, 1, bytes));
+		report("plf::bitset", storage, size, density, "operator &= (bitsetb)", measure([&] { values[0] &= other; }, 1, bytes * 3));
+		report("plf::bitset", storage, size, density, "operator |= (bitsetb)", measure([&] { values[0] |= other; }, 1, bytes * 3));
+		report("plf::bitset", storage, size, density, "operator ^= (bitsetb)", measure([&] { values[0] ^= other; }, 1, bytes * 3));
+		report("plf::bitset", storage, size, density, "operator & (bitsetb)", measure([&] { do_not_optimize((values[0] & other).data()); }, 1, bytes * 3));
+		report("plf::bitset", storage, size, density, "operator = (bitsetb)", measure([&] { values[0] = other; clobber_memory(); }, 1, bytes * 2));
+		report("plf::bitset", storage, size, density, "is_subset_of (bitsetb)", measure([&] { do_not_optimize(values[0].is_subset_of(other)); }, 1, bytes * 2));
+		report("plf::bitset", storage, size, density, "bitwise_and (bitsetb)", measure([&] { plf::bitwise_and(values[2], values[0], other); clobber_memory(); }, 1, bytes * 3));
+		report("plf::bitsetc", storage, size, density, "operator &= (bitset)", measure([&] { other &= values[1]; }, 1, bytes * 3));
+		report("plf::bitsetc", storage, size, density, "operator |= (bitset)", measure([&] { other |= values[1]; }, 1, bytes * 3));
+		report("plf::bitsetc", storage, size, density, "operator ^= (bitset)", measure([&] { other ^= values[1]; }, 1, bytes * 3));
+		report("plf::bitsetc", storage, size, density, "operator = (bitset)", measure([&] { other = values[1]; clobber_memory(); }, 1, bytes * 2));
+	}
+
+
+	template <typename storage_type>
+	void benchmark_plf_bitsetb(const std::size_t size, const char *storage, const double density, const workload &work)
+	{
+		plf::bitsetb<false, storage_type> values(size), values2(size), destination(size);
+
+		benchmark_common("plf::bitsetc", storage, size, density, values, values2, work);
+		benchmark_to_string("plf::bitsetc", storage, size, density, values);
+		benchmark_plf_specific("plf::bitsetc", storage, size, density, values, values2, destination, work);
+		report("plf::bitsetc", storage, size, density, "change_size", measure([&] { values.change_size(size / 2); values.change_size(size); }, 2, static_cast<double>(size) / 8));
+	}
+
+
+	template <std::size_t size>
+	void benchmark_std_bitset(const double density, const workload &work)
+	{
+		std::vector<std::bitset<size> > values(2);
+
+		benchmark_common("std::bitset", "-", size, density, values[0], values[1], work);
+		benchmark_to_string("std::bitset", "-", size, density, values[0]);
+	}
+
+
+	void benchmark_vector_bool(const std::size_t size, const double density, const workload &work)
+	{
+		std::vector<bool> values(size), values2(size);
+		const double bytes = static_cast<double>(size) / 8, indexes = static_cast<double>(work.indexes.size());
+
+		fill(values, size, density);
+		fill(values2, size, density);
+
+		// vector<bool> has no bitset interface, so only the equivalent basic operations are timed:
+		report("std::vector<bool>", "-", size, density, "set(index)", measure([&] { for (const std::size_t index : work.indexes) values[index] = true; }, indexes, 0));
+		report("std::vector<bool>", "-", size, density, "flip(index)", measure([&] { for (const std::size_t index : work.indexes) values[index].flip(); }, indexes, 0));
+		report("std::vector<bool>", "-", size, density, "operator[]", measure([&] { std::size_t total = 0; for (const std::size_t index : work.indexes) total += values[index]; do_not_optimize(total); }, indexes, 0));
+		report("std::vector<bool>", "-", size, density, "count", measure([&] { do_not_optimize(std::count(values.begin(), values.end(), true)); }, 1, bytes));
+		report("std::vector<bool>", "-", size, density, "operator ==", measure([&] { do_not_optimize(values == values2); }, 1, bytes * 2));
+		report("std::vector<bool>", "-", size, density, "copy assignment", measure([&] { values = values2; clobber_memory(); }, 1, bytes * 2));
+		report("std::vector<bool>", "-", size, density, "set()", measure([&] { std::fill(values.begin(), values.end(), true); clobber_memory(); }, 1, bytes));
+		report("std::vector<bool>", "-", size, density, "flip()", measure([&] { values.flip(); clobber_memory(); }, 1, bytes * 2));
+	}
+
+
+	#ifdef PLF_BENCHMARK_BOOST
+		void benchmark_boost_dynamic_bitset(const std::size_t size, const double density, const workload &work)
+		{
+			boost::dynamic_bitset<> values(size), values2(size);
+
+			benchmark_common("boost::dynamic_bitset", "-", size, density, values, values2, work);
+
+			fill(values, size, density);
+			const double ones = static_cast<double>(values.count()) + 1;
+			report("boost::dynamic_bitset", "-", size, density, "next_one iteration", measure([&] { std::size_t total = 0; for (std::size_t index = values.find_first(); index != boost::dynamic_bitset<>::npos; index = values.find_next(index)) total += index; do_not_optimize(total); }, ones, static_cast<double>(size) / 8));
+			report("boost::dynamic_bitset", "-", size, density, "operator <", measure([&] { do_not_optimize(values < values2); }, 1, static_cast<double>(size) / 4));
+			report("boost::dynamic_bitset", "-", size, density, "is_subset_of", measure([&] { do_not_optimize(values.is_subset_of(values2)); }, 1, static_cast<double>(size) / 4));
+			report("boost::dynamic_bitset", "-", size, density, "intersects", measure([&] { do_not_optimize(values.intersects(values2)); }, 1, static_cast<double>(size) / 4));
+		}
+	#endif
+
+
+
+	template <std::size_t size>
+	void benchmark_size()
+	{
+		const double densities[3] = { 0.5, 1.0 / 64, 63.0 / 64 };
+		const workload work(size);
+
+		for (const double density : densities)
+		{
+			benchmark_plf_bitset<size, unsigned char>("unsigned char", density, work);
+			benchmark_plf_bitset<size, unsigned int>("unsigned int", density, work);
+			benchmark_plf_bitset<size, unsigned long long>("unsigned long long", density, work);
+			benchmark_plf_bitsetb<unsigned char>(size, "unsigned char", density, work);
+			benchmark_plf_bitsetb<unsigned int>(size, "unsigned int", density, work);
+			benchmark_plf_bitsetb<unsigned long long>(size, "unsigned long long", density, work);
+			benchmark_std_bitset<size>(density, work);
+			benchmark_vector_bool(size, density, work);
+
+			#ifdef PLF_BENCHMARK_BOOST
+				benchmark_boost_dynamic_bitset(size, density, work);
+			#endif
+		}
+	}
+}
+
+
+
+int main(int argc, char **argv)
+{
+	bool quick = false, large = false;
+
+	for (int argument = 1; argument != argc; ++argument)
+	{
+		if (std::strcmp(argv[argument], "quick") == 0) quick = true;
+		else if (std::strcmp(argv[argument], "large") == 0) large = true;
+		else if (std::strcmp(argv[argument], "json") == 0) json_output = true;
+		else if (std::strncmp(argv[argument], "out=", 4) == 0)
+		{
+			if ((output = fopen(argv[argument] + 4, "w")) == NULL)
+			{
+				fprintf(stderr, "Could not open output file %s\n", argv[argument] + 4);
+				return 1;
+			}
+		}
+		else
+		{
+			fprintf(stderr, "Unknown argument: %s\nUsage: %s [quick] [large] [json] [out=filename]\n", argv[argument], argv[0]);
+			return 1;
+		}
+	}
+
+	performance_counters hardware_counters;
+	counters = &hardware_counters;
+
+	if (!hardware_counters.available()) fprintf(stderr, "Hardware performance counters unavailable, counter results will be empty.\n");
+
+	if (quick)
+	{
+		number_of_samples = 3;
+		minimum_sample_nanoseconds = 200000;
+	}
+
+	report_header();
+
+	benchmark_size<64>();
+	benchmark_size<4096>();
+
+	if (!quick)
+	{
+		benchmark_size<1048576>();
+		benchmark_size<67108864>();
+	}
+
+	if (large) benchmark_size<1073741824>();
+
+	report_footer();
+	if (output != stdout) fclose(output);
+	return 0;
+}
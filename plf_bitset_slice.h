@@ -0,0 +1,753 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_BITSET_SLICE_H
+#define PLF_BITSET_SLICE_H
+
+
+#include "plf_bitsetb.h" // plf::popcount, plf::count_trailing_ones, plf::count_leading_ones
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+#define PLF_CONSTEXPR
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#elif defined(__clang__)
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#else // Assume support for other compilers
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+#endif
+
+
+#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
+
+
+#include <cstddef> // std::size_t
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <limits>  // std::numeric_limits
+#include <functional> // std::less
+
+
+
+namespace plf
+{
+
+
+// A view of the bits [offset, offset + length) of a buffer of storage_type, eg. of a plf::bitset or plf::bitsetb via their slice() member functions, so that one partition of a large bitset can be searched, counted, shifted and combined with other bitsets in place, without copying. offset need not be a multiple of the storage_type width - bits outside the slice, including those sharing its first and last storage_types, are never modified.
+// Range operations and searches work on the underlying storage_types directly, with the edge storage_types masked. Bitwise operations, comparisons and shifts work on word(), ie. storage_type-sized groups of the slice's bits realigned to start at the slice's index 0, which costs one extra shift and OR per storage_type when offset is unaligned.
+// Like plf::bitsetb<true>, a slice does not own its buffer and must not outlive it. Copying a slice gives another view of the same bits. The source of a bitwise operation or assignment may overlap the slice, eg. another slice of the same bitset:
+template <typename storage_type = std::size_t, bool hardened = false>
+class bitset_slice
+{
+public:
+	typedef std::size_t size_type;
+
+private:
+	template <typename other_storage_type, bool other_hardened> friend class bitset_slice;
+
+	storage_type *words;
+	size_type first_bit, total_size;
+
+
+
+	void check_index_is_within_size(const size_type index) const
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			if (index >= total_size)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Index larger than size of slice");
+				#else
+					std::terminate();
+				#endif
+			}
+		}
+	}
+
+
+
+	void check_range_is_within_size(const size_type begin, const size_type end) const
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			if (begin > end || end > total_size)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Range is not within slice");
+				#else
+					std::terminate();
+				#endif
+			}
+		}
+	}
+
+
+
+	void check_source_size(const size_type source_size) const
+	{
+		if (source_size < total_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Source smaller than *this, cannot interprocess.");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	size_type number_of_words() const PLF_NOEXCEPT
+	{
+		return (total_size + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH;
+	}
+
+
+
+	// The bits of word() index word_index which are within the slice:
+	storage_type word_mask(const size_type word_index) const PLF_NOEXCEPT
+	{
+		return (word_index != number_of_words() - 1 || total_size % PLF_TYPE_BITWIDTH == 0) ? std::numeric_limits<storage_type>::max() : static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> (PLF_TYPE_BITWIDTH - (total_size % PLF_TYPE_BITWIDTH)));
+	}
+
+
+
+	// word(), with bits beyond size() zeroed, and 0 for word_indexes past the end (eg. the source words shifted in by operator >>=):
+	storage_type masked_word(const size_type word_index) const PLF_NOEXCEPT
+	{
+		return (word_index < number_of_words()) ? static_cast<storage_type>(word(word_index) & word_mask(word_index)) : storage_type(0);
+	}
+
+
+
+	// Overwrites the bits of word() index word_index selected by mask with those from value:
+	void write_word(const size_type word_index, const storage_type value, const storage_type mask) PLF_NOEXCEPT
+	{
+		const size_type bit = first_bit + (word_index * PLF_TYPE_BITWIDTH), index = bit / PLF_TYPE_BITWIDTH, shift = bit % PLF_TYPE_BITWIDTH;
+
+		words[index] = static_cast<storage_type>((words[index] & ~static_cast<storage_type>(mask << shift)) | static_cast<storage_type>((value & mask) << shift));
+
+		if (shift != 0)
+		{
+			const storage_type high_mask = static_cast<storage_type>(mask >> (PLF_TYPE_BITWIDTH - shift));
+			if (high_mask != 0) words[index + 1] = static_cast<storage_type>((words[index + 1] & ~high_mask) | ((value & mask) >> (PLF_TYPE_BITWIDTH - shift)));
+		}
+	}
+
+
+
+	// Applies operation_type to the underlying bits [begin, end) with a mask of those bits, ie. plf::or_operation sets, plf::andnot_operation resets and plf::xor_operation flips them:
+	template <class operation_type>
+	void modify_bits(const size_type begin, const size_type end) PLF_NOEXCEPT
+	{
+		if (begin == end) return;
+
+		const size_type first = begin / PLF_TYPE_BITWIDTH, last = (end - 1) / PLF_TYPE_BITWIDTH;
+
+		for (size_type current = first; current <= last; ++current)
+		{
+			storage_type mask = std::numeric_limits<storage_type>::max();
+			if (current == first) mask = static_cast<storage_type>(mask << (begin % PLF_TYPE_BITWIDTH));
+			if (current == last) mask &= static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> ((PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH)));
+
+			words[current] = operation_type::apply(words[current], mask);
+		}
+	}
+
+
+
+	size_type count_bits(const size_type begin, const size_type end) const PLF_NOEXCEPT
+	{
+		if (begin == end) return 0;
+
+		const size_type first = begin / PLF_TYPE_BITWIDTH, last = (end - 1) / PLF_TYPE_BITWIDTH;
+		const storage_type first_mask = static_cast<storage_type>(std::numeric_limits<storage_type>::max() << (begin % PLF_TYPE_BITWIDTH)), last_mask = static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> ((PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH)));
+
+		if (first == last) return plf::popcount(static_cast<storage_type>(words[first] & first_mask & last_mask));
+
+		size_type total = plf::popcount(static_cast<storage_type>(words[first] & first_mask)) + plf::popcount(static_cast<storage_type>(words[last] & last_mask));
+		for (size_type current = first + 1; current != last; ++current) total += plf::popcount(words[current]);
+		return total;
+	}
+
+
+
+	// First underlying bit in [from, end) which is set (or unset, if invert is all ones), as a slice index, or std::numeric_limits<size_type>::max():
+	size_type search_forwards(const size_type from, const size_type end, const storage_type invert) const PLF_NOEXCEPT
+	{
+		if (from >= end) return std::numeric_limits<size_type>::max();
+
+		size_type word_index = from / PLF_TYPE_BITWIDTH;
+		const size_type last = (end - 1) / PLF_TYPE_BITWIDTH;
+		storage_type value = static_cast<storage_type>((words[word_index] ^ invert) & (std::numeric_limits<storage_type>::max() << (from % PLF_TYPE_BITWIDTH)));
+
+		while (true)
+		{
+			if (word_index == last) value &= static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> ((PLF_TYPE_BITWIDTH - 1) - ((end - 1) % PLF_TYPE_BITWIDTH)));
+			if (value != 0) return (word_index * PLF_TYPE_BITWIDTH) + plf::count_trailing_ones(static_cast<storage_type>(~value)) - first_bit;
+			if (word_index == last) return std::numeric_limits<size_type>::max();
+			value = static_cast<storage_type>(words[++word_index] ^ invert);
+		}
+	}
+
+
+
+	// Last underlying bit in [begin, from] which is set (or unset), as a slice index, or std::numeric_limits<size_type>::max():
+	size_type search_backwards(const size_type from, const size_type begin, const storage_type invert) const PLF_NOEXCEPT
+	{
+		size_type word_index = from / PLF_TYPE_BITWIDTH;
+		const size_type first = begin / PLF_TYPE_BITWIDTH;
+		storage_type value = static_cast<storage_type>((words[word_index] ^ invert) & (std::numeric_limits<storage_type>::max() >> ((PLF_TYPE_BITWIDTH - 1) - (from % PLF_TYPE_BITWIDTH))));
+
+		while (true)
+		{
+			if (word_index == first) value &= static_cast<storage_type>(std::numeric_limits<storage_type>::max() << (begin % PLF_TYPE_BITWIDTH));
+			if (value != 0) return (word_index * PLF_TYPE_BITWIDTH) + (PLF_TYPE_BITWIDTH - 1) - plf::count_leading_ones(static_cast<storage_type>(~value)) - first_bit;
+			if (word_index == first) return std::numeric_limits<size_type>::max();
+			value = static_cast<storage_type>(words[--word_index] ^ invert);
+		}
+	}
+
+
+
+	template <class bitset_type>
+	static storage_type source_word(const bitset_type &source, const size_type word_index) PLF_NOEXCEPT
+	{
+		return source.data()[word_index];
+	}
+
+
+
+	template <bool source_hardened>
+	static storage_type source_word(const bitset_slice<storage_type, source_hardened> &source, const size_type word_index) PLF_NOEXCEPT
+	{
+		return source.word(word_index);
+	}
+
+
+
+	// The underlying storage_type containing the source's first bit, and that bit's position within it:
+	template <class bitset_type>
+	static const storage_type * source_start(const bitset_type &source, size_type &source_shift) PLF_NOEXCEPT
+	{
+		source_shift = 0;
+		return source.data();
+	}
+
+
+
+	template <bool source_hardened>
+	static const storage_type * source_start(const bitset_slice<storage_type, source_hardened> &source, size_type &source_shift) PLF_NOEXCEPT
+	{
+		source_shift = source.first_bit % PLF_TYPE_BITWIDTH;
+		return source.words + (source.first_bit / PLF_TYPE_BITWIDTH);
+	}
+
+
+
+	// As per plf::move_bits - word()s must be combined from the highest down if the slice starts within the source's bits in memory, otherwise they would be overwritten before being read:
+	template <class bitset_type>
+	bool source_overlaps_below(const bitset_type &source) const PLF_NOEXCEPT
+	{
+		size_type source_shift;
+		const storage_type * const source_begin = source_start(source, source_shift), * const source_end = source_begin + ((source_shift + total_size + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH), * const destination_begin = words + (first_bit / PLF_TYPE_BITWIDTH);
+
+		return (std::less<const storage_type *>()(source_begin, destination_begin) && std::less<const storage_type *>()(destination_begin, source_end)) || (source_begin == destination_begin && source_shift < first_bit % PLF_TYPE_BITWIDTH);
+	}
+
+
+
+	// Combines word() index word_index, which must be entirely within the slice and straddle two underlying storage_types, with value:
+	template <class operation_type>
+	void combine_unaligned_word(const size_type word_index, const storage_type source_value, const size_type shift, const storage_type low_mask) PLF_NOEXCEPT
+	{
+		storage_type * const location = words + (first_bit / PLF_TYPE_BITWIDTH) + word_index;
+		const storage_type current = static_cast<storage_type>((location[0] >> shift) | (location[1] << (PLF_TYPE_BITWIDTH - shift))), value = operation_type::apply(current, source_value);
+
+		location[0] = static_cast<storage_type>((location[0] & low_mask) | (value << shift));
+		location[1] = static_cast<storage_type>((location[1] & ~low_mask) | (value >> (PLF_TYPE_BITWIDTH - shift)));
+	}
+
+
+
+	// *this = *this OP source, one word() at a time. Every word but the last is entirely within the slice, so needs no masking - if the slice is aligned those are combined in place, otherwise each straddles two underlying storage_types and is split between them:
+	template <class operation_type, class bitset_type>
+	void combine(const bitset_type &source)
+	{
+		check_source_size(source.size());
+		if (total_size == 0) return;
+
+		const size_type last_word = number_of_words() - 1, base = first_bit / PLF_TYPE_BITWIDTH, shift = first_bit % PLF_TYPE_BITWIDTH;
+		const storage_type low_mask = static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> ((PLF_TYPE_BITWIDTH - shift) % PLF_TYPE_BITWIDTH)); // the bits of an underlying storage_type belonging to the previous word(), if unaligned
+
+		if (source_overlaps_below(source))
+		{
+			write_word(last_word, operation_type::apply(word(last_word), source_word(source, last_word)), word_mask(last_word));
+
+			if (shift == 0)
+			{
+				for (size_type word_index = last_word; word_index != 0;)
+				{
+					--word_index;
+					words[base + word_index] = operation_type::apply(words[base + word_index], source_word(source, word_index));
+				}
+			}
+			else
+			{
+				for (size_type word_index = last_word; word_index != 0;)
+				{
+					--word_index;
+					combine_unaligned_word<operation_type>(word_index, source_word(source, word_index), shift, low_mask);
+				}
+			}
+
+			return;
+		}
+
+		if (shift == 0)
+		{
+			for (size_type word_index = 0; word_index != last_word; ++word_index) words[base + word_index] = operation_type::apply(words[base + word_index], source_word(source, word_index));
+		}
+		else
+		{
+			for (size_type word_index = 0; word_index != last_word; ++word_index) combine_unaligned_word<operation_type>(word_index, source_word(source, word_index), shift, low_mask);
+		}
+
+		write_word(last_word, operation_type::apply(word(last_word), source_word(source, last_word)), word_mask(last_word));
+	}
+
+
+
+public:
+
+	bitset_slice(storage_type * const buffer, const size_type offset, const size_type length) PLF_NOEXCEPT:
+		words(buffer),
+		first_bit(offset),
+		total_size(length)
+	{}
+
+
+
+	// The storage_type-sized group of bits starting at slice index word_index * the storage_type width, as if the slice were word-aligned. Bits beyond size() in the final word are those which follow the slice in the underlying buffer:
+	storage_type word(const size_type word_index) const PLF_NOEXCEPT
+	{
+		const size_type bit = first_bit + (word_index * PLF_TYPE_BITWIDTH), index = bit / PLF_TYPE_BITWIDTH, shift = bit % PLF_TYPE_BITWIDTH;
+		storage_type value = static_cast<storage_type>(words[index] >> shift);
+
+		if (shift != 0 && index + 1 <= (first_bit + total_size - 1) / PLF_TYPE_BITWIDTH) value |= static_cast<storage_type>(words[index + 1] << (PLF_TYPE_BITWIDTH - shift));
+		return value;
+	}
+
+
+
+	bool operator [] (const size_type index) const
+	{
+		if PLF_CONSTEXPR (hardened) check_index_is_within_size(index);
+		return static_cast<bool>((words[(first_bit + index) / PLF_TYPE_BITWIDTH] >> ((first_bit + index) % PLF_TYPE_BITWIDTH)) & storage_type(1));
+	}
+
+
+
+	bool test(const size_type index) const
+	{
+		check_index_is_within_size(index);
+		return operator [](index);
+	}
+
+
+
+	void set(const size_type index)
+	{
+		if PLF_CONSTEXPR (hardened) check_index_is_within_size(index);
+		words[(first_bit + index) / PLF_TYPE_BITWIDTH] |= static_cast<storage_type>(storage_type(1) << ((first_bit + index) % PLF_TYPE_BITWIDTH));
+	}
+
+
+
+	void set(const size_type index, const bool value)
+	{
+		if (value) set(index);
+		else reset(index);
+	}
+
+
+
+	void reset(const size_type index)
+	{
+		if PLF_CONSTEXPR (hardened) check_index_is_within_size(index);
+		words[(first_bit + index) / PLF_TYPE_BITWIDTH] &= static_cast<storage_type>(~(storage_type(1) << ((first_bit + index) % PLF_TYPE_BITWIDTH)));
+	}
+
+
+
+	void flip(const size_type index)
+	{
+		if PLF_CONSTEXPR (hardened) check_index_is_within_size(index);
+		words[(first_bit + index) / PLF_TYPE_BITWIDTH] ^= static_cast<storage_type>(storage_type(1) << ((first_bit + index) % PLF_TYPE_BITWIDTH));
+	}
+
+
+
+	void set() PLF_NOEXCEPT
+	{
+		modify_bits<plf::or_operation>(first_bit, first_bit + total_size);
+	}
+
+
+
+	void reset() PLF_NOEXCEPT
+	{
+		modify_bits<plf::andnot_operation>(first_bit, first_bit + total_size);
+	}
+
+
+
+	void flip() PLF_NOEXCEPT
+	{
+		modify_bits<plf::xor_operation>(first_bit, first_bit + total_size);
+	}
+
+
+
+	void set_range(const size_type begin, const size_type end)
+	{
+		check_range_is_within_size(begin, end);
+		modify_bits<plf::or_operation>(first_bit + begin, first_bit + end);
+	}
+
+
+
+	void reset_range(const size_type begin, const size_type end)
+	{
+		check_range_is_within_size(begin, end);
+		modify_bits<plf::andnot_operation>(first_bit + begin, first_bit + end);
+	}
+
+
+
+	void flip_range(const size_type begin, const size_type end)
+	{
+		check_range_is_within_size(begin, end);
+		modify_bits<plf::xor_operation>(first_bit + begin, first_bit + end);
+	}
+
+
+
+	size_type count() const PLF_NOEXCEPT
+	{
+		return count_bits(first_bit, first_bit + total_size);
+	}
+
+
+
+	size_type count_range(const size_type begin, const size_type end) const
+	{
+		check_range_is_within_size(begin, end);
+		return count_bits(first_bit + begin, first_bit + end);
+	}
+
+
+
+	bool any() const PLF_NOEXCEPT
+	{
+		return search_forwards(first_bit, first_bit + total_size, storage_type(0)) != std::numeric_limits<size_type>::max();
+	}
+
+
+
+	bool any_range(const size_type begin, const size_type end) const
+	{
+		check_range_is_within_size(begin, end);
+		return search_forwards(first_bit + begin, first_bit + end, storage_type(0)) != std::numeric_limits<size_type>::max();
+	}
+
+
+
+	bool none() const PLF_NOEXCEPT
+	{
+		return !any();
+	}
+
+
+
+	bool none_range(const size_type begin, const size_type end) const
+	{
+		return !any_range(begin, end);
+	}
+
+
+
+	bool all() const PLF_NOEXCEPT
+	{
+		return search_forwards(first_bit, first_bit + total_size, std::numeric_limits<storage_type>::max()) == std::numeric_limits<size_type>::max();
+	}
+
+
+
+	bool all_range(const size_type begin, const size_type end) const
+	{
+		check_range_is_within_size(begin, end);
+		return search_forwards(first_bit + begin, first_bit + end, std::numeric_limits<storage_type>::max()) == std::numeric_limits<size_type>::max();
+	}
+
+
+
+	// The searches below return std::numeric_limits<size_type>::max() if no bit is found, and next_/prev_ searches include index itself, as per plf::bitset:
+	size_type first_one() const PLF_NOEXCEPT
+	{
+		return search_forwards(first_bit, first_bit + total_size, storage_type(0));
+	}
+
+
+
+	size_type next_one(const size_type index) const PLF_NOEXCEPT
+	{
+		return search_forwards(first_bit + index, first_bit + total_size, storage_type(0));
+	}
+
+
+
+	size_type last_one() const PLF_NOEXCEPT
+	{
+		return (total_size == 0) ? std::numeric_limits<size_type>::max() : search_backwards(first_bit + total_size - 1, first_bit, storage_type(0));
+	}
+
+
+
+	size_type prev_one(const size_type index) const PLF_NOEXCEPT
+	{
+		return (index >= total_size) ? std::numeric_limits<size_type>::max() : search_backwards(first_bit + index, first_bit, storage_type(0));
+	}
+
+
+
+	size_type first_zero() const PLF_NOEXCEPT
+	{
+		return search_forwards(first_bit, first_bit + total_size, std::numeric_limits<storage_type>::max());
+	}
+
+
+
+	size_type next_zero(const size_type index) const PLF_NOEXCEPT
+	{
+		return search_forwards(first_bit + index, first_bit + total_size, std::numeric_limits<storage_type>::max());
+	}
+
+
+
+	size_type last_zero() const PLF_NOEXCEPT
+	{
+		return (total_size == 0) ? std::numeric_limits<size_type>::max() : search_backwards(first_bit + total_size - 1, first_bit, std::numeric_limits<storage_type>::max());
+	}
+
+
+
+	size_type prev_zero(const size_type index) const PLF_NOEXCEPT
+	{
+		return (index >= total_size) ? std::numeric_limits<size_type>::max() : search_backwards(first_bit + index, first_bit, std::numeric_limits<storage_type>::max());
+	}
+
+
+
+	// The bitwise operators and assignment accept any plf bitset type or slice with the same storage_type and a size >= size(), as per plf::bitsetb. Only the first size() bits of the source are used:
+	template <class bitset_type>
+	bitset_slice & operator &= (const bitset_type &source)
+	{
+		combine<plf::and_operation>(source);
+		return *this;
+	}
+
+
+
+	template <class bitset_type>
+	bitset_slice & operator |= (const bitset_type &source)
+	{
+		combine<plf::or_operation>(source);
+		return *this;
+	}
+
+
+
+	template <class bitset_type>
+	bitset_slice & operator ^= (const bitset_type &source)
+	{
+		combine<plf::xor_operation>(source);
+		return *this;
+	}
+
+
+
+	// Copies the source's bits into the slice (rather than making *this a view of source):
+	template <class bitset_type>
+	bitset_slice & operator = (const bitset_type &source)
+	{
+		combine<plf::assign_operation>(source);
+		return *this;
+	}
+
+
+
+	bitset_slice & operator = (const bitset_slice &source)
+	{
+		combine<plf::assign_operation>(source);
+		return *this;
+	}
+
+
+
+	template <class bitset_type>
+	bool operator == (const bitset_type &source) const PLF_NOEXCEPT
+	{
+		if (source.size() != total_size) return false;
+
+		for (size_type word_index = 0, end = number_of_words(); word_index != end; ++word_index)
+		{
+			if (((word(word_index) ^ source_word(source, word_index)) & word_mask(word_index)) != 0) return false;
+		}
+
+		return true;
+	}
+
+
+
+	template <class bitset_type>
+	bool operator != (const bitset_type &source) const PLF_NOEXCEPT
+	{
+		return !(*this == source);
+	}
+
+
+
+	// Shifts towards lower indexes, as per plf::bitset. Bits shifted out of the slice are discarded, and bits outside the slice are unaffected:
+	bitset_slice & operator >>= (const size_type shift_amount) PLF_NOEXCEPT
+	{
+		if (shift_amount >= total_size)
+		{
+			reset();
+			return *this;
+		}
+
+		const size_type word_shift = shift_amount / PLF_TYPE_BITWIDTH, bit_shift = shift_amount % PLF_TYPE_BITWIDTH;
+
+		for (size_type word_index = 0, end = number_of_words(); word_index != end; ++word_index) // ascending, as each new word only reads words at or above its own index
+		{
+			storage_type value = static_cast<storage_type>(masked_word(word_index + word_shift) >> bit_shift);
+			if (bit_shift != 0) value |= static_cast<storage_type>(masked_word(word_index + word_shift + 1) << (PLF_TYPE_BITWIDTH - bit_shift));
+			write_word(word_index, value, word_mask(word_index));
+		}
+
+		return *this;
+	}
+
+
+
+	// Shifts towards higher indexes:
+	bitset_slice & operator <<= (const size_type shift_amount) PLF_NOEXCEPT
+	{
+		if (shift_amount >= total_size)
+		{
+			reset();
+			return *this;
+		}
+
+		const size_type word_shift = shift_amount / PLF_TYPE_BITWIDTH, bit_shift = shift_amount % PLF_TYPE_BITWIDTH;
+
+		for (size_type word_index = number_of_words(); word_index-- != 0;) // descending, as each new word only reads words at or below its own index
+		{
+			storage_type value = (word_index >= word_shift) ? static_cast<storage_type>(masked_word(word_index - word_shift) << bit_shift) : storage_type(0);
+			if (bit_shift != 0 && word_index > word_shift) value |= static_cast<storage_type>(masked_word(word_index - word_shift - 1) >> (PLF_TYPE_BITWIDTH - bit_shift));
+			write_word(word_index, value, word_mask(word_index));
+		}
+
+		return *this;
+	}
+
+
+
+	// A slice of this slice, eg. for recursively partitioning work:
+	bitset_slice slice(const size_type offset, const size_type length) const
+	{
+		check_range_is_within_size(offset, offset + length);
+		return bitset_slice(words, first_bit + offset, length);
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	// The slice's position in the underlying buffer. There is deliberately no data() member, as the buffer is not aligned to the slice's start, so functions expecting a plf bitset's data() would misread it - word() should be used instead:
+	size_type offset() const PLF_NOEXCEPT
+	{
+		return first_bit;
+	}
+};
+
+
+} // plf namespace
+
+
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+#undef PLF_CONSTEXPR
+
+#undef PLF_TYPE_BITWIDTH
+
+#endif // PLF_BITSET_SLICE_H
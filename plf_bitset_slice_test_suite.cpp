@@ -0,0 +1,408 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "plf_bitset.h"
+#include "plf_bitset_slice.h"
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+// Checks the slice's read API against the model of the slice's bits, and the whole underlying bitset (including the bits outside the slice) against the model of the whole buffer:
+template <class slice_type, class bitset_type>
+bool matches(const slice_type &slice, const bitset_type &underlying, const std::vector<bool> &model)
+{
+	const std::size_t offset = slice.offset(), length = slice.size(), none_found = std::numeric_limits<std::size_t>::max();
+
+	for (std::size_t index = 0; index != model.size(); ++index)
+	{
+		if (underlying[index] != model[index]) return false;
+	}
+
+	std::size_t total = 0, first_one = none_found, last_one = none_found, first_zero = none_found, last_zero = none_found;
+
+	for (std::size_t index = 0; index != length; ++index)
+	{
+		if (slice[index] != model[offset + index]) return false;
+
+		if (model[offset + index])
+		{
+			++total;
+			if (first_one == none_found) first_one = index;
+			last_one = index;
+		}
+		else
+		{
+			if (first_zero == none_found) first_zero = index;
+			last_zero = index;
+		}
+	}
+
+	if (slice.count() != total || slice.any() != (total != 0) || slice.none() != (total == 0) || slice.all() != (total == length)) return false;
+	if (slice.first_one() != first_one || slice.last_one() != last_one || slice.first_zero() != first_zero || slice.last_zero() != last_zero) return false;
+	if (length == 0) return true;
+
+	// Ranged counts and searches from random positions:
+	for (unsigned int round = 0; round != 10; ++round)
+	{
+		std::size_t begin = static_cast<std::size_t>(rand()) % length, end = static_cast<std::size_t>(rand()) % (length + 1);
+		if (begin > end) std::swap(begin, end);
+
+		std::size_t range_total = 0;
+		for (std::size_t index = begin; index != end; ++index) range_total += model[offset + index];
+		if (slice.count_range(begin, end) != range_total || slice.any_range(begin, end) != (range_total != 0) || slice.all_range(begin, end) != (range_total == end - begin)) return false;
+
+		std::size_t next_one = begin, next_zero = begin, prev_one = begin, prev_zero = begin;
+		while (next_one != length && !model[offset + next_one]) ++next_one;
+		while (next_zero != length && model[offset + next_zero]) ++next_zero;
+		while (prev_one != none_found && !model[offset + prev_one]) prev_one = (prev_one == 0) ? none_found : prev_one - 1;
+		while (prev_zero != none_found && model[offset + prev_zero]) prev_zero = (prev_zero == 0) ? none_found : prev_zero - 1;
+
+		if (slice.next_one(begin) != ((next_one == length) ? none_found : next_one) || slice.next_zero(begin) != ((next_zero == length) ? none_found : next_zero)) return false;
+		if (slice.prev_one(begin) != prev_one || slice.prev_zero(begin) != prev_zero) return false;
+	}
+
+	return true;
+}
+
+
+
+template <typename storage_type>
+bool random_operations_test(const std::size_t size)
+{
+	typedef plf::bitsetb<false, storage_type> bitset_type;
+	bitset_type underlying(size), operand(size);
+	std::vector<bool> model(size);
+
+	for (std::size_t index = 0; index != size; ++index)
+	{
+		model[index] = (rand() & 1) != 0;
+		underlying.set(index, model[index]);
+		operand.set(index, (rand() & 1) != 0);
+	}
+
+	for (unsigned int round = 0; round != 400; ++round)
+	{
+		std::size_t offset = static_cast<std::size_t>(rand()) % size, length = static_cast<std::size_t>(rand()) % (size - offset + 1);
+		if (round % 4 == 0) length = (static_cast<std::size_t>(rand()) % 3 == 0) ? 0 : (length % 20); // short slices, within a single storage_type
+
+		plf::bitset_slice<storage_type> slice = underlying.slice(offset, length);
+		const std::size_t index = (length != 0) ? static_cast<std::size_t>(rand()) % length : 0;
+		std::size_t begin = (length != 0) ? static_cast<std::size_t>(rand()) % length : 0, end = static_cast<std::size_t>(rand()) % (length + 1);
+		if (begin > end) std::swap(begin, end);
+
+		switch ((length != 0) ? rand() % 10 : 9)
+		{
+			case 0:
+				slice.set(index, (rand() & 1) != 0);
+				model[offset + index] = slice[index];
+				slice.flip(index);
+				model[offset + index] = !model[offset + index];
+				break;
+			case 1:
+				slice.set_range(begin, end);
+				for (std::size_t current = begin; current != end; ++current) model[offset + current] = true;
+				break;
+			case 2:
+				slice.reset_range(begin, end);
+				for (std::size_t current = begin; current != end; ++current) model[offset + current] = false;
+				break;
+			case 3:
+				slice.flip_range(begin, end);
+				for (std::size_t current = begin; current != end; ++current) model[offset + current] = !model[offset + current];
+				break;
+			case 4:
+			{
+				// Operand is another (differently-aligned) slice:
+				const std::size_t operand_offset = static_cast<std::size_t>(rand()) % (size - length + 1);
+				const plf::bitset_slice<storage_type> source = operand.slice(operand_offset, length);
+				const int operation = rand() % 4;
+
+				switch (operation)
+				{
+					case 0: slice &= source; break;
+					case 1: slice |= source; break;
+					case 2: slice ^= source; break;
+					default: slice = source;
+				}
+
+				for (std::size_t current = 0; current != length; ++current)
+				{
+					const bool value = operand[operand_offset + current];
+					model[offset + current] = (operation == 0) ? (model[offset + current] && value) : (operation == 1) ? (model[offset + current] || value) : (operation == 2) ? (model[offset + current] != value) : value;
+				}
+
+				if (!(slice == source)) // ie. for the assignment case, as the operand is unchanged
+				{
+					if (operation == 3) return false;
+				}
+
+				break;
+			}
+			case 5:
+			{
+				// Operand is a word-aligned bitsetb, larger than the slice:
+				bitset_type source(length + static_cast<std::size_t>(rand()) % 70);
+				source.set();
+				source.reset(index);
+
+				if (rand() & 1)
+				{
+					slice &= source;
+					model[offset + index] = false;
+				}
+				else
+				{
+					slice ^= source;
+					for (std::size_t current = 0; current != length; ++current) model[offset + current] = (model[offset + current] != (current != index));
+				}
+
+				break;
+			}
+			case 6:
+			{
+				const std::size_t shift = static_cast<std::size_t>(rand()) % (length + 2);
+				slice >>= shift;
+				for (std::size_t current = 0; current != length; ++current) model[offset + current] = (current + shift < length) ? model[offset + current + shift] : false;
+				break;
+			}
+			case 7:
+			{
+				const std::size_t shift = static_cast<std::size_t>(rand()) % (length + 2);
+				slice <<= shift;
+				for (std::size_t current = length; current-- != 0;) model[offset + current] = (current >= shift) ? model[offset + current - shift] : false;
+				break;
+			}
+			case 8:
+				if (rand() % 3 == 0)
+				{
+					slice.set();
+					for (std::size_t current = 0; current != length; ++current) model[offset + current] = true;
+				}
+				else if (rand() & 1)
+				{
+					slice.reset();
+					for (std::size_t current = 0; current != length; ++current) model[offset + current] = false;
+				}
+				else
+				{
+					slice.flip();
+					for (std::size_t current = 0; current != length; ++current) model[offset + current] = !model[offset + current];
+				}
+
+				break;
+			default:
+				break;
+		}
+
+		if (!matches(slice, underlying, model)) return false;
+
+		// A sub-slice reads the same bits:
+		if (length > 2 && !matches(slice.slice(1, length - 2), underlying, model)) return false;
+	}
+
+	return true;
+}
+
+
+
+
+
+// The source overlaps the slice being written, at both lower and higher offsets - either as another slice of the same bitset, or as the whole bitset itself:
+template <typename storage_type>
+bool overlap_test(const std::size_t size)
+{
+	plf::bitsetb<false, storage_type> underlying(size);
+	std::vector<bool> model(size);
+
+	for (unsigned int round = 0; round != 400; ++round)
+	{
+		for (std::size_t index = 0; index != size; ++index)
+		{
+			model[index] = (rand() & 1) != 0;
+			underlying.set(index, model[index]);
+		}
+
+		const std::size_t length = 1 + static_cast<std::size_t>(rand()) % (size / 2), offset = static_cast<std::size_t>(rand()) % (size - length + 1);
+		const std::size_t source_offset = (round % 3 == 0) ? 0 : (rand() & 1) ? offset + (static_cast<std::size_t>(rand()) % 3) - 1 : static_cast<std::size_t>(rand()) % (size - length + 1);
+		if (source_offset + length > size) continue;
+
+		plf::bitset_slice<storage_type> slice = underlying.slice(offset, length);
+		const std::vector<bool> before(model);
+		const int operation = rand() % 4;
+
+		if (round % 3 == 0)
+		{
+			switch (operation)
+			{
+				case 0: slice &= underlying; break;
+				case 1: slice |= underlying; break;
+				case 2: slice ^= underlying; break;
+				default: slice = underlying;
+			}
+		}
+		else
+		{
+			const plf::bitset_slice<storage_type> source = underlying.slice(source_offset, length);
+
+			switch (operation)
+			{
+				case 0: slice &= source; break;
+				case 1: slice |= source; break;
+				case 2: slice ^= source; break;
+				default: slice = source;
+			}
+		}
+
+		for (std::size_t current = 0; current != length; ++current)
+		{
+			const bool value = before[source_offset + current];
+			model[offset + current] = (operation == 0) ? (before[offset + current] && value) : (operation == 1) ? (before[offset + current] || value) : (operation == 2) ? (before[offset + current] != value) : value;
+		}
+
+		for (std::size_t index = 0; index != size; ++index)
+		{
+			if (underlying[index] != model[index]) return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+int main()
+{
+	srand(23);
+
+	{
+		message("Random operation tests\n==================================\n\n");
+
+		failpass("64-bit storage test", random_operations_test<unsigned long long>(64 * 7 + 13) && random_operations_test<unsigned long long>(64 * 2));
+		failpass("32-bit storage test", random_operations_test<unsigned int>(32 * 9 + 5));
+		failpass("16-bit storage test", random_operations_test<unsigned short>(16 * 20 + 3));
+		failpass("8-bit storage test", random_operations_test<unsigned char>(8 * 40 + 1) && random_operations_test<unsigned char>(9));
+	}
+
+	{
+		message("Overlap tests\n==================================\n\n");
+
+		failpass("64-bit storage overlap test", overlap_test<unsigned long long>(64 * 9 + 21));
+		failpass("32-bit storage overlap test", overlap_test<unsigned int>(32 * 9 + 5));
+		failpass("8-bit storage overlap test", overlap_test<unsigned char>(8 * 40 + 3));
+
+		plf::bitset<1000> values, expected;
+
+		for (unsigned int index = 0; index != 1000; ++index) values.set(index, (rand() & 1) != 0);
+		for (unsigned int index = 0; index != 1000; ++index) expected.set(index, (index >= 10 && index < 310) ? values[index - 10] : values[index]);
+		values.slice(10, 300) = values.slice(0, 300);
+		failpass("Overlapping slice assignment test", values == expected);
+
+		for (unsigned int index = 0; index != 1000; ++index) expected.set(index, (index >= 5 && index < 305) ? values[index] != values[index - 5] : values[index]);
+		values.slice(5, 300) ^= values;
+		failpass("Overlapping whole-bitset xor test", values == expected);
+	}
+
+
+
+	{
+		message("Fixed-size bitset tests\n==================================\n\n");
+
+		plf::bitset<1000> values;
+		plf::bitset<300> mask;
+		mask.set_range(0, 150);
+
+		plf::bitset_slice<> window = values.slice(333, 300);
+		window |= mask;
+		failpass("Slice of plf::bitset test", values.count() == 150 && values.first_one() == 333 && values.last_one() == 333 + 149 && window == mask);
+
+		window >>= 100;
+		failpass("Slice shift test", values.count() == 50 && values.first_one() == 333 && window.last_one() == 49);
+
+		window <<= 250;
+		failpass("Slice shift out test", values.count() == 50 && values.first_one() == 333 + 250 && values.last_one() == 333 + 299 && !values.test(333 + 300));
+
+		plf::bitset<300> copy;
+		copy = values.as_view().slice(333, 300) == window ? mask : copy;
+		failpass("Slice comparison test", copy == mask && window != mask);
+	}
+
+
+	{
+		message("Hardened tests\n==================================\n\n");
+
+		plf::bitsetb<false, std::size_t, std::allocator<std::size_t>, true> values(500);
+		bool slice_thrown = false, index_thrown = false, range_thrown = false, size_thrown = false;
+
+		try
+		{
+			values.slice(400, 101);
+		}
+		catch (std::out_of_range &)
+		{
+			slice_thrown = true;
+		}
+
+		plf::bitset_slice<std::size_t, true> slice = values.slice(100, 100);
+
+		try
+		{
+			slice.set(100);
+		}
+		catch (std::out_of_range &)
+		{
+			index_thrown = true;
+		}
+
+		try
+		{
+			slice.count_range(50, 101);
+		}
+		catch (std::out_of_range &)
+		{
+			range_thrown = true;
+		}
+
+		try
+		{
+			slice &= plf::bitsetb<>(99);
+		}
+		catch (std::length_error &)
+		{
+			size_thrown = true;
+		}
+
+		slice.set_range(0, 100);
+		failpass("Hardened slice tests", slice_thrown && index_thrown && range_thrown && size_thrown && values.count() == 100 && values.first_one() == 100 && values.last_one() == 199);
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
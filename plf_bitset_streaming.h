@@ -0,0 +1,344 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_BITSET_STREAMING_H
+#define PLF_BITSET_STREAMING_H
+
+
+#include "plf_bitsetb.h" // plf::popcount, plf::check_operand_sizes
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#elif defined(__clang__)
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#else // Assume support for other compilers
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+#endif
+
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define PLF_STREAMING_VECTOR_BYTES 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define PLF_STREAMING_VECTOR_BYTES 16
+#elif defined(_MSC_VER) && defined(_M_IX86)
+	#include <xmmintrin.h> // _mm_prefetch
+#endif
+
+
+#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
+#define PLF_CACHE_LINE_BYTES 64
+
+
+#include <cstddef> // std::size_t
+#include <limits>  // std::numeric_limits
+
+
+
+namespace plf
+{
+
+
+// Streaming variants of the whole-bitset scans and bitwise operations, for bitsets much larger than the last-level cache where the plain loops are bound by memory latency rather than bandwidth. All accept any plf bitset type (anything with data() and size()), so plf::bitset and plf::bitsetb may be mixed as per plf::bitwise_and etc.
+// prefetch_distance is in bytes - how far ahead of the current position cache lines are requested, with 0 disabling software prefetching. The default is 0 because the hardware prefetchers on current x86 CPUs already follow a sequential stream, and measured software prefetching there was neutral to harmful. Where they don't keep up (eg. remote NUMA memory, or CPUs with weaker prefetchers) several hundred bytes to a few KB is typical, and the best value depends on memory latency, so it is a parameter rather than a constant. Prefetches use the non-temporal hint, so that a single pass over a huge bitset does not evict the rest of the working set.
+
+const std::size_t streaming_prefetch_distance = 0;
+const std::size_t streaming_tile_size = 256 * 1024; // bytes, ie. about half of a typical L2
+
+
+
+namespace streaming_detail
+{
+	template <typename storage_type>
+	inline void prefetch(const storage_type * const location) PLF_NOEXCEPT
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(location, 0, 0);
+		#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			_mm_prefetch(reinterpret_cast<const char *>(location), _MM_HINT_NTA);
+		#else
+			(void)location;
+		#endif
+	}
+
+
+
+	template <typename storage_type>
+	inline std::size_t number_of_words(const storage_type * const, const std::size_t total_size) PLF_NOEXCEPT
+	{
+		return (total_size + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH;
+	}
+
+
+
+	// Number of words per cache line, and the prefetch distance in words (at least one line, or 0 if prefetching is disabled):
+	template <typename storage_type>
+	inline std::size_t words_per_line() PLF_NOEXCEPT
+	{
+		return (sizeof(storage_type) >= PLF_CACHE_LINE_BYTES) ? 1 : PLF_CACHE_LINE_BYTES / sizeof(storage_type);
+	}
+
+
+	template <typename storage_type>
+	inline std::size_t distance_in_words(const std::size_t prefetch_distance) PLF_NOEXCEPT
+	{
+		const std::size_t distance = prefetch_distance / sizeof(storage_type), line = words_per_line<storage_type>();
+		return (prefetch_distance == 0) ? 0 : (distance < line) ? line : distance;
+	}
+
+
+
+	// The word at which prefetching stops, as the prefetch target would be past the end of the buffer:
+	inline std::size_t prefetch_end(const std::size_t number_of_words, const std::size_t distance) PLF_NOEXCEPT
+	{
+		return (distance != 0 && number_of_words > distance) ? number_of_words - distance : 0;
+	}
+
+
+
+	// True if a cache line begins within the bytes [location, location + bytes), ie. if a step over them enters a line not yet prefetched. Based on the address rather than the word index, as the buffers need not be line-aligned and vector steps need not land on a line's first word:
+	template <typename storage_type>
+	inline bool enters_line(const storage_type * const location, const std::size_t bytes) PLF_NOEXCEPT
+	{
+		return ((reinterpret_cast<std::size_t>(location) + PLF_CACHE_LINE_BYTES - 1) % PLF_CACHE_LINE_BYTES) + bytes >= PLF_CACHE_LINE_BYTES;
+	}
+
+
+
+	// Vector forms of plf::and_operation etc. for the non-temporal loop below:
+	#if PLF_STREAMING_VECTOR_BYTES == 32
+		inline __m256i apply_vector(plf::and_operation, const __m256i a, const __m256i b) PLF_NOEXCEPT { return _mm256_and_si256(a, b); }
+		inline __m256i apply_vector(plf::or_operation, const __m256i a, const __m256i b) PLF_NOEXCEPT { return _mm256_or_si256(a, b); }
+		inline __m256i apply_vector(plf::xor_operation, const __m256i a, const __m256i b) PLF_NOEXCEPT { return _mm256_xor_si256(a, b); }
+	#elif PLF_STREAMING_VECTOR_BYTES == 16
+		inline __m128i apply_vector(plf::and_operation, const __m128i a, const __m128i b) PLF_NOEXCEPT { return _mm_and_si128(a, b); }
+		inline __m128i apply_vector(plf::or_operation, const __m128i a, const __m128i b) PLF_NOEXCEPT { return _mm_or_si128(a, b); }
+		inline __m128i apply_vector(plf::xor_operation, const __m128i a, const __m128i b) PLF_NOEXCEPT { return _mm_xor_si128(a, b); }
+	#endif
+
+
+
+	// destination = a OP b. Where SSE2/AVX2 are available the destination is written with non-temporal stores, which bypass the cache - the result of a write-once pass over a huge bitset would otherwise evict everything else, and each destination line would first be read from memory (read-for-ownership) only to be overwritten. Scalar words are processed until the destination is vector-aligned, then whole vectors, then the remaining words:
+	template <class operation_type, typename storage_type>
+	void words(storage_type * const destination, const storage_type * const a, const storage_type * const b, const std::size_t number_of_words, const std::size_t prefetch_distance) PLF_NOEXCEPT
+	{
+		const std::size_t distance = distance_in_words<storage_type>(prefetch_distance);
+		std::size_t current = 0;
+
+		#ifdef PLF_STREAMING_VECTOR_BYTES
+			const std::size_t words_per_vector = PLF_STREAMING_VECTOR_BYTES / sizeof(storage_type);
+
+			if (words_per_vector != 0 && reinterpret_cast<std::size_t>(destination) % sizeof(storage_type) == 0)
+			{
+				for (; current != number_of_words && reinterpret_cast<std::size_t>(destination + current) % PLF_STREAMING_VECTOR_BYTES != 0; ++current)
+				{
+					destination[current] = operation_type::apply(a[current], b[current]);
+				}
+
+				const std::size_t vector_end = current + (((number_of_words - current) / words_per_vector) * words_per_vector), stop_prefetching = (distance == 0) ? 0 : prefetch_end(number_of_words, distance + words_per_vector - 1);
+
+				for (; current != vector_end; current += words_per_vector)
+				{
+					if (current < stop_prefetching) // prefetch the line entered by the last word of each target vector
+					{
+						if (enters_line(a + current + distance, PLF_STREAMING_VECTOR_BYTES)) prefetch(a + current + distance + words_per_vector - 1);
+						if (enters_line(b + current + distance, PLF_STREAMING_VECTOR_BYTES)) prefetch(b + current + distance + words_per_vector - 1);
+					}
+
+					#if PLF_STREAMING_VECTOR_BYTES == 32
+						_mm256_stream_si256(reinterpret_cast<__m256i *>(destination + current), apply_vector(operation_type(), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + current)), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + current))));
+					#else
+						_mm_stream_si128(reinterpret_cast<__m128i *>(destination + current), apply_vector(operation_type(), _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + current)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + current))));
+					#endif
+				}
+
+				_mm_sfence(); // non-temporal stores are weakly-ordered, so make them visible before returning
+			}
+		#endif
+
+		for (const std::size_t stop_prefetching = prefetch_end(number_of_words, distance); current < stop_prefetching; ++current)
+		{
+			if (enters_line(a + current + distance, sizeof(storage_type))) prefetch(a + current + distance);
+			if (enters_line(b + current + distance, sizeof(storage_type))) prefetch(b + current + distance);
+
+			destination[current] = operation_type::apply(a[current], b[current]);
+		}
+
+		for (; current < number_of_words; ++current) destination[current] = operation_type::apply(a[current], b[current]);
+	}
+
+
+
+	template <typename storage_type>
+	std::size_t count(const storage_type * const words, const std::size_t total_size, const std::size_t prefetch_distance) PLF_NOEXCEPT
+	{
+		const std::size_t end = number_of_words(words, total_size), distance = distance_in_words<storage_type>(prefetch_distance);
+		std::size_t total = 0, current = 0;
+
+		if (distance == 0) // separate loop so that the compiler can vectorize it
+		{
+			for (; current != end; ++current) total += plf::popcount(words[current]);
+			return total;
+		}
+
+		for (const std::size_t stop_prefetching = prefetch_end(end, distance); current < stop_prefetching; ++current)
+		{
+			if (enters_line(words + current + distance, sizeof(storage_type))) prefetch(words + current + distance);
+			total += plf::popcount(words[current]);
+		}
+
+		for (; current < end; ++current) total += plf::popcount(words[current]);
+		return total;
+	}
+
+
+
+	template <typename storage_type>
+	std::size_t first_one(const storage_type * const words, const std::size_t total_size, const std::size_t prefetch_distance) PLF_NOEXCEPT
+	{
+		const std::size_t end = number_of_words(words, total_size), distance = distance_in_words<storage_type>(prefetch_distance);
+		std::size_t current = 0;
+
+		for (const std::size_t stop_prefetching = prefetch_end(end, distance); current < stop_prefetching; ++current)
+		{
+			if (enters_line(words + current + distance, sizeof(storage_type))) prefetch(words + current + distance);
+			if (words[current] != 0) return (current * PLF_TYPE_BITWIDTH) + plf::count_trailing_ones(static_cast<storage_type>(~words[current]));
+		}
+
+		for (; current < end; ++current)
+		{
+			if (words[current] != 0) return (current * PLF_TYPE_BITWIDTH) + plf::count_trailing_ones(static_cast<storage_type>(~words[current]));
+		}
+
+		return std::numeric_limits<std::size_t>::max();
+	}
+
+
+
+	template <typename storage_type>
+	std::size_t words_per_tile(const storage_type * const, const std::size_t tile_size) PLF_NOEXCEPT
+	{
+		const std::size_t line = words_per_line<storage_type>(), words = (tile_size / sizeof(storage_type)) - ((tile_size / sizeof(storage_type)) % line);
+		return (words < line) ? line : words;
+	}
+}
+
+
+
+template <class bitset_type>
+std::size_t streaming_count(const bitset_type &source, const std::size_t prefetch_distance = streaming_prefetch_distance) PLF_NOEXCEPT
+{
+	return streaming_detail::count(source.data(), source.size(), prefetch_distance);
+}
+
+
+
+template <class bitset_type>
+bool streaming_any(const bitset_type &source, const std::size_t prefetch_distance = streaming_prefetch_distance) PLF_NOEXCEPT
+{
+	return streaming_detail::first_one(source.data(), source.size(), prefetch_distance) != std::numeric_limits<std::size_t>::max();
+}
+
+
+
+// Returns the index of the first set bit, or std::numeric_limits<std::size_t>::max() if there are none:
+template <class bitset_type>
+std::size_t streaming_first_one(const bitset_type &source, const std::size_t prefetch_distance = streaming_prefetch_distance) PLF_NOEXCEPT
+{
+	return streaming_detail::first_one(source.data(), source.size(), prefetch_distance);
+}
+
+
+
+// destination = a OP b, with non-temporal stores to the destination where supported. The destination may be the same object as either operand. Intended for destinations which will not be read again soon, eg. a fresh result bitset much larger than the last-level cache - for smaller bitsets use plf::bitwise_and etc., as the non-temporal stores force the result out to memory:
+template <class destination_type, class a_type, class b_type>
+void streaming_and(destination_type &destination, const a_type &a, const b_type &b, const std::size_t prefetch_distance = streaming_prefetch_distance)
+{
+	plf::check_operand_sizes(destination.size(), a.size(), b.size());
+	streaming_detail::words<plf::and_operation>(destination.data(), a.data(), b.data(), streaming_detail::number_of_words(a.data(), a.size()), prefetch_distance);
+}
+
+
+template <class destination_type, class a_type, class b_type>
+void streaming_or(destination_type &destination, const a_type &a, const b_type &b, const std::size_t prefetch_distance = streaming_prefetch_distance)
+{
+	plf::check_operand_sizes(destination.size(), a.size(), b.size());
+	streaming_detail::words<plf::or_operation>(destination.data(), a.data(), b.data(), streaming_detail::number_of_words(a.data(), a.size()), prefetch_distance);
+}
+
+
+template <class destination_type, class a_type, class b_type>
+void streaming_xor(destination_type &destination, const a_type &a, const b_type &b, const std::size_t prefetch_distance = streaming_prefetch_distance)
+{
+	plf::check_operand_sizes(destination.size(), a.size(), b.size());
+	streaming_detail::words<plf::xor_operation>(destination.data(), a.data(), b.data(), streaming_detail::number_of_words(a.data(), a.size()), prefetch_distance);
+}
+
+
+
+// Calls function(first_word, end_word) for each successive tile of source's storage, where a tile is at most tile_size bytes (rounded down to whole cache lines), and returns the function. Fusing several operations into one pass over each tile - eg. plf::bitwise_words on data() + first_word for each step, then a popcount of the result - means each tile is read from memory once and stays in L2 for the remaining steps, rather than every whole-bitset operation streaming the entire buffer through the cache again:
+template <class bitset_type, class function_type>
+function_type for_each_tile(const bitset_type &source, function_type function, const std::size_t tile_size = streaming_tile_size)
+{
+	const std::size_t end = streaming_detail::number_of_words(source.data(), source.size()), tile_words = streaming_detail::words_per_tile(source.data(), tile_size);
+
+	for (std::size_t first_word = 0; first_word < end; first_word += tile_words)
+	{
+		function(first_word, (end - first_word > tile_words) ? first_word + tile_words : end);
+	}
+
+	return function;
+}
+
+
+} // plf namespace
+
+
+#undef PLF_NOEXCEPT
+
+#undef PLF_TYPE_BITWIDTH
+#undef PLF_CACHE_LINE_BYTES
+#undef PLF_STREAMING_VECTOR_BYTES
+
+#endif // PLF_BITSET_STREAMING_H
+
+
+
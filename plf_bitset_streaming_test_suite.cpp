@@ -0,0 +1,182 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "plf_bitset.h"
+#include "plf_bitset_streaming.h"
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+template <class bitset_type>
+void fill_randomly(bitset_type &values, const int one_in)
+{
+	values.reset();
+
+	for (std::size_t index = 0; index != values.size(); ++index)
+	{
+		if (rand() % one_in == 0) values.set(index);
+	}
+}
+
+
+
+// Compares every streaming function against its plain equivalent, with the destination offset from vector alignment by offset words:
+template <typename storage_type>
+bool scan_and_bitwise_test(const std::size_t size, const std::size_t offset, const std::size_t prefetch_distance)
+{
+	typedef plf::bitsetb<false, storage_type> bitset_type;
+	bitset_type a(size), b(size);
+	std::vector<storage_type> buffer(((size + (sizeof(storage_type) * 8) - 1) / (sizeof(storage_type) * 8)) + offset);
+	plf::bitsetb<true, storage_type> destination(size, &buffer[offset]);
+
+	fill_randomly(a, 3);
+	fill_randomly(b, 50);
+
+	if (plf::streaming_count(a, prefetch_distance) != a.count() || plf::streaming_count(b, prefetch_distance) != b.count()) return false;
+	if (plf::streaming_first_one(b, prefetch_distance) != b.first_one() || plf::streaming_any(b, prefetch_distance) != b.any()) return false;
+
+	plf::streaming_and(destination, a, b, prefetch_distance);
+	if (!std::equal(destination.data(), destination.data() + (buffer.size() - offset), (a & b).data())) return false;
+
+	plf::streaming_or(destination, a, b, prefetch_distance);
+	if (!std::equal(destination.data(), destination.data() + (buffer.size() - offset), (a | b).data())) return false;
+
+	plf::streaming_xor(destination, a, b, prefetch_distance);
+	if (!std::equal(destination.data(), destination.data() + (buffer.size() - offset), (a ^ b).data())) return false;
+
+	const bitset_type expected = a | b;
+	plf::streaming_or(a, a, b, prefetch_distance); // aliased destination
+	if (a != expected) return false;
+
+	a.reset();
+	return plf::streaming_count(a, prefetch_distance) == 0 && !plf::streaming_any(a, prefetch_distance) && plf::streaming_first_one(a, prefetch_distance) == std::numeric_limits<std::size_t>::max();
+}
+
+
+
+// Fused destination = (a & b) ^ c, counting the result while each tile is still in cache:
+template <class bitset_type>
+struct fused_tile_operation
+{
+	typedef std::size_t size_type;
+
+	bitset_type &destination;
+	const bitset_type &a, &b, &c;
+	size_type total, tiles;
+
+	fused_tile_operation(bitset_type &destination_bitset, const bitset_type &a_bitset, const bitset_type &b_bitset, const bitset_type &c_bitset):
+		destination(destination_bitset), a(a_bitset), b(b_bitset), c(c_bitset), total(0), tiles(0)
+	{}
+
+	void operator () (const size_type first_word, const size_type end_word)
+	{
+		const size_type bits = (end_word - first_word) * sizeof(*a.data()) * 8;
+		plf::bitwise_words<plf::and_operation>(destination.data() + first_word, a.data() + first_word, b.data() + first_word, bits);
+		plf::bitwise_words<plf::xor_operation>(destination.data() + first_word, destination.data() + first_word, c.data() + first_word, bits);
+
+		for (size_type current = first_word; current != end_word; ++current) total += plf::popcount(destination.data()[current]);
+		++tiles;
+	}
+};
+
+
+
+
+
+int main()
+{
+	srand(17);
+
+	{
+		message("Scan and bitwise tests\n==================================\n\n");
+
+		failpass("Small bitset test", scan_and_bitwise_test<unsigned long long>(1, 0, 1024) && scan_and_bitwise_test<unsigned long long>(100, 1, 1024) && scan_and_bitwise_test<unsigned char>(13, 3, 1024));
+		failpass("Large bitset test", scan_and_bitwise_test<unsigned long long>(1000003, 0, 1024) && scan_and_bitwise_test<unsigned long long>(1000003, 1, 1024) && scan_and_bitwise_test<unsigned long long>(1000003, 3, 1024));
+		failpass("Other storage type test", scan_and_bitwise_test<unsigned int>(300007, 1, 512) && scan_and_bitwise_test<unsigned short>(100001, 5, 4096) && scan_and_bitwise_test<unsigned char>(100003, 7, 256));
+		failpass("Prefetch distance test", scan_and_bitwise_test<unsigned long long>(50000, 2, 0) && scan_and_bitwise_test<unsigned long long>(50000, 2, 1) && scan_and_bitwise_test<unsigned long long>(50000, 2, 64) && scan_and_bitwise_test<unsigned long long>(50000, 2, 1 << 20));
+
+		plf::bitsetb<> late(1000000);
+		late.set(999999);
+		failpass("Late first one test", plf::streaming_first_one(late) == 999999 && plf::streaming_any(late) && plf::streaming_count(late) == 1);
+	}
+
+
+	{
+		message("Mixed type tests\n==================================\n\n");
+
+		plf::bitset<5000> a, b;
+		plf::bitsetb<> destination(5000);
+		fill_randomly(a, 2);
+		fill_randomly(b, 2);
+
+		plf::streaming_xor(destination, a, b);
+		bool passed = plf::streaming_count(destination) == (a ^ b).count() && plf::streaming_count(a) == a.count();
+
+		for (std::size_t index = 0; index != 5000 && passed; ++index) passed = destination[index] == (a[index] != b[index]);
+		failpass("Mixed bitset/bitsetb test", passed);
+
+		bool length_error_thrown = false;
+		plf::bitsetb<> wrong_size(4999);
+
+		try
+		{
+			plf::streaming_and(wrong_size, a, b);
+		}
+		catch (std::length_error &)
+		{
+			length_error_thrown = true;
+		}
+
+		failpass("Size mismatch test", length_error_thrown);
+	}
+
+
+	{
+		message("Tiled fusion tests\n==================================\n\n");
+
+		typedef plf::bitsetb<> bitset_type;
+		const std::size_t size = 10000019;
+		bitset_type a(size), b(size), c(size), destination(size);
+		fill_randomly(a, 2);
+		fill_randomly(b, 3);
+		fill_randomly(c, 7);
+
+		const fused_tile_operation<bitset_type> fused = plf::for_each_tile(a, fused_tile_operation<bitset_type>(destination, a, b, c));
+		const bitset_type expected = (a & b) ^ c;
+		failpass("Fused tile result test", destination == expected && fused.total == expected.count() && fused.tiles == (((size + 63) / 64) * 8 + plf::streaming_tile_size - 1) / plf::streaming_tile_size);
+
+		const fused_tile_operation<bitset_type> small_tiles = plf::for_each_tile(a, fused_tile_operation<bitset_type>(destination, a, b, c), 100);
+		failpass("Undersized tile test", destination == expected && small_tiles.total == expected.count() && small_tiles.tiles == (size + 511) / 512);
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
@@ -1,5 +1,9 @@
 #include <cstdio>
 #include <iostream>
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
 #include "plf_bitset.h"
 
 
@@ -22,6 +26,10 @@
 	#endif
 #endif
 
+#ifdef PLF_CPP11_SUPPORT
+	#include <unordered_set>
+#endif
+
 
 void message(const char *message_text)
 {
@@ -49,6 +57,190 @@ void failpass(const char *test_type, bool condition)
 
 
 
+#if __cplusplus >= 202002L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) && _GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
+	#define PLF_CPP20_SUPPORT
+#elif defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__) && defined(_MSVC_LANG) && _MSVC_LANG >= 202002L && _MSC_VER >= 1929
+	#define PLF_CPP20_SUPPORT
+#endif
+
+
+#ifdef PLF_CPP20_SUPPORT // Compile-time tests - these fail at compile time rather than run time
+
+constexpr plf::bitset<256> make_identifier_characters()
+{
+	plf::bitset<256> characters;
+	characters.set_range('a', 'z' + 1);
+	characters.set_range('A', 'Z' + 1);
+	characters.set_range('0', '9' + 1);
+	characters.set('_');
+	return characters;
+}
+
+
+constexpr plf::bitset<256> identifier_characters = make_identifier_characters();
+static_assert(identifier_characters['a'] && identifier_characters['_'] && !identifier_characters[' '] && !identifier_characters[255]);
+static_assert(identifier_characters.count() == 63 && identifier_characters.count_range('a', 'z' + 1) == 26);
+static_assert(identifier_characters.first_one() == '0' && identifier_characters.last_one() == 'z' && identifier_characters.next_one('9' + 1) == 'A');
+static_assert(identifier_characters.next_run('A') == std::pair<std::size_t, std::size_t>('A', 'Z' + 1));
+
+
+template <std::size_t bitset_size>
+constexpr bool constexpr_api_test()
+{
+	plf::bitset<bitset_size> values, values2;
+
+	values.set();
+	if (!values.all() || values.count() != bitset_size || values.first_zero() != std::numeric_limits<std::size_t>::max()) return false;
+
+	values.reset();
+	values.set(3);
+	values.set(bitset_size - 1, true);
+	values.flip(5);
+	values.reset(5);
+	if (values.count() != 2 || !values.any_range(0, 4) || values.none_range(4, bitset_size - 1) != true || values.first_zero() != 0 || values.next_zero(3) != 4) return false;
+
+	values.flip();
+	values.flip_range(0, bitset_size / 2);
+	values.set_range(1, 2);
+	values.set_range(2, 3, false);
+	if (values.last_zero() != bitset_size - 1 || values.prev_zero(bitset_size - 2) >= bitset_size / 2 || values.all_range(0, 1)) return false;
+
+	const std::pair<std::size_t, std::size_t> ranges[2] = { std::pair<std::size_t, std::size_t>(0, 2), std::pair<std::size_t, std::size_t>(bitset_size - 3, bitset_size - 1) };
+	values2.set_ranges(ranges, ranges + 2);
+	if (values2.count_ranges(ranges, ranges + 2) != 4 || values2.count() != 4) return false;
+	values2.flip_ranges(ranges, ranges + 2);
+	values2.reset_ranges(ranges, ranges + 2);
+	if (values2.any()) return false;
+
+	values2 = values;
+	values2 <<= 3;
+	values2 >>= 1;
+	values2.shift_left_range(2, 1);
+	values2.shift_left_range_one(0);
+	values2 = (values2 << (bitset_size / 3)) >> 1;
+
+	const plf::bitset<bitset_size> combined = ((values & values2) | (values ^ values2)) & ~values2;
+	plf::bitset<bitset_size> destination;
+	plf::bitwise_andnot(destination, values, values2);
+	if (!(combined == destination) || combined != destination || !destination.is_subset_of(values) || destination.intersects(values2) || !destination.is_disjoint(values2)) return false;
+
+	if ((values < values2) == (values > values2) && values != values2) return false;
+	if (values.fingerprint() == values2.fingerprint() || values.to_string().size() != bitset_size || values.to_rstring()[0] != values.to_string()[bitset_size - 1]) return false;
+
+	const unsigned long long fingerprint = values.fingerprint();
+	values.swap(values2);
+	if (values2.fingerprint() != fingerprint || *values2.data() == 0) return false;
+
+	return true;
+}
+
+
+static_assert(constexpr_api_test<9>());
+static_assert(constexpr_api_test<64>());
+static_assert(constexpr_api_test<100>());
+static_assert(constexpr_api_test<300>());
+
+
+constexpr unsigned long make_ulong()
+{
+	plf::bitset<12> values;
+	values.set(0);
+	values.set(11);
+	return values.to_ulong() + values.to_reverse_ulong();
+}
+
+static_assert(make_ulong() == 200000000002ul || sizeof(unsigned long) < 8);
+
+#endif
+
+
+
+
+
+struct run_collector
+{
+	std::vector<std::pair<std::size_t, std::size_t> > *runs;
+
+	explicit run_collector(std::vector<std::pair<std::size_t, std::size_t> > &destination): runs(&destination) {}
+
+	void operator () (const std::size_t begin, const std::size_t end)
+	{
+		runs->push_back(std::make_pair(begin, end));
+	}
+};
+
+
+template <class bitset_type>
+std::size_t naive_find_run(const bitset_type &values, const std::size_t length, const std::size_t from, const bool value)
+{
+	for (std::size_t begin = from; begin < values.size(); ++begin)
+	{
+		std::size_t end = begin;
+		while (end != values.size() && end - begin != length && values[end] == value) ++end;
+		if (end - begin == length) return begin;
+	}
+
+	return std::numeric_limits<std::size_t>::max();
+}
+
+
+
+
+
+
+// Checks the single/few-word fast paths against a per-bit model:
+template <std::size_t bitset_size, typename storage_type>
+void small_bitset_test()
+{
+	plf::bitset<bitset_size, storage_type> values, shifted;
+
+	for (unsigned int counter = 0; counter != 500; ++counter)
+	{
+		for (std::size_t index = 0; index != bitset_size; ++index) values.set(index, (rand() % 3) != 0);
+		if (counter % 5 == 0) values.set();
+
+		bool all = true, any = false;
+
+		for (std::size_t index = 0; index != bitset_size; ++index)
+		{
+			all = all && values[index];
+			any = any || values[index];
+		}
+
+		const std::size_t shift_amount = static_cast<std::size_t>(rand()) % (bitset_size + 2);
+		shifted = values;
+		shifted >>= shift_amount;
+		bool shift_right_passed = true, shift_left_passed = true;
+
+		for (std::size_t index = 0; index != bitset_size; ++index)
+		{
+			if (shifted[index] != (index + shift_amount < bitset_size && values[index + shift_amount])) shift_right_passed = false;
+		}
+
+		shifted = values;
+		shifted <<= shift_amount;
+
+		for (std::size_t index = 0; index != bitset_size; ++index)
+		{
+			if (shifted[index] != (index >= shift_amount && values[index - shift_amount])) shift_left_passed = false;
+		}
+
+		shifted = values;
+		shifted.flip(static_cast<std::size_t>(rand()) % bitset_size);
+
+		if (values.all() != all || values.any() != any || !shift_right_passed || !shift_left_passed || shifted == values || !(shifted != values) || (values << bitset_size).any())
+		{
+			printf("Small bitset test failed, size == %u, counter == %u\n", static_cast<unsigned int>(bitset_size), counter);
+			getchar();
+			abort();
+		}
+	}
+}
+
+
+
+
+
 int main()
 {
 	{
@@ -271,7 +463,7 @@ int main()
 
 		for (unsigned int counter = 0; counter != 100000; ++counter)
 		{
-			const unsigned int start = (rand() % (bitset_size - 256)) + 128, end = start + (rand() % ((bitset_size - start) - 256)) + 128;
+			const unsigned int start = (rand() % (bitset_size - 512)) + 128, end = start + (rand() % ((bitset_size - start) - 256)) + 128;
 			const unsigned int test_range_start = start - (rand() % 128), test_range_end = end + (rand() % 128);
 			values.set_range(start, end);
 			const unsigned int counted_range = values.count_range(test_range_start, test_range_end);
@@ -367,6 +559,68 @@ int main()
 
 	}
 
+	{
+		plf::bitset<134> values;
+		values.set();
+		values.reset(70);
+		values.reset(75);
+		values.reset(90);
+
+		failpass("Zero search with several zeros in one storage_type", values.first_zero() == 70 && values.next_zero(71) == 75 && values.last_zero() == 90 && values.prev_zero(89) == 75);
+	}
+
+	{
+		plf::bitset<192> values;
+		values.set(10);
+		values.set(64);
+		values.set(128);
+
+		failpass("prev_one from the start of a storage_type", values.prev_one(64) == 10 && values.prev_one(128) == 64 && values.prev_one(65) == 64);
+	}
+
+	{
+		plf::bitset<100, unsigned char> values;
+		const std::pair<std::size_t, std::size_t> ranges[2] = { std::pair<std::size_t, std::size_t>(1, 6), std::pair<std::size_t, std::size_t>(20, 41) };
+		values.set_range(3, 90);
+
+		failpass("count and count_range with unsigned char storage", values.count() == 87 && values.count_range(5, 21) == 16 && values.count_range(4, 6) == 2 && values.count_ranges(ranges, ranges + 2) == 24);
+	}
+
+	{
+		plf::bitset<100, unsigned char> values;
+		values.set(50);
+
+		failpass("prev_one with no earlier bit and unsigned char storage", values.prev_one(5) == std::numeric_limits<std::size_t>::max() && values.prev_one(40) == std::numeric_limits<std::size_t>::max() && values.prev_one(60) == 50);
+	}
+
+	{
+		plf::bitset<100, unsigned char> values;
+		values.set();
+
+		failpass("prev_zero with no zero in the first storage_type", values.prev_zero(5) == std::numeric_limits<std::size_t>::max() && values.count() == 100 && values.all());
+	}
+
+	{
+		plf::bitset<128> values;
+		values.set();
+		values.reset(70);
+
+		failpass("Zero search when the size is a multiple of the storage_type width", values.first_zero() == 70 && values.last_zero() == 70 && values.next_zero(71) == std::numeric_limits<std::size_t>::max() && values.prev_zero(127) == 70);
+	}
+
+	{
+		plf::bitset<100, unsigned char> values;
+		plf::bitset<192> values2;
+		values.set_range(3, 16);
+		values2.set_range(3, 128);
+
+		failpass("Ranges ending on a storage_type boundary", values.count() == 13 && values.count_range(3, 16) == 13 && values.any_range(8, 16) && values2.count() == 125 && values2.count_range(3, 128) == 125 && values2.all_range(3, 128) && values2.any_range(127, 128));
+
+		values.reset_range(3, 16);
+		values2.reset_range(3, 128);
+		failpass("reset_range ending on a storage_type boundary", values.none() && values2.none());
+	}
+
 	{
 		const unsigned int bitset_size = 584;
 		plf::bitset<bitset_size> shift_values, shifted_values;
@@ -478,6 +732,436 @@ int main()
 	}
 
 
+	{
+		const unsigned int bitset_size = 584;
+		plf::bitset<bitset_size> values, values2;
+		std::vector<std::pair<std::size_t, std::size_t> > ranges;
+
+		for (unsigned int counter = 0; counter != 1000; ++counter)
+		{
+			ranges.clear();
+
+			for (unsigned int begin = rand() % 16; begin < bitset_size; )
+			{
+				const unsigned int end = begin + (rand() % 70);
+				if (end > bitset_size) break;
+				ranges.push_back(std::make_pair(begin, end));
+				begin = end + (rand() % 20);
+			}
+
+			values.reset();
+			values2.reset();
+			values.set_ranges(ranges.begin(), ranges.end());
+
+			std::size_t total = 0;
+
+			for (unsigned int index = 0; index != ranges.size(); ++index)
+			{
+				values2.set_range(ranges[index].first, ranges[index].second);
+				total += ranges[index].second - ranges[index].first;
+			}
+
+			if (values != values2 || values.count() != total || values.count_ranges(ranges.begin(), ranges.end()) != total)
+			{
+				printf("set_ranges/count_ranges test failed, counter == %u\n%s\n%s\n", counter, values.to_rstring().c_str(), values2.to_rstring().c_str());
+				getchar();
+				abort();
+			}
+
+			values.flip_ranges(ranges.begin(), ranges.end());
+
+			if (values.any())
+			{
+				printf("flip_ranges test failed, counter == %u\n%s\n", counter, values.to_rstring().c_str());
+				getchar();
+				abort();
+			}
+
+			values.set();
+			values.reset_ranges(ranges.begin(), ranges.end());
+			values2.flip();
+
+			if (values != values2)
+			{
+				printf("reset_ranges test failed, counter == %u\n%s\n%s\n", counter, values.to_rstring().c_str(), values2.to_rstring().c_str());
+				getchar();
+				abort();
+			}
+		}
+
+		message("set_ranges/reset_ranges/flip_ranges/count_ranges tests passed");
+
+		for (unsigned int counter = 0; counter != 1000; ++counter)
+		{
+			for (unsigned int index = 0; index != bitset_size; ++index)
+			{
+				values.set(index, rand() & 1);
+			}
+
+			values2 = values;
+			const unsigned int begin = rand() % bitset_size;
+			const unsigned int end = begin + (rand() % (bitset_size - begin));
+			values.flip_range(begin, end);
+
+			for (unsigned int index = begin; index != end; ++index)
+			{
+				values2.flip(index);
+			}
+
+			if (values != values2)
+			{
+				printf("flip_range test failed, counter == %u, begin == %u, end == %u\n", counter, begin, end);
+				getchar();
+				abort();
+			}
+		}
+
+		message("flip_range test passed");
+	}
+
+
+	{
+		const unsigned int bitset_size = 1000;
+		plf::bitset<bitset_size> values;
+		std::vector<std::pair<std::size_t, std::size_t> > runs, runs2, runs3;
+
+		for (unsigned int counter = 0; counter != 200; ++counter)
+		{
+			values.reset();
+
+			for (unsigned int begin = rand() % 8; begin < bitset_size; )
+			{
+				const unsigned int end = begin + (rand() % 150) + 1;
+				values.set_range(begin, (end > bitset_size) ? bitset_size : end);
+				begin = end + (rand() % 130) + 1;
+			}
+
+			runs.clear();
+			runs2.clear();
+			runs3.clear();
+
+			for (unsigned int index = 0; index != bitset_size; )
+			{
+				if (values[index])
+				{
+					const unsigned int begin = index;
+					while (index != bitset_size && values[index]) ++index;
+					runs.push_back(std::make_pair(begin, index));
+				}
+				else
+				{
+					++index;
+				}
+			}
+
+			for (std::pair<std::size_t, std::size_t> run = values.next_run(0); run.first != std::numeric_limits<std::size_t>::max(); run = values.next_run(run.second))
+			{
+				runs2.push_back(run);
+			}
+
+			values.for_each_run(run_collector(runs3));
+
+			if (runs != runs2 || runs != runs3)
+			{
+				printf("next_run/for_each_run test failed, counter == %u\n%s\n", counter, values.to_rstring().c_str());
+				getchar();
+				abort();
+			}
+		}
+
+		message("next_run/for_each_run tests passed");
+	}
+
+	{
+		const unsigned int bitset_size = 1000;
+		plf::bitset<bitset_size> values;
+
+		for (unsigned int counter = 0; counter != 200; ++counter)
+		{
+			values.reset();
+
+			for (unsigned int begin = rand() % 8; begin < bitset_size; )
+			{
+				const unsigned int end = begin + (rand() % 200) + 1;
+				values.set_range(begin, (end > bitset_size) ? bitset_size : end);
+				begin = end + (rand() % 200) + 1;
+			}
+
+			for (unsigned int search = 0; search != 10; ++search)
+			{
+				const std::size_t length = (search == 0) ? 1 : static_cast<std::size_t>(rand() % 250), from = static_cast<std::size_t>(rand() % (bitset_size + 10));
+
+				if (values.find_one_run(length, from) != naive_find_run(values, length, from, true) || values.find_zero_run(length, from) != naive_find_run(values, length, from, false))
+				{
+					printf("find_one_run/find_zero_run test failed, counter == %u, length == %u, from == %u\n%s\n", counter, static_cast<unsigned int>(length), static_cast<unsigned int>(from), values.to_rstring().c_str());
+					getchar();
+					abort();
+				}
+			}
+		}
+
+		values.set();
+		failpass("find_one_run full bitset test", values.find_one_run(bitset_size) == 0 && values.find_one_run(bitset_size + 1) == std::numeric_limits<std::size_t>::max() && values.find_one_run(10, bitset_size - 10) == bitset_size - 10 && values.find_zero_run(1) == std::numeric_limits<std::size_t>::max());
+
+		message("find_one_run/find_zero_run tests passed");
+	}
+
+
+
+	{
+		const unsigned int bitset_size = 584;
+		plf::bitset<bitset_size> values, values2;
+		std::set<unsigned long long> fingerprints;
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			values.set(index, rand() & 1);
+		}
+
+		values2 = values;
+		failpass("fingerprint equality test", values.fingerprint() == values2.fingerprint());
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			values2 = values;
+			values2.flip(index);
+			fingerprints.insert(values2.fingerprint());
+		}
+
+		fingerprints.insert(values.fingerprint());
+		failpass("fingerprint single-bit difference test", fingerprints.size() == bitset_size + 1);
+
+		#ifdef PLF_CPP11_SUPPORT
+			std::unordered_set<plf::bitset<bitset_size> > hash_set;
+			hash_set.insert(values);
+			hash_set.insert(values2);
+			hash_set.insert(values);
+
+			failpass("std::hash test", hash_set.size() == 2 && hash_set.count(values) == 1 && std::hash<plf::bitset<bitset_size> >()(values) == static_cast<std::size_t>(values.fingerprint()));
+		#endif
+	}
+
+
+	{
+		const unsigned int bitset_size = 300;
+		std::vector<plf::bitset<bitset_size> > bitsets(200);
+		std::set<plf::bitset<bitset_size> > bitset_set;
+
+		for (unsigned int counter = 0; counter != 200; ++counter)
+		{
+			for (unsigned int index = 0; index != bitset_size; ++index)
+			{
+				bitsets[counter].set(index, (rand() % 16) == 0); // sparse, so that many high words are equal
+			}
+
+			bitset_set.insert(bitsets[counter]);
+		}
+
+		bitsets[1] = bitsets[0];
+
+		for (unsigned int counter = 0; counter != 199; ++counter)
+		{
+			const int string_comparison = bitsets[counter].to_string().compare(bitsets[counter + 1].to_string());
+
+			if ((bitsets[counter] < bitsets[counter + 1]) != (string_comparison < 0) || (bitsets[counter] > bitsets[counter + 1]) != (string_comparison > 0) || (bitsets[counter] <= bitsets[counter + 1]) != (string_comparison <= 0) || (bitsets[counter] >= bitsets[counter + 1]) != (string_comparison >= 0))
+			{
+				printf("Ordering comparison test failed, counter == %u\n", counter);
+				getchar();
+				abort();
+			}
+		}
+
+		std::sort(bitsets.begin(), bitsets.end());
+
+		for (unsigned int counter = 0; counter != 199; ++counter)
+		{
+			if (bitsets[counter].to_string() > bitsets[counter + 1].to_string())
+			{
+				printf("Sort test failed, counter == %u\n", counter);
+				getchar();
+				abort();
+			}
+		}
+
+		failpass("Ordering and sort test", bitset_set.size() <= 200 && *bitset_set.begin() == bitsets[0]);
+	}
+
+
+	{
+		const unsigned int bitset_size = 300;
+		plf::bitset<bitset_size> values, values2;
+
+		for (unsigned int counter = 0; counter != 2000; ++counter)
+		{
+			values.reset();
+			values2.reset();
+
+			for (unsigned int index = 0, density = (rand() % 64) + 1; index != bitset_size; ++index)
+			{
+				if (rand() % density == 0) values.set(index);
+				if (rand() % density == 0) values2.set(index);
+			}
+
+			if (counter % 3 == 0) // make subset
+			{
+				for (unsigned int index = 0; index != bitset_size; ++index) if (values[index]) values2.set(index);
+			}
+
+			bool subset = true, superset = true, intersects = false;
+
+			for (unsigned int index = 0; index != bitset_size; ++index)
+			{
+				if (values[index] && !values2[index]) subset = false;
+				if (!values[index] && values2[index]) superset = false;
+				if (values[index] && values2[index]) intersects = true;
+			}
+
+			if (values.is_subset_of(values2) != subset || values.is_superset_of(values2) != superset || values.intersects(values2) != intersects || values.is_disjoint(values2) == intersects ||
+				values2.is_subset_of(values) != superset || values2.is_superset_of(values) != subset || values2.intersects(values) != intersects)
+			{
+				printf("Subset/superset/intersects test failed, counter == %u\n", counter);
+				getchar();
+				abort();
+			}
+		}
+
+		message("Subset/superset/intersects/disjoint tests passed");
+
+		const unsigned int word_bits = sizeof(std::size_t) * 8;
+		values.reset();
+		values.set(0);
+		values.set(bitset_size - 1);
+		failpass("data() test", values.data()[0] == 1 && values.data()[(bitset_size - 1) / word_bits] == static_cast<std::size_t>(1) << ((bitset_size - 1) % word_bits));
+
+		#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+		{
+			plf::bitset<bitset_size + 1> values3;
+			bool thrown = false;
+
+			try
+			{
+				values2.is_subset_of(values3);
+			}
+			catch (std::length_error &)
+			{
+				thrown = true;
+			}
+
+			failpass("Subset size mismatch test", thrown);
+		}
+		#endif
+	}
+
+
+	{
+		const unsigned int bitset_size = 301;
+		plf::bitset<bitset_size> a, b, destination;
+
+		for (unsigned int counter = 0; counter != 200; ++counter)
+		{
+			for (unsigned int index = 0; index != bitset_size; ++index)
+			{
+				a.set(index, (rand() & 1) == 0);
+				b.set(index, (rand() & 1) == 0);
+			}
+
+			for (unsigned int operation = 0; operation != 5; ++operation)
+			{
+				unsigned int expected_count = 0;
+
+				switch (operation)
+				{
+					case 0: plf::bitwise_and(destination, a, b); break;
+					case 1: plf::bitwise_or(destination, a, b); break;
+					case 2: plf::bitwise_xor(destination, a, b); break;
+					case 3: plf::bitwise_andnot(destination, a, b); break;
+					default: plf::bitwise_ornot(destination, a, b);
+				}
+
+				for (unsigned int index = 0; index != bitset_size; ++index)
+				{
+					bool expected;
+
+					switch (operation)
+					{
+						case 0: expected = a[index] && b[index]; break;
+						case 1: expected = a[index] || b[index]; break;
+						case 2: expected = a[index] != b[index]; break;
+						case 3: expected = a[index] && !b[index]; break;
+						default: expected = a[index] || !b[index];
+					}
+
+					if (destination[index] != expected)
+					{
+						printf("Three-operand bitwise test failed, operation == %u, index == %u\n", operation, index);
+						getchar();
+						abort();
+					}
+
+					expected_count += expected;
+				}
+
+				if (destination.count() != expected_count) // overflow bits must remain zero
+				{
+					printf("Three-operand bitwise count test failed, operation == %u\n", operation);
+					getchar();
+					abort();
+				}
+			}
+		}
+
+		message("Three-operand bitwise tests passed");
+
+		destination = a;
+		plf::bitwise_xor(destination, destination, b);
+		plf::bitwise_xor(destination, destination, b);
+		failpass("Three-operand bitwise aliasing test", destination == a);
+
+		plf::bitwise_ornot(b, b, b);
+		failpass("Three-operand bitwise ornot self test", b.all());
+	}
+
+
+	{
+		plf::bitset<1000, unsigned int> values, other;
+		values.set_range(100, 400);
+		plf::move_bits(values, 137, values, 100, 300); // upward overlapping move
+		failpass("move_bits upward overlap test", values.count() == 337 && values.first_one() == 100 && values.last_one() == 436);
+
+		plf::copy_bits(other, 1, values, 0, 999);
+		values <<= 1;
+		failpass("copy_bits shift equivalence test", other == values);
+	}
+
+
+	{
+		plf::bitset<1000, unsigned int> values;
+		for (unsigned int index = 0; index != 1000; ++index) values.set(index, rand() % 3 == 0);
+		const std::string reversed_string = values.to_rstring();
+		values.reverse();
+		failpass("reverse test", values.to_string() == reversed_string);
+
+		values.reverse_range(100, 900);
+		values.reverse_range(100, 900);
+		values.reverse();
+		failpass("reverse_range test", values.to_rstring() == reversed_string);
+	}
+
+
+	{
+		small_bitset_test<7, unsigned char>();
+		small_bitset_test<8, unsigned char>();
+		small_bitset_test<64, unsigned long long>();
+		small_bitset_test<50, unsigned int>();
+		small_bitset_test<100, unsigned long long>();
+		small_bitset_test<128, unsigned long long>();
+		small_bitset_test<60, unsigned int>();
+		small_bitset_test<200, unsigned long long>();
+		small_bitset_test<256, unsigned long long>();
+		message("Small bitset fast path tests passed");
+	}
+
+
 	printf("Press ENTER to quit");
 	getchar();
 	return 0;
@@ -1,4 +1,12 @@
+#define PLF_BITSET_STATISTICS // This suite runs with the optional instrumentation enabled, plf_bitset_test_suite.cpp without
+
+#include <algorithm>
+#include <functional>
 #include <cstdio>
+#include <set>
+#include <utility>
+#include <vector>
+#include "plf_bitset.h"
 #include "plf_bitsetb.h"
 
 
@@ -28,6 +36,134 @@ void failpass(const char *test_type, bool condition)
 
 
 
+struct run_collector
+{
+	std::vector<std::pair<std::size_t, std::size_t> > *runs;
+
+	explicit run_collector(std::vector<std::pair<std::size_t, std::size_t> > &destination): runs(&destination) {}
+
+	void operator () (const std::size_t begin, const std::size_t end)
+	{
+		runs->push_back(std::make_pair(begin, end));
+	}
+};
+
+
+template <class bitset_type>
+std::size_t naive_find_run(const bitset_type &values, const std::size_t length, const std::size_t from, const bool value)
+{
+	for (std::size_t begin = from; begin < values.size(); ++begin)
+	{
+		std::size_t end = begin;
+		while (end != values.size() && end - begin != length && values[end] == value) ++end;
+		if (end - begin == length) return begin;
+	}
+
+	return std::numeric_limits<std::size_t>::max();
+}
+
+
+
+// Random copy_bits and move_bits calls checked against a bit-by-bit copy, including overlapping moves within one bitset:
+template <typename storage_type>
+bool copy_bits_test(const std::size_t size)
+{
+	plf::bitsetb<false, storage_type> source(size), destination(size);
+	std::vector<bool> expected(size), expected_source(size);
+
+	for (std::size_t index = 0; index != size; ++index)
+	{
+		source.set(index, rand() % 2 == 0);
+		destination.set(index, rand() % 3 == 0);
+		expected[index] = destination[index];
+		expected_source[index] = source[index];
+	}
+
+	for (unsigned int round = 0; round != 2000; ++round)
+	{
+		const std::size_t length = static_cast<std::size_t>(rand()) % ((round % 4 == 0 || size < 20) ? size + 1 : 20), source_position = static_cast<std::size_t>(rand()) % (size - length + 1), destination_position = static_cast<std::size_t>(rand()) % (size - length + 1);
+
+		if (round % 2 == 0)
+		{
+			plf::copy_bits(destination, destination_position, source, source_position, length);
+			for (std::size_t index = 0; index != length; ++index) expected[destination_position + index] = expected_source[source_position + index];
+		}
+		else
+		{
+			plf::move_bits(destination, destination_position, destination, source_position, length);
+			const std::vector<bool> before(expected);
+			for (std::size_t index = 0; index != length; ++index) expected[destination_position + index] = before[source_position + index];
+		}
+
+		for (std::size_t index = 0; index != size; ++index)
+		{
+			if (destination[index] != expected[index]) return false;
+		}
+	}
+
+	std::size_t expected_count = 0;
+	for (std::size_t index = 0; index != size; ++index) expected_count += expected[index];
+	return destination.count() == expected_count; // overflow bits must remain untouched
+}
+
+
+
+// reverse, reverse_range and to_big_endian_bytes checked bit-by-bit:
+template <typename storage_type>
+bool reverse_test(const std::size_t size)
+{
+	plf::bitsetb<false, storage_type> values(size);
+	std::vector<bool> expected(size);
+
+	for (std::size_t index = 0; index != size; ++index)
+	{
+		values.set(index, rand() % 2 == 0);
+		expected[index] = values[index];
+	}
+
+	const std::size_t expected_count = values.count();
+	values.reverse();
+	std::reverse(expected.begin(), expected.end());
+
+	for (unsigned int round = 0; round != 200; ++round)
+	{
+		std::size_t begin = static_cast<std::size_t>(rand()) % (size + 1), end = static_cast<std::size_t>(rand()) % (size + 1);
+		if (begin > end) std::swap(begin, end);
+		values.reverse_range(begin, end);
+		std::reverse(expected.begin() + static_cast<std::ptrdiff_t>(begin), expected.begin() + static_cast<std::ptrdiff_t>(end));
+	}
+
+	for (std::size_t index = 0; index != size; ++index)
+	{
+		if (values[index] != expected[index]) return false;
+	}
+
+	std::vector<unsigned char> bytes((size + 7) / 8 + 1, 0xAA);
+	values.to_big_endian_bytes(&bytes[0]);
+
+	for (std::size_t index = 0; index != ((size + 7) / 8) * 8; ++index)
+	{
+		const bool bit = (bytes[((size + 7) / 8) - 1 - (index / 8)] >> (index % 8)) & 1;
+		if (bit != (index < size && expected[index])) return false;
+	}
+
+	return values.count() == expected_count && bytes.back() == 0xAA; // overflow bits must remain zero, and nothing written past the last byte
+}
+
+
+
+
+
+
+void count_hook_calls(const plf::bitset_statistics::operation_type, const std::size_t, void *user_data)
+{
+	++*static_cast<unsigned int *>(user_data);
+}
+
+
+
+
+
 int main()
 {
 	{
@@ -458,13 +594,127 @@ int main()
 		printf("After shift: %s\n", shift_values.to_rstring().c_str());
 	}
 
+	{
+		plf::bitsetb<> values(134);
+		values.set();
+		values.reset(70);
+		values.reset(75);
+		values.reset(90);
+
+		failpass("Zero search with several zeros in one storage_type", values.first_zero() == 70 && values.next_zero(71) == 75 && values.last_zero() == 90 && values.prev_zero(89) == 75);
+	}
+
+	{
+		plf::bitsetb<> values(134);
+		values.set(3);
+		values.set(70);
+
+		failpass("prev_one within and across storage_types", values.prev_one(69) == 3 && values.prev_one(100) == 70 && values.prev_one(70) == 70);
+	}
+
+	{
+		plf::bitsetb<false, unsigned char> values(100);
+		const std::pair<std::size_t, std::size_t> ranges[2] = { std::pair<std::size_t, std::size_t>(1, 6), std::pair<std::size_t, std::size_t>(20, 41) };
+		values.set_range(3, 90);
+
+		failpass("count and count_range with unsigned char storage", values.count() == 87 && values.count_range(5, 21) == 16 && values.count_range(4, 6) == 2 && values.count_ranges(ranges, ranges + 2) == 24);
+	}
+
+	{
+		plf::bitsetb<false, unsigned char> values(100);
+		values.set(50);
+
+		failpass("prev_one with no earlier bit and unsigned char storage", values.prev_one(5) == std::numeric_limits<std::size_t>::max() && values.prev_one(40) == std::numeric_limits<std::size_t>::max() && values.prev_one(60) == 50);
+	}
+
+	{
+		plf::bitsetb<false, unsigned char> values(100);
+		values.set();
+
+		failpass("prev_zero with no zero in the first storage_type", values.prev_zero(5) == std::numeric_limits<std::size_t>::max() && values.count() == 100 && values.all());
+	}
+
+	{
+		std::size_t buffer[4];
+		plf::bitsetb<> values(200);
+		plf::bitsetb<true> values2(200, buffer);
+		values.set();
+		values2.set();
+		values.change_size(100);
+		values2.change_size(100);
+
+		failpass("change_size shrink clears the bits beyond the new size", values.count() == 100 && values.all() && values2.count() == 100 && values2.all());
+	}
+
+	{
+		plf::bitsetb<> values(100);
+		values.set();
+		values.change_size(200);
+
+		failpass("change_size growth keeps the partial final storage_type", values.count() == 100 && values.all_range(0, 100) && values.none_range(100, 200));
+	}
+
+	{
+		plf::bitsetb<> values(128);
+		values.set();
+		values.reset(70);
+
+		failpass("Zero search when the size is a multiple of the storage_type width", values.first_zero() == 70 && values.last_zero() == 70 && values.next_zero(71) == std::numeric_limits<std::size_t>::max() && values.prev_zero(127) == 70);
+	}
+
+	{
+		plf::bitsetb<false, unsigned char> values(100);
+		plf::bitsetb<> values2(192);
+		values.set_range(3, 16);
+		values2.set_range(3, 128);
+
+		failpass("Ranges ending on a storage_type boundary", values.count() == 13 && values.count_range(3, 16) == 13 && values.any_range(8, 16) && values2.count() == 125 && values2.count_range(3, 128) == 125 && values2.all_range(3, 128) && values2.any_range(127, 128));
+
+		values.reset_range(3, 16);
+		values2.reset_range(3, 128);
+		failpass("reset_range ending on a storage_type boundary", values.none() && values2.none());
+	}
+
+	{
+		plf::bitsetb<> values(100), values2(128);
+		values2.set();
+
+		failpass("| and ^ with a larger source clear the bits beyond size()", (values | values2).count() == 100 && (values ^ values2).count() == 100);
+
+		values |= values2;
+		failpass("|= with a larger source clears the bits beyond size()", values.count() == 100 && values.all());
+
+		values.reset();
+		values ^= values2;
+		failpass("^= with a larger source clears the bits beyond size()", values.count() == 100 && values.all());
+	}
+
+	#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+	{
+		plf::bitsetb<false, std::size_t, std::allocator<std::size_t>, true> values(100);
+		bool thrown = false;
+		values.set();
+
+		try
+		{
+			values.change_size(200);
+		}
+		catch (std::out_of_range &)
+		{
+			thrown = true;
+		}
+
+		failpass("Hardened change_size growth test", !thrown && values.size() == 200 && values.count() == 100 && values.last_one() == 99);
+	}
+	#endif
+
 	{
 		const unsigned int bitset_size = 584000;
 		plf::bitsetb<> values(bitset_size);
 
 		for (unsigned int counter = 0; counter != 100000; ++counter)
 		{
-			const unsigned int start = (rand() % (bitset_size - 256)) + 128, end = start + (rand() % ((bitset_size - start) - 256)) + 128;
+			const unsigned int start = (rand() % (bitset_size - 512)) + 128, end = start + (rand() % ((bitset_size - start) - 256)) + 128;
 			const unsigned int test_range_start = start - (rand() % 128), test_range_end = end + (rand() % 128);
 			values.set_range(start, end);
 			const unsigned int counted_range = values.count_range(test_range_start, test_range_end);
@@ -497,6 +747,565 @@ int main()
 	}
 
 
+	{
+		const unsigned int bitset_size = 584;
+		plf::bitsetc values(bitset_size), values2(bitset_size);
+		std::vector<std::pair<std::size_t, std::size_t> > ranges;
+
+		for (unsigned int counter = 0; counter != 1000; ++counter)
+		{
+			ranges.clear();
+
+			for (unsigned int begin = rand() % 16; begin < bitset_size; )
+			{
+				const unsigned int end = begin + (rand() % 70);
+				if (end > bitset_size) break;
+				ranges.push_back(std::make_pair(begin, end));
+				begin = end + (rand() % 20);
+			}
+
+			values.reset();
+			values2.reset();
+			values.set_ranges(ranges.begin(), ranges.end());
+
+			std::size_t total = 0;
+
+			for (unsigned int index = 0; index != ranges.size(); ++index)
+			{
+				values2.set_range(ranges[index].first, ranges[index].second);
+				total += ranges[index].second - ranges[index].first;
+			}
+
+			if (values != values2 || values.count() != total || values.count_ranges(ranges.begin(), ranges.end()) != total)
+			{
+				printf("set_ranges/count_ranges test failed, counter == %u\n%s\n%s\n", counter, values.to_rstring().c_str(), values2.to_rstring().c_str());
+				getchar();
+				abort();
+			}
+
+			values.flip_ranges(ranges.begin(), ranges.end());
+
+			if (values.any())
+			{
+				printf("flip_ranges test failed, counter == %u\n%s\n", counter, values.to_rstring().c_str());
+				getchar();
+				abort();
+			}
+
+			values.set();
+			values.reset_ranges(ranges.begin(), ranges.end());
+			values2.flip();
+
+			if (values != values2)
+			{
+				printf("reset_ranges test failed, counter == %u\n%s\n%s\n", counter, values.to_rstring().c_str(), values2.to_rstring().c_str());
+				getchar();
+				abort();
+			}
+		}
+
+		message("set_ranges/reset_ranges/flip_ranges/count_ranges tests passed");
+
+		for (unsigned int counter = 0; counter != 1000; ++counter)
+		{
+			for (unsigned int index = 0; index != bitset_size; ++index)
+			{
+				values.set(index, rand() & 1);
+			}
+
+			values2 = values;
+			const unsigned int begin = rand() % bitset_size;
+			const unsigned int end = begin + (rand() % (bitset_size - begin));
+			values.flip_range(begin, end);
+
+			for (unsigned int index = begin; index != end; ++index)
+			{
+				values2.flip(index);
+			}
+
+			if (values != values2)
+			{
+				printf("flip_range test failed, counter == %u, begin == %u, end == %u\n", counter, begin, end);
+				getchar();
+				abort();
+			}
+		}
+
+		message("flip_range test passed");
+	}
+
+
+	{
+		const unsigned int bitset_size = 1000;
+		plf::bitsetb<false, unsigned char> values(bitset_size);
+		std::vector<std::pair<std::size_t, std::size_t> > runs, runs2, runs3;
+
+		for (unsigned int counter = 0; counter != 200; ++counter)
+		{
+			values.reset();
+
+			for (unsigned int begin = rand() % 8; begin < bitset_size; )
+			{
+				const unsigned int end = begin + (rand() % 150) + 1;
+				values.set_range(begin, (end > bitset_size) ? bitset_size : end);
+				begin = end + (rand() % 130) + 1;
+			}
+
+			runs.clear();
+			runs2.clear();
+			runs3.clear();
+
+			for (unsigned int index = 0; index != bitset_size; )
+			{
+				if (values[index])
+				{
+					const unsigned int begin = index;
+					while (index != bitset_size && values[index]) ++index;
+					runs.push_back(std::make_pair(begin, index));
+				}
+				else
+				{
+					++index;
+				}
+			}
+
+			for (std::pair<std::size_t, std::size_t> run = values.next_run(0); run.first != std::numeric_limits<std::size_t>::max(); run = values.next_run(run.second))
+			{
+				runs2.push_back(run);
+			}
+
+			values.for_each_run(run_collector(runs3));
+
+			if (runs != runs2 || runs != runs3)
+			{
+				printf("next_run/for_each_run test failed, counter == %u\n%s\n", counter, values.to_rstring().c_str());
+				getchar();
+				abort();
+			}
+		}
+
+		message("next_run/for_each_run tests passed");
+	}
+
+	{
+		const unsigned int bitset_size = 1000;
+		plf::bitsetb<false, unsigned char> values(bitset_size);
+
+		for (unsigned int counter = 0; counter != 200; ++counter)
+		{
+			values.reset();
+
+			for (unsigned int begin = rand() % 8; begin < bitset_size; )
+			{
+				const unsigned int end = begin + (rand() % 200) + 1;
+				values.set_range(begin, (end > bitset_size) ? bitset_size : end);
+				begin = end + (rand() % 200) + 1;
+			}
+
+			for (unsigned int search = 0; search != 10; ++search)
+			{
+				const std::size_t length = (search == 0) ? 1 : static_cast<std::size_t>(rand() % 250), from = static_cast<std::size_t>(rand() % (bitset_size + 10));
+
+				if (values.find_one_run(length, from) != naive_find_run(values, length, from, true) || values.find_zero_run(length, from) != naive_find_run(values, length, from, false))
+				{
+					printf("find_one_run/find_zero_run test failed, counter == %u, length == %u, from == %u\n%s\n", counter, static_cast<unsigned int>(length), static_cast<unsigned int>(from), values.to_rstring().c_str());
+					getchar();
+					abort();
+				}
+			}
+		}
+
+		values.set();
+		failpass("find_one_run full bitset test", values.find_one_run(bitset_size) == 0 && values.find_one_run(bitset_size + 1) == std::numeric_limits<std::size_t>::max() && values.find_one_run(10, bitset_size - 10) == bitset_size - 10 && values.find_zero_run(1) == std::numeric_limits<std::size_t>::max());
+
+		message("find_one_run/find_zero_run tests passed");
+	}
+
+
+
+	{
+		const unsigned int bitset_size = 581;
+		unsigned char buffer1[73], buffer2[73];
+		plf::bitsetb<true, unsigned char> values(bitset_size, buffer1), values2(bitset_size, buffer2);
+		std::set<unsigned long long> fingerprints;
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			values.set(index, rand() & 1);
+		}
+
+		values2 = values;
+		failpass("fingerprint equality test", values.fingerprint() == values2.fingerprint());
+
+		buffer2[72] |= 0xE0; // Set the unused bits in the final word, which should not affect the fingerprint
+		failpass("fingerprint unused bits test", values.fingerprint() == values2.fingerprint());
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			values2 = values;
+			values2.flip(index);
+			fingerprints.insert(values2.fingerprint());
+		}
+
+		fingerprints.insert(values.fingerprint());
+		failpass("fingerprint single-bit difference test", fingerprints.size() == bitset_size + 1);
+
+		plf::bitsetc values3(bitset_size);
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			values3.set(index, values[index]);
+		}
+
+		failpass("fingerprint storage_type independence test", values3.fingerprint() == values.fingerprint());
+
+		// Padding bits must not leak into the hash even when a dirty buffer is adopted as-is:
+		unsigned long long dirty_buffer[10];
+
+		for (unsigned int index = 0; index != 10; ++index)
+		{
+			dirty_buffer[index] = (static_cast<unsigned long long>(rand()) << 40) ^ (static_cast<unsigned long long>(rand()) << 20) ^ static_cast<unsigned long long>(rand());
+		}
+
+		dirty_buffer[9] |= ~0ULL << (bitset_size - 576);
+		plf::bitsetb<true, unsigned long long> adopted(bitset_size, dirty_buffer, false);
+		plf::bitsetc clean(bitset_size);
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			clean.set(index, adopted[index]);
+		}
+
+		failpass("fingerprint adopted dirty buffer test", adopted.fingerprint() == clean.fingerprint());
+
+		dirty_buffer[9] |= ~0ULL << (bitset_size - 576);
+		failpass("fingerprint re-dirtied buffer test", adopted.fingerprint() == clean.fingerprint());
+
+		#if defined(__cplusplus) && __cplusplus >= 201103L
+			failpass("std::hash dirty buffer test", std::hash<plf::bitsetb<true, unsigned long long> >()(adopted) == std::hash<plf::bitsetc>()(clean));
+		#endif
+
+	}
+
+
+	{
+		const unsigned int bitset_size = 300;
+		std::vector<plf::bitsetc> bitsets;
+		plf::bitsetc temp(bitset_size);
+
+		for (unsigned int counter = 0; counter != 200; ++counter)
+		{
+			for (unsigned int index = 0; index != bitset_size; ++index)
+			{
+				temp.set(index, (rand() % 16) == 0); // sparse, so that many high words are equal
+			}
+
+			bitsets.push_back(temp);
+		}
+
+		bitsets[1] = bitsets[0];
+
+		for (unsigned int counter = 0; counter != 199; ++counter)
+		{
+			const int string_comparison = bitsets[counter].to_string().compare(bitsets[counter + 1].to_string());
+
+			if ((bitsets[counter] < bitsets[counter + 1]) != (string_comparison < 0) || (bitsets[counter] > bitsets[counter + 1]) != (string_comparison > 0) || (bitsets[counter] <= bitsets[counter + 1]) != (string_comparison <= 0) || (bitsets[counter] >= bitsets[counter + 1]) != (string_comparison >= 0))
+			{
+				printf("Ordering comparison test failed, counter == %u\n", counter);
+				getchar();
+				abort();
+			}
+		}
+
+		plf::bitsetc smaller(bitset_size - 1), larger(bitset_size + 1);
+		smaller.set();
+
+		failpass("Ordering by size test", smaller < bitsets[0] && bitsets[0] < larger && !(larger < smaller));
+	}
+
+
+	{
+		const unsigned int bitset_size = 300;
+		plf::bitset<bitset_size> values;
+		plf::bitsetc values2(bitset_size);
+
+		for (unsigned int counter = 0; counter != 2000; ++counter)
+		{
+			values.reset();
+			values2.reset();
+
+			for (unsigned int index = 0, density = (rand() % 64) + 1; index != bitset_size; ++index)
+			{
+				if (rand() % density == 0) values.set(index);
+				if (rand() % density == 0) values2.set(index);
+			}
+
+			if (counter % 3 == 0) // make subset
+			{
+				for (unsigned int index = 0; index != bitset_size; ++index) if (values[index]) values2.set(index);
+			}
+
+			bool subset = true, superset = true, intersects = false;
+
+			for (unsigned int index = 0; index != bitset_size; ++index)
+			{
+				if (values[index] && !values2[index]) subset = false;
+				if (!values[index] && values2[index]) superset = false;
+				if (values[index] && values2[index]) intersects = true;
+			}
+
+			if (values.is_subset_of(values2) != subset || values.is_superset_of(values2) != superset || values.intersects(values2) != intersects || values.is_disjoint(values2) == intersects ||
+				values2.is_subset_of(values) != superset || values2.is_superset_of(values) != subset || values2.intersects(values) != intersects)
+			{
+				printf("Subset/superset/intersects test failed, counter == %u\n", counter);
+				getchar();
+				abort();
+			}
+		}
+
+		message("Subset/superset/intersects/disjoint tests passed");
+
+		#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+		{
+			plf::bitsetc values3(bitset_size + 1);
+			bool thrown = false;
+
+			try
+			{
+				values2.is_subset_of(values3);
+			}
+			catch (std::length_error &)
+			{
+				thrown = true;
+			}
+
+			failpass("Subset size mismatch test", thrown);
+		}
+		#endif
+	}
+
+
+	{
+		const unsigned int bitset_size = 300;
+		plf::bitset<bitset_size> values, expected;
+		plf::bitsetc values2(bitset_size), destination(bitset_size);
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			values.set(index, (rand() & 1) == 0);
+			values2.set(index, (rand() & 1) == 0);
+		}
+
+		plf::bitwise_and(destination, values, values2);
+		bool passed = true;
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			if (destination[index] != (values[index] && values2[index])) passed = false;
+		}
+
+		failpass("Mixed-type three-operand bitwise test", passed);
+
+		expected = values;
+		plf::bitwise_andnot(values, values, values2); // aliased destination
+		plf::bitwise_or(values, values, destination); // (a & ~b) | (a & b) == a
+		failpass("Mixed-type three-operand bitwise aliasing test", values == expected);
+
+		#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+		{
+			plf::bitsetc values3(bitset_size - 1);
+			bool thrown = false;
+
+			try
+			{
+				plf::bitwise_xor(values3, values, values2);
+			}
+			catch (std::length_error &)
+			{
+				thrown = true;
+			}
+
+			failpass("Three-operand bitwise size mismatch test", thrown);
+		}
+		#endif
+	}
+
+
+	{
+		const unsigned int bitset_size = 300;
+		plf::bitset<bitset_size> mask, original_mask;
+		plf::bitsetc column(bitset_size), larger(bitset_size + 7);
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			mask.set(index, (rand() & 1) == 0);
+			column.set(index, (rand() & 1) == 0);
+		}
+
+		larger.set(); // including bits beyond bitset_size, which must not leak into smaller operands
+		larger.reset(7);
+
+		plf::bitsetb<true> view = mask.as_view();
+		view.set(5);
+		view.reset(6);
+		failpass("as_view aliasing test", mask.test(5) && !mask.test(6) && view.size() == bitset_size && view.count() == mask.count() && view.data() == mask.data());
+		// Copy-constructing a view without a supplied buffer gives another view of the same buffer, whereas copy-assignment copies the bits:
+		plf::bitsetb<true> view_copy(view);
+		const bool original_bit = mask.test(9);
+		view_copy.flip(9);
+		failpass("View copy construction test", view_copy.data() == mask.data() && mask.test(9) != original_bit && view.test(9) != original_bit);
+
+		std::size_t separate_buffer[(bitset_size + 63) / 64];
+		plf::bitsetb<true> separate(bitset_size, separate_buffer);
+		separate = view_copy;
+		separate.flip(9);
+		failpass("View copy assignment test", separate.data() != mask.data() && separate.test(9) == original_bit && mask.test(9) != original_bit);
+		view_copy.flip(9);
+
+
+		original_mask = mask;
+		const plf::bitset<bitset_size> intersection = mask & column;
+		const plf::bitsetc union_result = column | mask;
+		mask ^= column;
+		bool passed = true;
+
+		for (unsigned int index = 0; index != bitset_size; ++index)
+		{
+			if (intersection[index] != (original_mask[index] && column[index]) || union_result[index] != (original_mask[index] || column[index]) || mask[index] != (original_mask[index] != column[index])) passed = false;
+		}
+
+		failpass("Mixed-type operator test", passed);
+
+		plf::bitsetc column_copy(column);
+		column_copy |= larger;
+		failpass("Mixed-type larger source test", column_copy.count() == bitset_size - (column[7] ? 0 : 1) && !column_copy[7] == !column[7] && (column & larger).count() == column.count() - (column[7] ? 1 : 0));
+
+		view = column; // through the view, into mask
+		failpass("Mixed-type view assignment test", std::equal(mask.data(), mask.data() + ((bitset_size + 63) / 64), column.data()) && mask.count() == column.count());
+
+		mask = original_mask;
+		column = mask;
+		failpass("Mixed-type assignment test", column.count() == original_mask.count() && original_mask.is_subset_of(column) && column.is_subset_of(original_mask));
+
+		#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+		{
+			plf::bitsetc smaller(bitset_size - 1);
+			bool fixed_size_thrown = false, smaller_source_thrown = false;
+
+			try
+			{
+				mask &= smaller;
+			}
+			catch (std::length_error &)
+			{
+				fixed_size_thrown = true;
+			}
+
+			try
+			{
+				larger |= mask;
+			}
+			catch (std::length_error &)
+			{
+				smaller_source_thrown = true;
+			}
+
+			failpass("Mixed-type size mismatch test", fixed_size_thrown && smaller_source_thrown);
+		}
+		#endif
+	}
+
+
+	{
+		failpass("copy_bits/move_bits test", copy_bits_test<unsigned long long>(64 * 9 + 13) && copy_bits_test<unsigned int>(32 * 7) && copy_bits_test<unsigned char>(203) && copy_bits_test<unsigned short>(5));
+
+		plf::bitset<300, unsigned long long> fixed;
+		plf::bitsetb<false, unsigned long long> dynamic(1000);
+		fixed.set_range(10, 110);
+		plf::copy_bits(dynamic, 901, fixed, 10, 99);
+		failpass("Mixed-type copy_bits test", dynamic.count() == 99 && dynamic.first_one() == 901 && dynamic.last_one() == 999);
+
+		plf::move_bits(dynamic, 3, dynamic, 900, 100);
+		failpass("move_bits downward overlap test", dynamic.count() == 99 + 99 && dynamic.first_one() == 4 && dynamic.next_zero(4) == 103);
+
+		#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+		{
+			bool thrown = false;
+
+			try
+			{
+				plf::copy_bits(fixed, 250, dynamic, 0, 51);
+			}
+			catch (std::out_of_range &)
+			{
+				thrown = true;
+			}
+
+			failpass("copy_bits range test", thrown && fixed.count() == 100);
+		}
+		#endif
+	}
+
+
+	{
+		failpass("reverse/reverse_range/to_big_endian_bytes test", reverse_test<unsigned long long>(64 * 21 + 13) && reverse_test<unsigned long long>(64 * 16) && reverse_test<unsigned int>(32 * 9 + 1) && reverse_test<unsigned char>(8 * 70 + 5) && reverse_test<unsigned short>(3) && reverse_test<unsigned long long>(1));
+
+		plf::bitsetb<false, unsigned int> values(36);
+		values.set(0);
+		values.set(33);
+		unsigned char bytes[5];
+		values.to_big_endian_bytes(bytes);
+		failpass("to_big_endian_bytes layout test", bytes[0] == 2 && bytes[1] == 0 && bytes[2] == 0 && bytes[3] == 0 && bytes[4] == 1);
+	}
+
+
+	{
+		plf::reset_bitset_statistics();
+		const plf::bitset_statistics &statistics = plf::get_bitset_statistics();
+		const plf::bitset_statistics::totals_type * const totals = statistics.totals;
+
+		plf::bitsetb<false, unsigned long long> values(1000);
+		plf::bitset<100, unsigned long long> values2;
+
+		values.set_range(10, 500);
+		values2.set_range(0, 64);
+		failpass("Statistics set_range test", totals[plf::bitset_statistics::set_range_operation].calls == 2 && totals[plf::bitset_statistics::set_range_operation].words == 8 + 1 && totals[plf::bitset_statistics::set_range_operation].bytes == (8 + 1) * 8);
+
+		values.count();
+		values.count_range(0, 64);
+		values2.count();
+		failpass("Statistics count test", totals[plf::bitset_statistics::count_operation].calls == 3 && totals[plf::bitset_statistics::count_operation].words == 16 + 1 + 2);
+
+		values >>= 3;
+		values2 <<= 3;
+		failpass("Statistics shift test", totals[plf::bitset_statistics::shift_operation].calls == 2);
+
+		values.first_one();
+		values.first_zero();
+		failpass("Statistics search test", totals[plf::bitset_statistics::search_operation].calls == 2 && totals[plf::bitset_statistics::search_operation].words == 2);
+
+		plf::bitsetb<false, unsigned long long> sparse(640);
+		sparse.set(600);
+		sparse.first_one();
+		sparse.last_one();
+		sparse.first_zero();
+		failpass("Statistics search words test", totals[plf::bitset_statistics::search_operation].calls == 5 && totals[plf::bitset_statistics::search_operation].words == 2 + 10 + 1 + 1);
+
+		values.change_size(2000);
+		failpass("Statistics allocation test", totals[plf::bitset_statistics::allocation_operation].calls == 1 && totals[plf::bitset_statistics::allocation_operation].bytes == 32 * 8 && std::string(plf::bitset_statistics::operation_name(plf::bitset_statistics::allocation_operation)) == "allocation");
+
+		unsigned int hook_calls = 0;
+		plf::set_bitset_hooks(count_hook_calls, count_hook_calls, &hook_calls, 2);
+		for (unsigned int counter = 0; counter != 4; ++counter) values.count();
+		plf::set_bitset_hooks(NULL, NULL);
+		values.count();
+		failpass("Statistics hook sampling test", hook_calls == 4 && totals[plf::bitset_statistics::count_operation].calls == 8);
+
+		plf::reset_bitset_statistics();
+		failpass("Statistics reset test", totals[plf::bitset_statistics::count_operation].calls == 0 && totals[plf::bitset_statistics::set_range_operation].words == 0);
+	}
+
+
 	printf("Press ENTER to quit");
 	getchar();
 
@@ -0,0 +1,498 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_BITSTREAM_H
+#define PLF_BITSTREAM_H
+
+
+#include "plf_bitsetb.h" // plf::bitsetb, plf::count_trailing_ones, plf::count_leading_ones
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+#define PLF_CONSTEXPR
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#elif defined(__clang__)
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#else // Assume support for other compilers
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+#endif
+
+
+
+#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
+#define PLF_CHUNK_WORDS (64 / PLF_TYPE_BITWIDTH) // storage_types per 64-bit accumulator
+
+
+#include <cstddef> // std::size_t
+#include <stdexcept> // std::out_of_range, std::length_error, std::invalid_argument
+#include <limits>  // std::numeric_limits
+#include <memory> // std::allocator
+
+
+
+namespace plf
+{
+
+
+// Appends variable-length codes to a plf::bitsetb, lowest bits first - ie. the first bit written is bit 0 of the bitsetb, and the bits of each value are written from its least significant bit upwards. Bits are gathered in a 64-bit accumulator and stored a whole accumulator (64 / storage_type width storage_types) at a time, rather than bit-by-bit.
+// A bitsetb which owns its buffer is grown geometrically via change_size() as required. A user-supplied buffer cannot grow, so writing past its size at construction throws std::length_error. The bitsetb's existing contents are overwritten from bit 0.
+// The destination's size() is its capacity while writing. flush() stores any bits still in the accumulator and trims the destination to exactly size() bits written - after which it can be read back with plf::bit_reader. Writing may continue after a flush:
+template <bool user_supplied_buffer = false, typename storage_type = std::size_t, class allocator_type = std::allocator<storage_type>, bool hardened = false>
+class bit_writer
+{
+public:
+	typedef std::size_t size_type;
+	typedef bitsetb<user_supplied_buffer, storage_type, allocator_type, hardened> bitset_type;
+
+private:
+	bitset_type &destination;
+	size_type capacity, chunks_stored; // capacity = size of a user-supplied buffer, in bits. chunks_stored = number of full accumulators stored so far
+	unsigned long long accumulator;
+	unsigned int pending; // number of bits in accumulator, always < 64
+
+	typedef char storage_type_must_be_at_most_64_bits[(sizeof(storage_type) <= 8) ? 1 : -1]; // C++03 static_assert
+
+
+
+	void check_number_of_bits(const unsigned int number_of_bits) const
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			if (number_of_bits == 0 || number_of_bits > 64)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Number of bits must be between 1 and 64");
+				#else
+					std::terminate();
+				#endif
+			}
+		}
+	}
+
+
+
+	// Enlarges the destination to at least required_size bits. Any bits past the destination's current size are in the accumulator, so are unaffected by change_size() zeroing them:
+	void grow(const size_type required_size)
+	{
+		if PLF_CONSTEXPR (user_supplied_buffer)
+		{
+			if (required_size > capacity)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::length_error("User-supplied buffer is full, cannot write.");
+				#else
+					std::terminate();
+				#endif
+			}
+
+			destination.change_size(capacity); // ie. restore the size reduced by flush()
+		}
+		else
+		{
+			const size_type new_size = (destination.size() * 2 > required_size) ? destination.size() * 2 : required_size;
+			destination.change_size((new_size + 63) & ~static_cast<size_type>(63)); // Whole accumulators only
+		}
+	}
+
+
+
+	// Stores the low number_of_words storage_types of value to the chunk at chunks_stored:
+	void store_chunk(const unsigned long long value, const size_type number_of_words) PLF_NOEXCEPT
+	{
+		storage_type * const words = destination.data() + (chunks_stored * PLF_CHUNK_WORDS);
+		for (size_type index = 0; index != number_of_words; ++index) words[index] = static_cast<storage_type>(value >> (index * PLF_TYPE_BITWIDTH));
+	}
+
+
+	bit_writer(const bit_writer &); // non-copyable, as two writers would overwrite each other's bits
+	void operator = (const bit_writer &);
+
+
+public:
+
+	explicit bit_writer(bitset_type &bitset_to_write):
+		destination(bitset_to_write),
+		capacity(bitset_to_write.size()),
+		chunks_stored(0),
+		accumulator(0),
+		pending(0)
+	{}
+
+
+
+	// Appends the low number_of_bits bits of value, where 0 < number_of_bits <= 64. Higher bits of value are ignored:
+	void put_bits(const unsigned long long value, const unsigned int number_of_bits)
+	{
+		check_number_of_bits(number_of_bits);
+		if (size() + number_of_bits > destination.size()) grow(size() + number_of_bits);
+
+		const unsigned long long bits = value & (std::numeric_limits<unsigned long long>::max() >> (64 - number_of_bits));
+		accumulator |= bits << pending;
+		pending += number_of_bits;
+
+		if (pending >= 64)
+		{
+			store_chunk(accumulator, PLF_CHUNK_WORDS);
+			++chunks_stored;
+			pending -= 64;
+			accumulator = (pending == 0) ? 0 : bits >> (number_of_bits - pending); // the bits which did not fit
+		}
+	}
+
+
+
+	void put_bit(const bool value)
+	{
+		put_bits(static_cast<unsigned long long>(value), 1);
+	}
+
+
+
+	// Writes count zeroes followed by a one:
+	void put_unary(size_type count)
+	{
+		for (; count >= 64; count -= 64) put_bits(0, 64);
+		put_bits(1ULL << count, static_cast<unsigned int>(count) + 1);
+	}
+
+
+
+	// Elias-gamma code for value (which must be > 0): the unary code of floor(log2(value)), whose terminating one doubles as value's most significant bit, followed by the remaining bits of value, lowest first:
+	void put_elias_gamma(const unsigned long long value)
+	{
+		if (value == 0)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::invalid_argument("Elias-gamma codes cannot represent zero.");
+			#else
+				std::terminate();
+			#endif
+		}
+
+		const unsigned int top_bit = 63 - static_cast<unsigned int>(plf::count_leading_ones(~value));
+		put_unary(top_bit);
+		if (top_bit != 0) put_bits(value, top_bit);
+	}
+
+
+
+	// Stores any bits remaining in the accumulator and sets the size of the destination to size():
+	void flush()
+	{
+		if (pending != 0) store_chunk(accumulator, (pending + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH);
+		destination.change_size(size());
+	}
+
+
+
+	// Number of bits written:
+	size_type size() const PLF_NOEXCEPT
+	{
+		return (chunks_stored * 64) + pending;
+	}
+};
+
+
+
+// Reads variable-length codes from any plf bitset type in the order written by plf::bit_writer - ie. from bit 0 upwards, with each value's least significant bit first. Bits are read into a 64-bit cache a whole 64 bits at a time.
+// Reading past size() yields zeroes, or throws std::out_of_range if hardened is true. Like plf::bitsetb<true>, a reader does not own the bits and must not outlive them:
+template <typename storage_type = std::size_t, bool hardened = false>
+class bit_reader
+{
+public:
+	typedef std::size_t size_type;
+
+private:
+	const storage_type *words;
+	size_type number_of_words, total_size, next_chunk; // next_chunk = index of the next 64-bit chunk to load into the cache
+	unsigned long long cache; // the next bits to be read, lowest first. Bits above cached are always zero
+	unsigned int cached;
+
+	typedef char storage_type_must_be_at_most_64_bits[(sizeof(storage_type) <= 8) ? 1 : -1]; // C++03 static_assert
+
+
+
+	unsigned long long load_chunk(const size_type chunk_index) const PLF_NOEXCEPT
+	{
+		unsigned long long value = 0;
+
+		for (size_type index = 0, word_index = chunk_index * PLF_CHUNK_WORDS; index != PLF_CHUNK_WORDS && word_index < number_of_words; ++index, ++word_index)
+		{
+			value |= static_cast<unsigned long long>(words[word_index]) << (index * PLF_TYPE_BITWIDTH);
+		}
+
+		return value;
+	}
+
+
+
+	void check_read(const size_type number_of_bits) const
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			if (position() > total_size || number_of_bits > total_size - position())
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Read past the end of the bitstream");
+				#else
+					std::terminate();
+				#endif
+			}
+		}
+	}
+
+
+
+	void check_number_of_bits(const unsigned int number_of_bits) const
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			if (number_of_bits == 0 || number_of_bits > 64)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Number of bits must be between 1 and 64");
+				#else
+					std::terminate();
+				#endif
+			}
+		}
+	}
+
+
+
+	static unsigned long long low_bits_mask(const unsigned int number_of_bits) PLF_NOEXCEPT
+	{
+		return std::numeric_limits<unsigned long long>::max() >> (64 - number_of_bits);
+	}
+
+
+public:
+
+	template <class bitset_type>
+	explicit bit_reader(const bitset_type &source):
+		words(source.data()),
+		number_of_words((source.size() + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH),
+		total_size(source.size()),
+		next_chunk(0),
+		cache(0),
+		cached(0)
+	{}
+
+
+
+	// Returns the next number_of_bits bits without consuming them, where 0 < number_of_bits <= 64:
+	unsigned long long peek(const unsigned int number_of_bits) const
+	{
+		check_number_of_bits(number_of_bits);
+		check_read(number_of_bits);
+		if (number_of_bits <= cached) return cache & low_bits_mask(number_of_bits);
+		return (cache | (load_chunk(next_chunk) << cached)) & low_bits_mask(number_of_bits);
+	}
+
+
+
+	// Returns and consumes the next number_of_bits bits, where 0 < number_of_bits <= 64:
+	unsigned long long get_bits(const unsigned int number_of_bits)
+	{
+		check_number_of_bits(number_of_bits);
+		check_read(number_of_bits);
+
+		if (number_of_bits <= cached)
+		{
+			const unsigned long long value = cache & low_bits_mask(number_of_bits);
+			cache = (number_of_bits == 64) ? 0 : cache >> number_of_bits;
+			cached -= number_of_bits;
+			return value;
+		}
+
+		const unsigned long long chunk = load_chunk(next_chunk++), value = (cache | (chunk << cached)) & low_bits_mask(number_of_bits);
+		const unsigned int used = number_of_bits - cached; // bits taken from chunk
+		cache = (used == 64) ? 0 : chunk >> used;
+		cached = 64 - used;
+		return value;
+	}
+
+
+
+	bool get_bit()
+	{
+		return get_bits(1) != 0;
+	}
+
+
+
+	// Reads a unary code as written by bit_writer::put_unary, returning the number of zeroes before the one. If no one remains, returns the number of bits remaining and moves the read position to size():
+	size_type get_unary()
+	{
+		const size_type start = position();
+		size_type count = 0;
+
+		while (true)
+		{
+			if (cache != 0)
+			{
+				const unsigned int zeroes = static_cast<unsigned int>(plf::count_trailing_ones(~cache));
+				check_read(zeroes + 1);
+				cache = (zeroes == 63) ? 0 : cache >> (zeroes + 1);
+				cached -= zeroes + 1;
+				return count + zeroes;
+			}
+
+			check_read(cached + 1);
+
+			if (next_chunk * 64 >= total_size) // only zeroes remain, so the code is unterminated
+			{
+				seek(total_size);
+				return (total_size > start) ? total_size - start : 0;
+			}
+
+			count += cached;
+
+			cache = load_chunk(next_chunk++);
+			cached = 64;
+		}
+	}
+
+
+
+	// Reads an Elias-gamma code as written by bit_writer::put_elias_gamma. A unary prefix of more than 63 zeroes cannot be the code of a 64-bit value, so is not a valid code - in which case 0 (which has no Elias-gamma code) is returned, or std::out_of_range is thrown if hardened is true:
+	unsigned long long get_elias_gamma()
+	{
+		const size_type top_bit = get_unary();
+
+		if (top_bit > 63)
+		{
+			if PLF_CONSTEXPR (hardened)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Elias-gamma code is longer than a 64-bit value allows");
+				#else
+					std::terminate();
+				#endif
+			}
+
+			return 0;
+		}
+
+		return (top_bit == 0) ? 1 : (1ULL << top_bit) | get_bits(static_cast<unsigned int>(top_bit));
+	}
+
+
+
+	void skip(const size_type number_of_bits)
+	{
+		if (number_of_bits < cached)
+		{
+			cache >>= number_of_bits;
+			cached -= static_cast<unsigned int>(number_of_bits);
+		}
+		else
+		{
+			seek(position() + number_of_bits);
+		}
+	}
+
+
+
+	// Moves the read position to bit index:
+	void seek(const size_type index)
+	{
+		next_chunk = index / 64;
+		cache = 0;
+		cached = 0;
+
+		if (index % 64 != 0)
+		{
+			cache = load_chunk(next_chunk++) >> (index % 64);
+			cached = 64 - static_cast<unsigned int>(index % 64);
+		}
+	}
+
+
+
+	// Index of the next bit to be read:
+	size_type position() const PLF_NOEXCEPT
+	{
+		return (next_chunk * 64) - cached;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	size_type remaining() const PLF_NOEXCEPT
+	{
+		return (position() < total_size) ? total_size - position() : 0;
+	}
+};
+
+
+} // plf namespace
+
+
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+#undef PLF_CONSTEXPR
+
+#undef PLF_CHUNK_WORDS
+#undef PLF_TYPE_BITWIDTH
+
+#endif // PLF_BITSTREAM_H
@@ -0,0 +1,307 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "plf_bitstream.h"
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+unsigned long long random_value()
+{
+	return (static_cast<unsigned long long>(rand()) << 48) ^ (static_cast<unsigned long long>(rand()) << 24) ^ static_cast<unsigned long long>(rand());
+}
+
+
+
+// Writes random codes of random widths, then checks that reading them back (whole, peeked and bit-by-bit) gives the same values:
+template <typename storage_type>
+bool round_trip_test(const unsigned int number_of_codes)
+{
+	plf::bitsetb<false, storage_type> bits(1);
+	plf::bit_writer<false, storage_type> writer(bits);
+	std::vector<unsigned long long> values;
+	std::vector<unsigned int> widths;
+	std::size_t total_bits = 0, total_ones = 0;
+
+	for (unsigned int index = 0; index != number_of_codes; ++index)
+	{
+		const unsigned int width = (index % 5 == 0) ? 64 : 1 + static_cast<unsigned int>(rand()) % 57;
+		const unsigned long long value = random_value();
+		writer.put_bits(value, width);
+		values.push_back((width == 64) ? value : value & ((1ULL << width) - 1));
+		widths.push_back(width);
+		total_bits += width;
+		for (unsigned long long remaining = values.back(); remaining != 0; remaining &= remaining - 1) ++total_ones;
+	}
+
+	writer.flush();
+	if (writer.size() != total_bits || bits.size() != total_bits) return false;
+
+	plf::bit_reader<storage_type> reader(bits), bit_by_bit(bits);
+
+	for (unsigned int index = 0; index != number_of_codes; ++index)
+	{
+		if (reader.peek(widths[index]) != values[index] || reader.get_bits(widths[index]) != values[index]) return false;
+
+		unsigned long long value = 0;
+		for (unsigned int bit = 0; bit != widths[index]; ++bit) value |= static_cast<unsigned long long>(bit_by_bit.get_bit()) << bit;
+		if (value != values[index]) return false;
+	}
+
+	return reader.position() == total_bits && reader.remaining() == 0 && bits.count() == total_ones;
+}
+
+
+
+
+
+int main()
+{
+	srand(17);
+
+	{
+		message("Writer tests\n==================================\n\n");
+
+		plf::bitsetb<> bits(10);
+		plf::bit_writer<> writer(bits);
+		writer.put_bits(5, 3); // 101
+		writer.put_bits(0xFFFFFFFFFFFFFFFFULL, 2); // higher bits ignored
+		writer.put_bit(false);
+		writer.put_bit(true);
+		writer.flush();
+
+		failpass("Bit order test", bits.size() == 7 && bits.test(0) && !bits.test(1) && bits.test(2) && bits.test(3) && bits.test(4) && !bits.test(5) && bits.test(6));
+
+		for (unsigned int index = 0; index != 1000; ++index) writer.put_bits(index, 10);
+		writer.flush();
+
+		plf::bit_reader<> reader(bits);
+		reader.skip(7);
+		bool passed = bits.size() == 7 + 10000;
+		for (unsigned int index = 0; index != 1000 && passed; ++index) passed = reader.get_bits(10) == index;
+		failpass("Write after flush test", passed);
+	}
+
+
+	{
+		message("Round trip tests\n==================================\n\n");
+
+		failpass("size_t storage round trip test", round_trip_test<std::size_t>(5000));
+		failpass("unsigned int storage round trip test", round_trip_test<unsigned int>(3000));
+		failpass("unsigned char storage round trip test", round_trip_test<unsigned char>(3000));
+		failpass("unsigned short storage round trip test", round_trip_test<unsigned short>(20));
+	}
+
+
+	{
+		message("Reader tests\n==================================\n\n");
+
+		plf::bitsetb<false, unsigned int> bits(1000);
+		for (std::size_t index = 0; index < 1000; index += 7) bits.set(index);
+
+		plf::bit_reader<unsigned int> reader(bits);
+		bool passed = true;
+
+		for (std::size_t index = 0; index != 1000 && passed; ++index)
+		{
+			reader.seek(index);
+			passed = reader.position() == index && reader.get_bit() == bits[index] && reader.peek(1) == ((index != 999) ? bits[index + 1] : 0);
+		}
+
+		failpass("Seek test", passed);
+
+		reader.seek(3);
+		reader.skip(2); // cached
+		reader.skip(100); // past the cache
+		failpass("Skip test", reader.position() == 105 && reader.get_bits(3) == 1 && reader.remaining() == 1000 - 108);
+
+		reader.seek(998);
+		failpass("Read past end test", reader.get_bits(10) == 0 && reader.remaining() == 0);
+	}
+
+
+	{
+		message("Unary and Elias-gamma tests\n==================================\n\n");
+
+		plf::bitsetb<> bits(64);
+		plf::bit_writer<> writer(bits);
+		std::vector<std::size_t> counts;
+		std::vector<unsigned long long> values;
+
+		for (unsigned int index = 0; index != 2000; ++index)
+		{
+			const std::size_t count = (index % 100 == 0) ? 64 + static_cast<std::size_t>(rand()) % 300 : static_cast<std::size_t>(rand()) % 20;
+			const unsigned long long value = random_value() >> (rand() % 64);
+			writer.put_unary(count);
+			writer.put_elias_gamma((value == 0) ? 1 : value);
+			counts.push_back(count);
+			values.push_back((value == 0) ? 1 : value);
+		}
+
+		writer.put_elias_gamma(1);
+		writer.put_elias_gamma(0xFFFFFFFFFFFFFFFFULL);
+		writer.put_unary(0);
+		writer.flush();
+
+		plf::bit_reader<> reader(bits);
+		bool passed = true;
+		for (unsigned int index = 0; index != 2000 && passed; ++index) passed = reader.get_unary() == counts[index] && reader.get_elias_gamma() == values[index];
+
+		failpass("Random unary/Elias-gamma test", passed);
+		failpass("Elias-gamma extremes test", reader.get_elias_gamma() == 1 && reader.get_elias_gamma() == 0xFFFFFFFFFFFFFFFFULL && reader.get_unary() == 0 && reader.remaining() == 0);
+
+		plf::bitsetb<> zeroes(200);
+		plf::bit_reader<> unterminated(zeroes);
+		failpass("Unterminated unary test", unterminated.get_unary() == 200 && unterminated.remaining() == 0 && unterminated.position() == 200);
+
+		zeroes.set(100);
+		plf::bit_reader<> too_long(zeroes);
+		failpass("Over-long Elias-gamma test", too_long.get_elias_gamma() == 0 && too_long.position() == 101);
+	}
+
+
+	{
+		message("User-supplied buffer tests\n==================================\n\n");
+
+		std::vector<unsigned long long> buffer(4, 0xFFFFFFFFFFFFFFFFULL);
+		plf::bitsetb<true, unsigned long long> bits(200, &buffer[0]);
+		plf::bit_writer<true, unsigned long long> writer(bits);
+
+		writer.put_bits(0x1234, 16);
+		writer.flush();
+		writer.put_bits(0xABCDEF, 24);
+		writer.put_bits(0x5555555555555555ULL, 64);
+		writer.flush();
+		writer.put_bits(3, 2);
+		writer.flush();
+
+		plf::bit_reader<unsigned long long> reader(bits);
+		failpass("Repeated flush test", bits.size() == 106 && reader.get_bits(16) == 0x1234 && reader.get_bits(24) == 0xABCDEF && reader.get_bits(64) == 0x5555555555555555ULL && reader.get_bits(2) == 3 && buffer[1] >> 42 == 0);
+
+		bool thrown = false;
+
+		try
+		{
+			writer.put_bits(0, 64);
+			writer.put_bits(0, 31);
+		}
+		catch (std::length_error &)
+		{
+			thrown = true;
+		}
+
+		failpass("Full buffer test", thrown && writer.size() == 106 + 64);
+	}
+
+
+	{
+		message("Hardened tests\n==================================\n\n");
+
+		typedef plf::bitsetb<false, std::size_t, std::allocator<std::size_t>, true> hardened_bitset;
+		hardened_bitset bits(1);
+		plf::bit_writer<false, std::size_t, std::allocator<std::size_t>, true> writer(bits);
+
+		for (unsigned int index = 0; index != 100; ++index) writer.put_bits(index, 7);
+		writer.flush();
+
+		plf::bit_reader<std::size_t, true> reader(bits);
+		bool passed = true;
+		for (unsigned int index = 0; index != 100; ++index) passed = passed && reader.get_bits(7) == index;
+
+		bool width_thrown = false, read_thrown = false, gamma_thrown = false, read_width_thrown = false, peek_width_thrown = false, gamma_length_thrown = false;
+
+		try
+		{
+			writer.put_bits(1, 65);
+		}
+		catch (std::out_of_range &)
+		{
+			width_thrown = true;
+		}
+
+		try
+		{
+			reader.get_bits(1);
+		}
+		catch (std::out_of_range &)
+		{
+			read_thrown = true;
+		}
+
+		try
+		{
+			writer.put_elias_gamma(0);
+		}
+		catch (std::invalid_argument &)
+		{
+			gamma_thrown = true;
+		}
+
+		plf::bit_reader<std::size_t, true> reader2(bits);
+
+		try
+		{
+			reader2.get_bits(0);
+		}
+		catch (std::out_of_range &)
+		{
+			read_width_thrown = true;
+		}
+
+		try
+		{
+			reader2.peek(65);
+		}
+		catch (std::out_of_range &)
+		{
+			peek_width_thrown = true;
+		}
+
+		hardened_bitset too_long(200);
+		too_long.set(100);
+		plf::bit_reader<std::size_t, true> reader3(too_long);
+
+		try
+		{
+			reader3.get_elias_gamma();
+		}
+		catch (std::out_of_range &)
+		{
+			gamma_length_thrown = true;
+		}
+
+		failpass("Hardened checks test", passed && width_thrown && read_thrown && gamma_thrown && bits.size() == 700);
+		failpass("Hardened reader width and Elias-gamma length test", read_width_thrown && peek_width_thrown && gamma_length_thrown && reader2.get_bits(7) == 0);
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
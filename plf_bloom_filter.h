@@ -0,0 +1,460 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_BLOOM_FILTER_H
+#define PLF_BLOOM_FILTER_H
+
+
+#include "plf_bitsetb.h" // storage, plf::hash_mix, plf::bitwise_or/and
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#elif defined(__clang__)
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#else // Assume support for other compilers
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+#endif
+
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define PLF_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <xmmintrin.h>
+	#define PLF_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char *>(address), _MM_HINT_T0)
+#else
+	#define PLF_PREFETCH(address)
+#endif
+
+
+#ifdef __AVX2__
+	#include <immintrin.h>
+#endif
+
+#include <cmath> // std::log, std::ceil
+#include <memory> // std::allocator
+#include <stdexcept> // std::invalid_argument
+
+
+
+namespace plf
+{
+
+
+// Both filters take keys which have already been hashed to 64 bits, by whichever hash function suits the key type. The hash is re-mixed internally, so weak hashes (eg. an identity hash of integers) still probe well. Each filter's storage is a plf::bitsetb<user_supplied_buffer, unsigned int, allocator_type>, so that a filter can live in a user-supplied or memory-mapped buffer, and be borrowed again later without clearing it (reset_supplied_buffer == false).
+// Union (|=) is exact, ie. the result is identical to a filter built from both sets of keys. Intersection (&=) contains every key present in both, but has a higher false positive rate than a filter built from the intersection of the keys.
+
+struct bloom_filter_tools
+{
+	typedef std::size_t size_type;
+
+	static unsigned long long mix(const unsigned long long hash) PLF_NOEXCEPT
+	{
+		return plf::hash_mix(hash, 0x9E3779B97F4A7C15ULL);
+	}
+
+
+	// Maps hash into [0, range) via a multiply-shift rather than a modulo (Lemire, "A fast alternative to the modulo reduction"):
+	static size_type reduce(const unsigned long long hash, const size_type range) PLF_NOEXCEPT
+	{
+		#ifdef __SIZEOF_INT128__
+			__extension__ typedef unsigned __int128 uint128_type;
+			return static_cast<size_type>((static_cast<uint128_type>(hash) * range) >> 64);
+		#else
+			return static_cast<size_type>(hash % range);
+		#endif
+	}
+
+
+	// The bit count giving the supplied false positive rate for expected_items keys in a standard filter (a split-block filter will be slightly worse):
+	static size_type optimal_number_of_bits(const size_type expected_items, const double false_positive_rate)
+	{
+		const double ln_2 = 0.69314718055994530942;
+		return static_cast<size_type>(std::ceil(-static_cast<double>(expected_items) * std::log(false_positive_rate) / (ln_2 * ln_2)));
+	}
+
+
+	static unsigned int optimal_number_of_hashes(const size_type number_of_bits, const size_type expected_items)
+	{
+		const double ln_2 = 0.69314718055994530942, hashes = (static_cast<double>(number_of_bits) / static_cast<double>(expected_items)) * ln_2;
+		return (hashes < 1.5) ? 1 : static_cast<unsigned int>(hashes + 0.5);
+	}
+};
+
+
+
+// A standard Bloom filter: number_of_hashes bit positions anywhere in the bitset, derived from one hash via double hashing (Kirsch & Mitzenmacher):
+template <bool user_supplied_buffer = false, class allocator_type = std::allocator<unsigned int> >
+class bloom_filter
+{
+public:
+	typedef std::size_t size_type;
+	typedef plf::bitsetb<user_supplied_buffer, unsigned int, allocator_type> bitset_type;
+
+private:
+	bitset_type bits;
+	unsigned int hashes;
+
+	static const size_type prefetch_distance = 8; // keys ahead in the batch functions
+
+
+	static unsigned long long step(const unsigned long long mixed) PLF_NOEXCEPT
+	{
+		return plf::hash_mix(mixed, 0xC2B2AE3D27D4EB4FULL) | 1;
+	}
+
+
+	template <bool other_user_supplied, class other_allocator_type>
+	void check_compatible(const bloom_filter<other_user_supplied, other_allocator_type> &source) const
+	{
+		if (source.number_of_hashes() != hashes)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::invalid_argument("Bloom filters with different numbers of hashes cannot be combined.");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+public:
+
+	bloom_filter(const size_type number_of_bits, const unsigned int number_of_hashes, unsigned int * const supplied_buffer = NULL, const bool reset_supplied_buffer = true):
+		bits((number_of_bits == 0) ? 1 : number_of_bits, supplied_buffer, reset_supplied_buffer),
+		hashes((number_of_hashes == 0) ? 1 : number_of_hashes)
+	{}
+
+
+
+	void insert(const unsigned long long hash) PLF_NOEXCEPT
+	{
+		unsigned long long position = bloom_filter_tools::mix(hash);
+		const unsigned long long increment = step(position);
+
+		for (unsigned int counter = 0; counter != hashes; ++counter, position += increment)
+		{
+			bits.set(bloom_filter_tools::reduce(position, bits.size()));
+		}
+	}
+
+
+
+	bool contains(const unsigned long long hash) const PLF_NOEXCEPT
+	{
+		unsigned long long position = bloom_filter_tools::mix(hash);
+		const unsigned long long increment = step(position);
+
+		for (unsigned int counter = 0; counter != hashes; ++counter, position += increment)
+		{
+			if (!bits[bloom_filter_tools::reduce(position, bits.size())]) return false;
+		}
+
+		return true;
+	}
+
+
+
+	// Batch functions prefetch the first probe of the key prefetch_distance ahead, so that cache misses overlap:
+	void insert(const unsigned long long * const hashes_begin, const size_type count) PLF_NOEXCEPT
+	{
+		for (size_type index = 0; index != count; ++index)
+		{
+			if (index + prefetch_distance < count) PLF_PREFETCH(bits.data() + (bloom_filter_tools::reduce(bloom_filter_tools::mix(hashes_begin[index + prefetch_distance]), bits.size()) / 32));
+			insert(hashes_begin[index]);
+		}
+	}
+
+
+
+	// Writes whether each key may be present to results, and returns the number which may be present:
+	size_type contains(const unsigned long long * const hashes_begin, const size_type count, bool * const results) const PLF_NOEXCEPT
+	{
+		size_type total = 0;
+
+		for (size_type index = 0; index != count; ++index)
+		{
+			if (index + prefetch_distance < count) PLF_PREFETCH(bits.data() + (bloom_filter_tools::reduce(bloom_filter_tools::mix(hashes_begin[index + prefetch_distance]), bits.size()) / 32));
+			total += (results[index] = contains(hashes_begin[index]));
+		}
+
+		return total;
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		bits.reset();
+	}
+
+
+
+	template <bool other_user_supplied, class other_allocator_type>
+	bloom_filter & operator |= (const bloom_filter<other_user_supplied, other_allocator_type> &source)
+	{
+		check_compatible(source);
+		plf::bitwise_or(bits, bits, source.bitset());
+		return *this;
+	}
+
+
+
+	template <bool other_user_supplied, class other_allocator_type>
+	bloom_filter & operator &= (const bloom_filter<other_user_supplied, other_allocator_type> &source)
+	{
+		check_compatible(source);
+		plf::bitwise_and(bits, bits, source.bitset());
+		return *this;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return bits.size();
+	}
+
+
+
+	unsigned int number_of_hashes() const PLF_NOEXCEPT
+	{
+		return hashes;
+	}
+
+
+
+	bitset_type & bitset() PLF_NOEXCEPT
+	{
+		return bits;
+	}
+
+
+
+	const bitset_type & bitset() const PLF_NOEXCEPT
+	{
+		return bits;
+	}
+};
+
+
+
+// A split-block Bloom filter (Putze, Sanders & Singler, "Cache-, hash- and space-efficient Bloom filters", as used by Apache Parquet and Impala). Each key selects one 256-bit block, ie. at most one cache line, and sets one bit in each of the block's eight 32-bit words. Under AVX2 a whole block is probed with a single multiply, shift and test. The bit count is rounded up to a whole number of blocks, and supplied buffers must hold that many bits:
+template <bool user_supplied_buffer = false, class allocator_type = std::allocator<unsigned int> >
+class split_block_bloom_filter
+{
+public:
+	typedef std::size_t size_type;
+	typedef plf::bitsetb<user_supplied_buffer, unsigned int, allocator_type> bitset_type;
+
+private:
+	bitset_type bits;
+	size_type number_of_blocks;
+
+	static const size_type prefetch_distance = 8; // keys ahead in the batch functions
+
+
+	static size_type blocks_for(const size_type number_of_bits) PLF_NOEXCEPT
+	{
+		return (number_of_bits < 256) ? 1 : (number_of_bits + 255) / 256;
+	}
+
+
+	unsigned int * block_for(const unsigned long long mixed) const PLF_NOEXCEPT
+	{
+		return const_cast<unsigned int *>(bits.data()) + (bloom_filter_tools::reduce(mixed, number_of_blocks) * 8);
+	}
+
+
+	#ifdef __AVX2__
+		static __m256i block_mask(const unsigned int key) PLF_NOEXCEPT
+		{
+			const __m256i salts = _mm256_setr_epi32(0x47b6137b, 0x44974d91, static_cast<int>(0x8824ad5bU), static_cast<int>(0xa2b7289dU), 0x705495c7, 0x2df1424b, static_cast<int>(0x9efc4947U), 0x5c6bfb31);
+			const __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(key)), salts), 27);
+			return _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+		}
+	#else
+		static unsigned int word_mask(const unsigned int key, const unsigned int word) PLF_NOEXCEPT
+		{
+			static const unsigned int salts[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+			return 1U << (static_cast<unsigned int>(key * salts[word]) >> 27);
+		}
+	#endif
+
+
+	static void insert_into_block(unsigned int * const block, const unsigned int key) PLF_NOEXCEPT
+	{
+		#ifdef __AVX2__
+			__m256i * const location = reinterpret_cast<__m256i *>(block);
+			_mm256_storeu_si256(location, _mm256_or_si256(_mm256_loadu_si256(location), block_mask(key)));
+		#else
+			for (unsigned int word = 0; word != 8; ++word) block[word] |= word_mask(key, word);
+		#endif
+	}
+
+
+	static bool block_contains(const unsigned int * const block, const unsigned int key) PLF_NOEXCEPT
+	{
+		#ifdef __AVX2__
+			return _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)), block_mask(key)) != 0; // ie. (~block & mask) == 0
+		#else
+			for (unsigned int word = 0; word != 8; ++word)
+			{
+				if (!(block[word] & word_mask(key, word))) return false;
+			}
+
+			return true;
+		#endif
+	}
+
+
+public:
+
+	explicit split_block_bloom_filter(const size_type number_of_bits, unsigned int * const supplied_buffer = NULL, const bool reset_supplied_buffer = true):
+		bits(blocks_for(number_of_bits) * 256, supplied_buffer, reset_supplied_buffer),
+		number_of_blocks(blocks_for(number_of_bits))
+	{}
+
+
+
+	void insert(const unsigned long long hash) PLF_NOEXCEPT
+	{
+		const unsigned long long mixed = bloom_filter_tools::mix(hash);
+		insert_into_block(block_for(mixed), static_cast<unsigned int>(mixed));
+	}
+
+
+
+	bool contains(const unsigned long long hash) const PLF_NOEXCEPT
+	{
+		const unsigned long long mixed = bloom_filter_tools::mix(hash);
+		return block_contains(block_for(mixed), static_cast<unsigned int>(mixed));
+	}
+
+
+
+	// Batch functions prefetch the block of the key prefetch_distance ahead, so that cache misses overlap:
+	void insert(const unsigned long long * const hashes, const size_type count) PLF_NOEXCEPT
+	{
+		for (size_type index = 0; index != count; ++index)
+		{
+			if (index + prefetch_distance < count) PLF_PREFETCH(block_for(bloom_filter_tools::mix(hashes[index + prefetch_distance])));
+			insert(hashes[index]);
+		}
+	}
+
+
+
+	// Writes whether each key may be present to results, and returns the number which may be present:
+	size_type contains(const unsigned long long * const hashes, const size_type count, bool * const results) const PLF_NOEXCEPT
+	{
+		size_type total = 0;
+
+		for (size_type index = 0; index != count; ++index)
+		{
+			if (index + prefetch_distance < count) PLF_PREFETCH(block_for(bloom_filter_tools::mix(hashes[index + prefetch_distance])));
+			total += (results[index] = contains(hashes[index]));
+		}
+
+		return total;
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		bits.reset();
+	}
+
+
+
+	template <bool other_user_supplied, class other_allocator_type>
+	split_block_bloom_filter & operator |= (const split_block_bloom_filter<other_user_supplied, other_allocator_type> &source)
+	{
+		plf::bitwise_or(bits, bits, source.bitset());
+		return *this;
+	}
+
+
+
+	template <bool other_user_supplied, class other_allocator_type>
+	split_block_bloom_filter & operator &= (const split_block_bloom_filter<other_user_supplied, other_allocator_type> &source)
+	{
+		plf::bitwise_and(bits, bits, source.bitset());
+		return *this;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return bits.size();
+	}
+
+
+
+	bitset_type & bitset() PLF_NOEXCEPT
+	{
+		return bits;
+	}
+
+
+
+	const bitset_type & bitset() const PLF_NOEXCEPT
+	{
+		return bits;
+	}
+};
+
+
+} // plf namespace
+
+
+#undef PLF_PREFETCH
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+
+#endif // PLF_BLOOM_FILTER_H
@@ -0,0 +1,195 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "plf_bloom_filter.h"
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+// Sequential keys with an identity hash, ie. the worst case for a filter which didn't re-mix its hashes:
+template <class filter_type>
+void filter_test(filter_type &filter, const char *name)
+{
+	const std::size_t inserted = 20000, queried = 200000;
+
+	for (unsigned long long key = 0; key != inserted / 2; ++key) filter.insert(key);
+
+	std::vector<unsigned long long> batch;
+	for (unsigned long long key = inserted / 2; key != inserted; ++key) batch.push_back(key);
+	filter.insert(&batch[0], batch.size());
+
+	bool no_false_negatives = true;
+	for (unsigned long long key = 0; key != inserted; ++key) no_false_negatives = no_false_negatives && filter.contains(key);
+
+	std::vector<unsigned long long> others;
+	for (unsigned long long key = inserted; key != inserted + queried; ++key) others.push_back(key);
+
+	bool *results = new bool[queried];
+	const std::size_t false_positives = filter.contains(&others[0], others.size(), results);
+	bool batch_matches_single = true;
+	for (std::size_t index = 0; index != queried; ++index) batch_matches_single = batch_matches_single && results[index] == filter.contains(others[index]);
+	delete [] results;
+
+	char title[256];
+	sprintf(title, "%s no false negatives test", name);
+	failpass(title, no_false_negatives);
+	sprintf(title, "%s batch contains test", name);
+	failpass(title, batch_matches_single);
+	sprintf(title, "%s false positive rate test (%.3f%%)", name, (100.0 * static_cast<double>(false_positives)) / queried);
+	failpass(title, false_positives < queried / 50); // sized for 1%
+}
+
+
+
+
+
+int main()
+{
+	const std::size_t bits = plf::bloom_filter_tools::optimal_number_of_bits(20000, 0.01);
+	const unsigned int hashes = plf::bloom_filter_tools::optimal_number_of_hashes(bits, 20000);
+
+	{
+		message("Sizing tests\n==================================\n\n");
+
+		failpass("Optimal bits test", bits > 9 * 20000 && bits < 10 * 20000);
+		failpass("Optimal hashes test", hashes == 7);
+
+		plf::split_block_bloom_filter<> rounded(1000);
+		failpass("Split-block rounding test", rounded.size() == 1024 && rounded.bitset().none());
+	}
+
+
+	{
+		message("Standard filter tests\n==================================\n\n");
+
+		plf::bloom_filter<> filter(bits, hashes);
+		filter_test(filter, "Standard filter");
+
+		filter.clear();
+		failpass("Clear test", filter.bitset().none() && !filter.contains(5));
+	}
+
+
+	{
+		message("Split-block filter tests\n==================================\n\n");
+
+		plf::split_block_bloom_filter<> filter(bits * 3 / 2); // split-block filters need ~50% more bits for the same rate
+		filter_test(filter, "Split-block filter");
+
+		// Each key sets exactly one bit in each of the eight words of one block:
+		plf::split_block_bloom_filter<> single(4096);
+		single.insert(12345);
+		std::size_t words_with_one_bit = 0;
+
+		for (std::size_t word = 0; word != 4096 / 32; ++word)
+		{
+			words_with_one_bit += (single.bitset().count_range(word * 32, (word + 1) * 32) == 1);
+		}
+
+		failpass("Block layout test", single.bitset().count() == 8 && words_with_one_bit == 8 && single.bitset().first_one() / 256 == single.bitset().last_one() / 256);
+	}
+
+
+	{
+		message("Borrowed buffer tests\n==================================\n\n");
+
+		std::vector<unsigned int> buffer(2048 / 32, 0xFFFFFFFF);
+		{
+			plf::split_block_bloom_filter<true> filter(2048, &buffer[0]);
+			filter.insert(1);
+			filter.insert(2);
+		}
+
+		failpass("Reset supplied buffer test", plf::bitsetb<true, unsigned int>(2048, &buffer[0], false).count() <= 16);
+
+		plf::split_block_bloom_filter<true> reopened(2048, &buffer[0], false); // eg. reopening a memory-mapped filter
+		failpass("Adopt supplied buffer test", reopened.contains(1) && reopened.contains(2));
+
+		std::vector<unsigned int> standard_buffer(1000 / 32 + 1);
+		plf::bloom_filter<true> standard(1000, 3, &standard_buffer[0]);
+		standard.insert(7);
+		plf::bloom_filter<true> standard_reopened(1000, 3, &standard_buffer[0], false);
+		failpass("Standard filter adopt supplied buffer test", standard_reopened.contains(7));
+	}
+
+
+	{
+		message("Union and intersection tests\n==================================\n\n");
+
+		plf::split_block_bloom_filter<> a(8192), b(8192), both(8192);
+		for (unsigned long long key = 0; key != 100; ++key) a.insert(key);
+		for (unsigned long long key = 50; key != 150; ++key) b.insert(key);
+		for (unsigned long long key = 0; key != 150; ++key) both.insert(key);
+
+		plf::split_block_bloom_filter<> united(a);
+		united |= b;
+		failpass("Union matches combined filter test", united.bitset() == both.bitset());
+
+		a &= b;
+		bool intersection_passed = true;
+		for (unsigned long long key = 50; key != 100; ++key) intersection_passed = intersection_passed && a.contains(key);
+		failpass("Intersection test", intersection_passed);
+
+		std::vector<unsigned int> buffer(8192 / 32);
+		plf::bloom_filter<true> borrowed(8192, 4, &buffer[0]);
+		plf::bloom_filter<> standard(8192, 4);
+		borrowed.insert(3);
+		standard.insert(4);
+		standard |= borrowed;
+		failpass("Mixed buffer type union test", standard.contains(3) && standard.contains(4));
+
+		plf::bloom_filter<> different_hashes(8192, 5), different_size(4096, 4);
+		bool invalid_argument_thrown = false, length_error_thrown = false;
+
+		try
+		{
+			standard |= different_hashes;
+		}
+		catch (std::invalid_argument &)
+		{
+			invalid_argument_thrown = true;
+		}
+
+		try
+		{
+			standard &= different_size;
+		}
+		catch (std::length_error &)
+		{
+			length_error_thrown = true;
+		}
+
+		failpass("Incompatible filter tests", invalid_argument_thrown && length_error_thrown);
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
@@ -0,0 +1,699 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_EWAH_BITSET_H
+#define PLF_EWAH_BITSET_H
+
+
+#include "plf_bitsetb.h" // decompression target, plf::popcount
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+#define PLF_CONSTEXPR
+#define PLF_CONSTFUNC
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L) && _MSC_VER >= 1929
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+		#define PLF_CPP20_SUPPORT
+	#endif
+
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#elif defined(__clang__)
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#else // Assume support for other compilers
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	// constexpr std::vector is required, as per plf::bitsetb's requirement for constexpr basic_string:
+	#if __cplusplus >= 202001L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) &&	_GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+		#define PLF_CPP20_SUPPORT
+	#endif
+#endif
+
+
+#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
+
+
+#include <vector>
+#include <memory> // std::allocator
+#include <stdexcept> // std::length_error, std::invalid_argument
+#include <limits>  // std::numeric_limits
+#include <algorithm> // std::fill_n, std::copy
+
+
+
+namespace plf
+{
+
+
+// A word-aligned run-length encoded bitset, as per EWAH (Lemire, Kaser & Aouiche, "Sorting improves word-aligned bitmap indexes"). The stream is a sequence of marker words, each followed by its literal words. A marker holds, from the least-significant bit upward: the value of a run of identical all-zero/all-one words (1 bit), the length of that run (half of the word), and the number of literal words which follow the run (the remainder).
+// The encoding is canonical - the same bits always produce the same stream - so streams can be compared directly. Unused bits in the final word are always zero, as per plf::bitset:
+template<typename storage_type = std::size_t, class allocator_type = std::allocator<storage_type> >
+class ewah_bitset
+{
+private:
+	typedef std::size_t size_type;
+
+	std::vector<storage_type, allocator_type> stream;
+	size_type total_size, last_marker; // last_marker is the index of the marker which new words are appended to
+
+	static const size_type run_length_bits = PLF_TYPE_BITWIDTH / 2, literal_count_bits = PLF_TYPE_BITWIDTH - 1 - (PLF_TYPE_BITWIDTH / 2);
+	static const size_type largest_run_length = (size_type(1) << run_length_bits) - 1, largest_literal_count = (size_type(1) << literal_count_bits) - 1;
+
+
+
+	PLF_CONSTFUNC const storage_type * stream_begin() const PLF_NOEXCEPT // vector::data() is C++11
+	{
+		return (stream.empty()) ? NULL : &stream[0];
+	}
+
+
+
+	static PLF_CONSTFUNC storage_type make_marker(const bool run_bit, const size_type run_words, const size_type literal_words) PLF_NOEXCEPT
+	{
+		return static_cast<storage_type>(static_cast<storage_type>(run_bit) | (static_cast<storage_type>(run_words) << 1) | (static_cast<storage_type>(literal_words) << (1 + run_length_bits)));
+	}
+
+
+
+	static PLF_CONSTFUNC bool marker_run_bit(const storage_type marker) PLF_NOEXCEPT
+	{
+		return static_cast<bool>(marker & 1);
+	}
+
+
+
+	static PLF_CONSTFUNC size_type marker_run_words(const storage_type marker) PLF_NOEXCEPT
+	{
+		return static_cast<size_type>(marker >> 1) & largest_run_length;
+	}
+
+
+
+	static PLF_CONSTFUNC size_type marker_literal_words(const storage_type marker) PLF_NOEXCEPT
+	{
+		return static_cast<size_type>(marker >> (1 + run_length_bits));
+	}
+
+
+
+	static PLF_CONSTFUNC storage_type run_word(const bool run_bit) PLF_NOEXCEPT
+	{
+		return (run_bit) ? std::numeric_limits<storage_type>::max() : storage_type(0);
+	}
+
+
+
+	// Reads a stream one marker at a time, presenting the current marker's remaining run words and remaining literal words:
+	class stream_reader
+	{
+	private:
+		const storage_type *position, *stream_end;
+
+	public:
+		bool run_bit;
+		size_type run_words, literal_words;
+		const storage_type *literals;
+
+		PLF_CONSTFUNC stream_reader(const storage_type * const begin, const storage_type * const end) PLF_NOEXCEPT:
+			position(begin),
+			stream_end(end),
+			run_bit(false),
+			run_words(0),
+			literal_words(0),
+			literals(NULL)
+		{
+			load();
+		}
+
+
+		PLF_CONSTFUNC void load() PLF_NOEXCEPT
+		{
+			while (run_words == 0 && literal_words == 0 && position != stream_end)
+			{
+				const storage_type marker = *position;
+				run_bit = marker_run_bit(marker);
+				run_words = marker_run_words(marker);
+				literal_words = marker_literal_words(marker);
+				literals = ++position;
+				position += literal_words;
+			}
+		}
+
+
+		PLF_CONSTFUNC bool done() const PLF_NOEXCEPT
+		{
+			return run_words == 0 && literal_words == 0;
+		}
+
+
+		PLF_CONSTFUNC void skip_run_words(const size_type amount) PLF_NOEXCEPT
+		{
+			run_words -= amount;
+			if (run_words == 0 && literal_words == 0) load();
+		}
+
+
+		PLF_CONSTFUNC storage_type next_literal() PLF_NOEXCEPT
+		{
+			const storage_type word = *literals++;
+			if (--literal_words == 0) load();
+			return word;
+		}
+	};
+
+
+
+	PLF_CONSTFUNC void append_run(const bool run_bit, size_type amount)
+	{
+		while (amount != 0)
+		{
+			if (last_marker != std::numeric_limits<size_type>::max())
+			{
+				storage_type &marker = stream[last_marker];
+				const size_type run_words = marker_run_words(marker);
+
+				// A run can only be extended if no literals have followed it, and the run is either empty or of the same value:
+				if (marker_literal_words(marker) == 0 && (run_words == 0 || marker_run_bit(marker) == run_bit) && run_words != largest_run_length)
+				{
+					const size_type extension = (amount < largest_run_length - run_words) ? amount : largest_run_length - run_words;
+					marker = make_marker(run_bit, run_words + extension, 0);
+					amount -= extension;
+					continue;
+				}
+			}
+
+			last_marker = stream.size();
+			stream.push_back(make_marker(run_bit, 0, 0));
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void append_literal(const storage_type word)
+	{
+		if (word == 0 || word == std::numeric_limits<storage_type>::max())
+		{
+			append_run(word != 0, 1);
+			return;
+		}
+
+		if (last_marker == std::numeric_limits<size_type>::max() || marker_literal_words(stream[last_marker]) == largest_literal_count)
+		{
+			last_marker = stream.size();
+			stream.push_back(make_marker(false, 0, 0));
+		}
+
+		const storage_type marker = stream[last_marker];
+		stream[last_marker] = make_marker(marker_run_bit(marker), marker_run_words(marker), marker_literal_words(marker) + 1);
+		stream.push_back(word);
+	}
+
+
+
+	PLF_CONSTFUNC void check_source_size_is_equal(const size_type source_size) const
+	{
+		if (source_size != total_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Source size is not equal to size of *this.");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	static PLF_CONSTFUNC void throw_invalid_stream()
+	{
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			throw std::invalid_argument("Stream is not a valid EWAH stream for the supplied size.");
+		#else
+			std::terminate();
+		#endif
+	}
+
+
+
+	// Combines two equal-sized streams word-run by word-run without decompressing either. Where one side is a run, the result for the overlapping words is a single run if the operation is absorbing (eg. and-ing with zeroes), otherwise the other side's literals are combined with the run's word:
+	template <class operation_type>
+	static PLF_CONSTFUNC void combine(const ewah_bitset &a, const ewah_bitset &b, ewah_bitset &result)
+	{
+		a.check_source_size_is_equal(b.total_size);
+		result.clear();
+		result.total_size = a.total_size;
+
+		stream_reader a_reader(a.stream_begin(), a.stream_begin() + a.stream.size()), b_reader(b.stream_begin(), b.stream_begin() + b.stream.size());
+
+		while (!a_reader.done() && !b_reader.done())
+		{
+			if (a_reader.run_words != 0 && b_reader.run_words != 0)
+			{
+				const size_type amount = (a_reader.run_words < b_reader.run_words) ? a_reader.run_words : b_reader.run_words;
+				result.append_run(operation_type::apply(run_word(a_reader.run_bit), run_word(b_reader.run_bit)) != 0, amount);
+				a_reader.skip_run_words(amount);
+				b_reader.skip_run_words(amount);
+			}
+			else if (a_reader.run_words != 0 || b_reader.run_words != 0)
+			{
+				const bool a_is_run = (a_reader.run_words != 0);
+				stream_reader &run_reader = (a_is_run) ? a_reader : b_reader, &literal_reader = (a_is_run) ? b_reader : a_reader;
+				const storage_type run_value = run_word(run_reader.run_bit);
+				const size_type amount = (run_reader.run_words < literal_reader.literal_words) ? run_reader.run_words : literal_reader.literal_words;
+				const storage_type with_zero = (a_is_run) ? operation_type::apply(run_value, storage_type(0)) : operation_type::apply(storage_type(0), run_value), with_one = (a_is_run) ? operation_type::apply(run_value, std::numeric_limits<storage_type>::max()) : operation_type::apply(std::numeric_limits<storage_type>::max(), run_value);
+
+				if (with_zero == with_one) // the run absorbs the literals
+				{
+					result.append_run(with_zero != 0, amount);
+					literal_reader.literals += amount;
+					literal_reader.literal_words -= amount;
+					if (literal_reader.literal_words == 0) literal_reader.load();
+				}
+				else
+				{
+					for (size_type counter = 0; counter != amount; ++counter)
+					{
+						const storage_type literal = literal_reader.next_literal();
+						result.append_literal((a_is_run) ? operation_type::apply(run_value, literal) : operation_type::apply(literal, run_value));
+					}
+				}
+
+				run_reader.skip_run_words(amount);
+			}
+			else
+			{
+				for (size_type amount = (a_reader.literal_words < b_reader.literal_words) ? a_reader.literal_words : b_reader.literal_words; amount != 0; --amount)
+				{
+					const storage_type a_literal = a_reader.next_literal();
+					result.append_literal(operation_type::apply(a_literal, b_reader.next_literal()));
+				}
+			}
+		}
+	}
+
+
+
+public:
+
+	PLF_CONSTFUNC ewah_bitset() PLF_NOEXCEPT:
+		total_size(0),
+		last_marker(std::numeric_limits<size_type>::max())
+	{}
+
+
+
+	// Compresses any bitset which supplies data() and size() with the same storage_type, eg. plf::bitset or plf::bitsetb:
+	template <class bitset_type>
+	PLF_CONSTFUNC explicit ewah_bitset(const bitset_type &source):
+		total_size(0),
+		last_marker(std::numeric_limits<size_type>::max())
+	{
+		append_words(source.data(), source.size());
+	}
+
+
+
+	// Streaming construction: appends number_of_bits bits from words to the end of the bitset. Runs of identical words are detected as they are appended. The current size must be a multiple of the storage_type bitwidth, ie. only the final append may end part-way through a word:
+	PLF_CONSTFUNC void append_words(const storage_type * const words, const size_type number_of_bits)
+	{
+		assert(total_size % PLF_TYPE_BITWIDTH == 0);
+
+		const size_type full_words = number_of_bits / PLF_TYPE_BITWIDTH, remainder = number_of_bits % PLF_TYPE_BITWIDTH;
+
+		for (size_type index = 0; index != full_words;)
+		{
+			const storage_type word = words[index];
+
+			if (word == 0 || word == std::numeric_limits<storage_type>::max())
+			{
+				size_type run_end = index + 1;
+				while (run_end != full_words && words[run_end] == word) ++run_end;
+				append_run(word != 0, run_end - index);
+				index = run_end;
+			}
+			else
+			{
+				append_literal(word);
+				++index;
+			}
+		}
+
+		if (remainder != 0) append_literal(words[full_words] & (std::numeric_limits<storage_type>::max() >> (PLF_TYPE_BITWIDTH - remainder)));
+		total_size += number_of_bits;
+	}
+
+
+
+	PLF_CONSTFUNC void clear() PLF_NOEXCEPT
+	{
+		stream.clear();
+		total_size = 0;
+		last_marker = std::numeric_limits<size_type>::max();
+	}
+
+
+
+	// Decompresses into any bitset which supplies data() and size() with the same storage_type - including a plf::bitsetb<true> over a user-supplied buffer - without an intermediate buffer. Bits in the destination beyond size() are reset:
+	template <class bitset_type>
+	PLF_CONSTFUNC void decompress(bitset_type &destination) const
+	{
+		if (destination.size() < total_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Destination smaller than *this, cannot decompress.");
+			#else
+				std::terminate();
+			#endif
+		}
+
+		storage_type *output = destination.data();
+
+		for (const storage_type *current = stream_begin(), * const end = stream_begin() + stream.size(); current != end;)
+		{
+			const storage_type marker = *current++;
+			const size_type literal_words = marker_literal_words(marker);
+
+			std::fill_n(output, marker_run_words(marker), run_word(marker_run_bit(marker)));
+			output = std::copy(current, current + literal_words, output + marker_run_words(marker));
+			current += literal_words;
+		}
+
+		std::fill(output, destination.data() + ((destination.size() + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH), storage_type(0));
+	}
+
+
+
+	PLF_CONSTFUNC bool test(const size_type index) const
+	{
+		size_type word_index = index / PLF_TYPE_BITWIDTH;
+
+		for (const storage_type *current = stream_begin(), * const end = stream_begin() + stream.size(); current != end;)
+		{
+			const storage_type marker = *current++;
+			const size_type run_words = marker_run_words(marker), literal_words = marker_literal_words(marker);
+
+			if (word_index < run_words) return marker_run_bit(marker);
+			word_index -= run_words;
+			if (word_index < literal_words) return static_cast<bool>((current[word_index] >> (index % PLF_TYPE_BITWIDTH)) & storage_type(1));
+			word_index -= literal_words;
+			current += literal_words;
+		}
+
+		return false;
+	}
+
+
+
+	PLF_CONSTFUNC bool operator [] (const size_type index) const
+	{
+		return test(index);
+	}
+
+
+
+	PLF_CONSTFUNC size_type count() const PLF_NOEXCEPT
+	{
+		size_type total = 0;
+
+		for (const storage_type *current = stream_begin(), * const end = stream_begin() + stream.size(); current != end;)
+		{
+			const storage_type marker = *current++;
+			if (marker_run_bit(marker)) total += marker_run_words(marker) * PLF_TYPE_BITWIDTH;
+
+			for (const storage_type * const literals_end = current + marker_literal_words(marker); current != literals_end; ++current)
+			{
+				total += plf::popcount<storage_type>(*current);
+			}
+		}
+
+		return total;
+	}
+
+
+
+	PLF_CONSTFUNC bool any() const PLF_NOEXCEPT
+	{
+		// Literals are never zero, so any literal or run of ones means a set bit:
+		for (const storage_type *current = stream_begin(), * const end = stream_begin() + stream.size(); current != end; current += marker_literal_words(*current) + 1)
+		{
+			if (marker_literal_words(*current) != 0 || (marker_run_bit(*current) && marker_run_words(*current) != 0)) return true;
+		}
+
+		return false;
+	}
+
+
+
+	PLF_CONSTFUNC bool none() const PLF_NOEXCEPT
+	{
+		return !any();
+	}
+
+
+
+	// Calls function(index) for every set bit, in ascending order. Runs of zeroes are skipped without being visited:
+	template <class function_type>
+	PLF_CONSTFUNC void for_each_one(function_type function) const
+	{
+		size_type base = 0;
+
+		for (const storage_type *current = stream_begin(), * const end = stream_begin() + stream.size(); current != end;)
+		{
+			const storage_type marker = *current++;
+			const size_type run_bits = marker_run_words(marker) * PLF_TYPE_BITWIDTH;
+
+			if (marker_run_bit(marker))
+			{
+				for (size_type index = base, run_end = base + run_bits; index != run_end; ++index) function(index);
+			}
+
+			base += run_bits;
+
+			for (const storage_type * const literals_end = current + marker_literal_words(marker); current != literals_end; ++current, base += PLF_TYPE_BITWIDTH)
+			{
+				for (storage_type word = *current; word != 0; word &= static_cast<storage_type>(word - 1))
+				{
+					function(base + static_cast<size_type>(plf::count_trailing_zeros(word)));
+				}
+			}
+		}
+	}
+
+
+
+	PLF_CONSTFUNC size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	// The compressed stream, for storage or transmission. It can be restored via assign_stream(). This is deliberately not named data(), so that an ewah_bitset cannot be passed to functions expecting an uncompressed bitset's data() and size():
+	PLF_CONSTFUNC const storage_type * compressed_data() const PLF_NOEXCEPT
+	{
+		return stream_begin();
+	}
+
+
+
+	PLF_CONSTFUNC size_type compressed_words() const PLF_NOEXCEPT
+	{
+		return stream.size();
+	}
+
+
+
+	PLF_CONSTFUNC size_type compressed_bytes() const PLF_NOEXCEPT
+	{
+		return stream.size() * sizeof(storage_type);
+	}
+
+
+
+	// Throws std::invalid_argument, leaving *this unchanged, if a marker's literal words run past number_of_words or the stream does not decode to exactly the storage_types needed for size bits:
+	PLF_CONSTFUNC void assign_stream(const storage_type * const words, const size_type number_of_words, const size_type size)
+	{
+		size_type marker_index = std::numeric_limits<size_type>::max(), decoded_words = 0;
+
+		for (size_type index = 0; index != number_of_words; index += marker_literal_words(words[index]) + 1)
+		{
+			if (marker_literal_words(words[index]) > (number_of_words - index) - 1) throw_invalid_stream();
+			decoded_words += marker_run_words(words[index]) + marker_literal_words(words[index]);
+			marker_index = index;
+		}
+
+		if (decoded_words != (size + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH) throw_invalid_stream();
+
+		stream.assign(words, words + number_of_words);
+		total_size = size;
+		last_marker = marker_index;
+	}
+
+
+
+	PLF_CONSTFUNC bool operator == (const ewah_bitset &source) const PLF_NOEXCEPT
+	{
+		return total_size == source.total_size && stream == source.stream;
+	}
+
+
+
+	PLF_CONSTFUNC bool operator != (const ewah_bitset &source) const PLF_NOEXCEPT
+	{
+		return !(*this == source);
+	}
+
+
+
+	PLF_CONSTFUNC ewah_bitset operator & (const ewah_bitset &source) const
+	{
+		ewah_bitset result;
+		combine<plf::and_operation>(*this, source, result);
+		return result;
+	}
+
+
+
+	PLF_CONSTFUNC ewah_bitset operator | (const ewah_bitset &source) const
+	{
+		ewah_bitset result;
+		combine<plf::or_operation>(*this, source, result);
+		return result;
+	}
+
+
+
+	PLF_CONSTFUNC ewah_bitset operator ^ (const ewah_bitset &source) const
+	{
+		ewah_bitset result;
+		combine<plf::xor_operation>(*this, source, result);
+		return result;
+	}
+
+
+
+	// *this & ~source:
+	PLF_CONSTFUNC ewah_bitset andnot(const ewah_bitset &source) const
+	{
+		ewah_bitset result;
+		combine<plf::andnot_operation>(*this, source, result);
+		return result;
+	}
+
+
+
+	PLF_CONSTFUNC ewah_bitset & operator &= (const ewah_bitset &source)
+	{
+		ewah_bitset result;
+		combine<plf::and_operation>(*this, source, result);
+		swap(result);
+		return *this;
+	}
+
+
+
+	PLF_CONSTFUNC ewah_bitset & operator |= (const ewah_bitset &source)
+	{
+		ewah_bitset result;
+		combine<plf::or_operation>(*this, source, result);
+		swap(result);
+		return *this;
+	}
+
+
+
+	PLF_CONSTFUNC ewah_bitset & operator ^= (const ewah_bitset &source)
+	{
+		ewah_bitset result;
+		combine<plf::xor_operation>(*this, source, result);
+		swap(result);
+		return *this;
+	}
+
+
+
+	PLF_CONSTFUNC void swap(ewah_bitset &source) PLF_NOEXCEPT
+	{
+		stream.swap(source.stream);
+		std::swap(total_size, source.total_size);
+		std::swap(last_marker, source.last_marker);
+	}
+};
+
+
+
+template <typename storage_type, class allocator_type>
+void swap (plf::ewah_bitset<storage_type, allocator_type> &a, plf::ewah_bitset<storage_type, allocator_type> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+
+} // plf namespace
+
+
+#undef PLF_CPP20_SUPPORT
+#undef PLF_CONSTFUNC
+#undef PLF_CONSTEXPR
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+
+#undef PLF_TYPE_BITWIDTH
+
+#endif // PLF_EWAH_BITSET_H
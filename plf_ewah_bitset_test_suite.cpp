@@ -0,0 +1,287 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include "plf_ewah_bitset.h"
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+struct index_collector
+{
+	std::vector<std::size_t> *indexes;
+
+	explicit index_collector(std::vector<std::size_t> &destination): indexes(&destination) {}
+
+	void operator () (const std::size_t index)
+	{
+		indexes->push_back(index);
+	}
+};
+
+
+
+// Detects a member named data() regardless of signature, so that the check works pre-C++11: &derived::data is only unambiguous if bitset_type has no data member of its own:
+struct data_fallback
+{
+	int data;
+};
+
+template <class bitset_type>
+struct data_detector : bitset_type, data_fallback {};
+
+template <typename member_type, member_type> struct member_check;
+
+template <class bitset_type>
+char (&data_test(member_check<int data_fallback::*, &data_detector<bitset_type>::data> *))[1];
+
+template <class bitset_type>
+char (&data_test(...))[2];
+
+template <class bitset_type>
+struct has_data
+{
+	static const bool value = sizeof(data_test<bitset_type>(0)) == 2;
+};
+
+
+
+// Fills with long runs of all-zero or all-one words broken up by occasional random literal words, as per typical log or audit bitmaps:
+template <class bitset_type>
+void fill_with_runs(bitset_type &values)
+{
+	values.reset();
+
+	for (std::size_t index = 0; index < values.size();)
+	{
+		const std::size_t length = 1 + static_cast<std::size_t>(rand() % 700);
+		const int kind = rand() % 4;
+
+		for (std::size_t end = (index + length < values.size()) ? index + length : values.size(); index != end; ++index)
+		{
+			if (kind == 0 || (kind == 1 && rand() % 3 == 0)) values.set(index);
+		}
+	}
+}
+
+
+
+template <typename storage_type>
+bool matches(const plf::ewah_bitset<storage_type> &compressed, const plf::bitsetb<false, storage_type> &expected)
+{
+	if (compressed.size() != expected.size() || compressed.count() != expected.count() || compressed.any() != expected.any()) return false;
+
+	for (std::size_t index = 0; index != expected.size(); ++index)
+	{
+		if (compressed[index] != expected[index]) return false;
+	}
+
+	std::vector<std::size_t> ones, expected_ones;
+	compressed.for_each_one(index_collector(ones));
+	for (std::size_t index = 0; index != expected.size(); ++index) if (expected[index]) expected_ones.push_back(index);
+
+	plf::bitsetb<false, storage_type> decompressed(expected.size());
+	decompressed.set();
+	compressed.decompress(decompressed);
+
+	return ones == expected_ones && decompressed == expected;
+}
+
+
+
+template <typename storage_type>
+bool random_operations_test(const std::size_t size)
+{
+	bool passed = true;
+
+	for (unsigned int round = 0; round != 6; ++round)
+	{
+		plf::bitsetb<false, storage_type> a(size), b(size);
+		fill_with_runs(a);
+		fill_with_runs(b);
+
+		if (round == 1) a.reset(); // include empty and full operands
+		if (round == 2) b.set();
+
+		const plf::ewah_bitset<storage_type> compressed_a(a), compressed_b(b);
+		passed = passed && matches(compressed_a, a) && matches(compressed_b, b);
+
+		plf::bitsetb<false, storage_type> expected(a);
+		expected &= b;
+		passed = passed && matches(compressed_a & compressed_b, expected) && (compressed_a & compressed_b) == plf::ewah_bitset<storage_type>(expected);
+
+		expected = a;
+		expected |= b;
+		passed = passed && matches(compressed_a | compressed_b, expected) && (compressed_a | compressed_b) == plf::ewah_bitset<storage_type>(expected);
+
+		expected = a;
+		expected ^= b;
+		passed = passed && matches(compressed_a ^ compressed_b, expected) && (compressed_a ^ compressed_b) == plf::ewah_bitset<storage_type>(expected);
+
+		plf::bitsetb<false, storage_type> not_b(~b);
+		expected = a;
+		expected &= not_b;
+		passed = passed && matches(compressed_a.andnot(compressed_b), expected) && matches(compressed_b.andnot(compressed_b), plf::bitsetb<false, storage_type>(size));
+
+		plf::ewah_bitset<storage_type> compound(compressed_a);
+		compound |= compressed_b;
+		compound &= compressed_a;
+		passed = passed && compound == compressed_a; // absorption law
+	}
+
+	return passed;
+}
+
+
+
+
+
+int main()
+{
+	srand(9);
+
+	{
+		message("Compression tests\n==================================\n\n");
+
+		plf::bitsetb<> values(1000000);
+		values.set_range(1000, 400000);
+		values.set(500000);
+		values.set_range(700001, 700003);
+
+		const plf::ewah_bitset<> compressed(values);
+		failpass("Run compression test", compressed.compressed_words() <= 8 && compressed.compressed_bytes() * 100 < (1000000 / 8));
+		failpass("Count test", compressed.count() == values.count() && compressed.size() == 1000000);
+		failpass("Test test", compressed[1000] && compressed[399999] && !compressed[400000] && !compressed[999] && compressed[500000] && compressed.test(700002) && !compressed.test(700003));
+
+		std::vector<std::size_t> storage((1000000 + 63) / 64);
+		storage[3] = 17;
+		plf::bitsetb<true> borrowed(1000000, &storage[0]);
+		compressed.decompress(borrowed);
+		failpass("Decompress into user-supplied buffer test", std::equal(values.data(), values.data() + storage.size(), borrowed.data()) && borrowed.count() == values.count() && storage[3] == 0);
+
+		plf::ewah_bitset<> empty;
+		failpass("Empty test", empty.none() && empty.count() == 0 && empty.size() == 0 && empty.compressed_words() == 0);
+
+		plf::bitsetb<> too_small(999999);
+		bool length_error_thrown = false;
+
+		try
+		{
+			compressed.decompress(too_small);
+		}
+		catch (std::length_error &)
+		{
+			length_error_thrown = true;
+		}
+
+		failpass("Decompress size test", length_error_thrown);
+	}
+
+
+	{
+		message("Streaming construction tests\n==================================\n\n");
+
+		plf::bitsetb<> values(64 * 1000 + 37);
+		fill_with_runs(values);
+
+		// Append in uneven multiples of the word size, with only the final chunk ending part-way through a word:
+		plf::ewah_bitset<> streamed;
+		std::size_t word_index = 0;
+
+		for (std::size_t chunk = 1; word_index + chunk < 1000; word_index += chunk, chunk = chunk * 2 + 1)
+		{
+			streamed.append_words(values.data() + word_index, chunk * 64);
+		}
+
+		streamed.append_words(values.data() + word_index, values.size() - (word_index * 64));
+		failpass("Chunked append test", streamed == plf::ewah_bitset<>(values) && matches(streamed, values));
+
+		plf::ewah_bitset<> restored;
+		restored.assign_stream(streamed.compressed_data(), streamed.compressed_words(), streamed.size());
+		failpass("assign_stream test", restored == streamed && matches(restored, values));
+
+		const std::size_t overrunning_stream[2] = { ~std::size_t(0), 0 }; // marker claims more literal words than the stream holds
+		bool overrun_thrown = false, size_mismatch_thrown = false;
+
+		try
+		{
+			restored.assign_stream(overrunning_stream, 2, 64);
+		}
+		catch (std::invalid_argument &)
+		{
+			overrun_thrown = true;
+		}
+
+		try
+		{
+			restored.assign_stream(streamed.compressed_data(), streamed.compressed_words(), streamed.size() + 64);
+		}
+		catch (std::invalid_argument &)
+		{
+			size_mismatch_thrown = true;
+		}
+
+		failpass("Invalid assign_stream test", overrun_thrown && size_mismatch_thrown && restored == streamed);
+
+		restored.clear();
+		failpass("Clear test", restored.size() == 0 && restored.none());
+
+		// data()/size() would be read as an uncompressed bitset by the generic functions (intersects, bitwise_or, copy_bits etc), so ewah_bitset must not have data():
+		failpass("No data() test", !has_data<plf::ewah_bitset<> >::value && has_data<plf::bitsetb<> >::value);
+
+	}
+
+
+	{
+		message("Compressed-domain operation tests\n==================================\n\n");
+
+		failpass("unsigned long long operations test", random_operations_test<unsigned long long>(64 * 300 + 5));
+		failpass("unsigned int operations test", random_operations_test<unsigned int>(32 * 500));
+		failpass("unsigned char operations test (run and literal count limits)", random_operations_test<unsigned char>(8 * 3000 + 3));
+
+		plf::ewah_bitset<> a(plf::bitsetb<>(100)), b(plf::bitsetb<>(101));
+		bool length_error_thrown = false;
+
+		try
+		{
+			a &= b;
+		}
+		catch (std::length_error &)
+		{
+			length_error_thrown = true;
+		}
+
+		failpass("Operand size test", length_error_thrown);
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
@@ -0,0 +1,346 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_HUGE_PAGE_ALLOCATOR_H
+#define PLF_HUGE_PAGE_ALLOCATOR_H
+
+
+#include "plf_bitsetb.h"
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#elif defined(__clang__)
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#else // Assume support for other compilers
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+#endif
+
+
+#if defined(__linux__)
+	#include <sys/mman.h> // mmap, munmap, madvise
+	#include <sys/syscall.h> // SYS_mbind, SYS_get_mempolicy - called directly, so that libnuma is not required
+	#include <unistd.h> // syscall
+	#define PLF_HUGE_PAGE_MMAP_SUPPORT
+#endif
+
+
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <new> // std::bad_alloc, placement new
+#include <limits>  // std::numeric_limits
+
+
+
+namespace plf
+{
+
+
+// Largest page size to request. Requests fall back to the next option down if the system can't supply them, ending with ordinary pages:
+enum huge_page_type
+{
+	transparent_huge_pages, // 2MB-aligned ordinary mapping with madvise(MADV_HUGEPAGE), which the kernel backs with 2MB pages when it can (no reservation needed)
+	huge_pages_2mb, // explicitly reserved 2MB pages via MAP_HUGETLB, falling back to transparent_huge_pages
+	huge_pages_1gb // explicitly reserved 1GB pages via MAP_HUGETLB, for allocations of at least 1GB, falling back to huge_pages_2mb
+};
+
+
+// Values match the Linux kernel's MPOL_* constants:
+enum numa_policy_type
+{
+	numa_default = 0, // the calling thread's policy, normally first-touch
+	numa_preferred = 1, // allocate on the first node in numa_nodes if possible
+	numa_bind = 2, // allocate only on the nodes in numa_nodes
+	numa_interleave = 3 // spread pages round-robin over the nodes in numa_nodes, so that threads on every node scanning the bitset share the bandwidth of all nodes
+};
+
+
+
+namespace huge_page_detail
+{
+	const std::size_t two_megabytes = std::size_t(1) << 21;
+
+
+	// The page size used for an allocation of bytes, or 0 if it is too small to be worth a separate mapping - a small allocation (eg. the result of operator & on a small bitset) would otherwise take up at least a whole 2MB page. As this depends only on bytes and the page type, deallocate() makes the same decision as allocate() did:
+	inline std::size_t page_size(const std::size_t bytes, const huge_page_type page_type) PLF_NOEXCEPT
+	{
+		if (page_type == huge_pages_1gb && sizeof(std::size_t) >= 8 && bytes >= (std::size_t(1) << 30)) return std::size_t(1) << 30;
+		return (bytes >= two_megabytes) ? two_megabytes : 0;
+	}
+
+
+
+	inline std::size_t mapping_length(const std::size_t bytes, const std::size_t page_bytes) PLF_NOEXCEPT
+	{
+		return ((bytes + page_bytes - 1) / page_bytes) * page_bytes;
+	}
+
+
+
+	#ifdef PLF_HUGE_PAGE_MMAP_SUPPORT
+		// Failure leaves the default policy in place, eg. on kernels without NUMA support or in containers which disallow mbind:
+		inline void apply_numa_policy(void * const address, const std::size_t length, const numa_policy_type policy, unsigned long nodes) PLF_NOEXCEPT
+		{
+			if (policy == numa_default) return;
+
+			const unsigned long mask_bits = sizeof(unsigned long) * 8;
+
+			if (nodes == 0 && syscall(SYS_get_mempolicy, NULL, &nodes, mask_bits + 1, NULL, 4) != 0) return; // 4 == MPOL_F_MEMS_ALLOWED ie. every node this process may use
+
+			syscall(SYS_mbind, address, length, static_cast<int>(policy), &nodes, mask_bits + 1, 0); // + 1 because the kernel reads maxnode - 1 bits
+		}
+
+
+
+		inline void * map(const std::size_t length, const std::size_t page_bytes, const huge_page_type page_type, const numa_policy_type policy, const unsigned long nodes) PLF_NOEXCEPT
+		{
+			#ifdef MAP_HUGETLB
+				if (page_type != transparent_huge_pages)
+				{
+					#ifdef MAP_HUGE_SHIFT
+						// 1GB pages fall back to explicit 2MB pages - length is a multiple of 1GB, so also of 2MB:
+						const int size_flags[2] = { ((page_bytes == two_megabytes) ? 21 : 30) << MAP_HUGE_SHIFT, 21 << MAP_HUGE_SHIFT };
+						const int number_of_attempts = (page_bytes == two_megabytes) ? 1 : 2;
+					#else
+						const int size_flags[1] = { 0 }; // system default huge page size
+						const int number_of_attempts = 1;
+					#endif
+
+					for (int attempt = 0; attempt != number_of_attempts; ++attempt)
+					{
+						void * const address = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | size_flags[attempt], -1, 0);
+
+						if (address != MAP_FAILED)
+						{
+							apply_numa_policy(address, length, policy, nodes); // before any page is touched, as policy only affects pages allocated after it is set
+							return address;
+						}
+					}
+				}
+			#endif
+
+			// Fall back to an ordinary mapping, over-allocated then trimmed so that it starts on a 2MB boundary - transparent huge pages can only back 2MB-aligned regions:
+			char * const unaligned = static_cast<char *>(mmap(NULL, length + two_megabytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+			if (static_cast<void *>(unaligned) == MAP_FAILED) return NULL;
+
+			const std::size_t head = (two_megabytes - (reinterpret_cast<std::size_t>(unaligned) % two_megabytes)) % two_megabytes;
+			char * const address = unaligned + head;
+
+			if (head != 0) munmap(unaligned, head);
+			munmap(address + length, two_megabytes - head);
+
+			#ifdef MADV_HUGEPAGE
+				madvise(address, length, MADV_HUGEPAGE);
+			#endif
+
+			apply_numa_policy(address, length, policy, nodes);
+			return address;
+		}
+	#endif
+}
+
+
+
+// An allocator for large buffers which requests huge pages and an optional NUMA placement policy, eg. as the allocator_type for plf::bitsetb (see plf::huge_page_bitsetb below). Scanning a bitmap of many GB with 4KB pages takes a TLB miss every 32768 bits; with 2MB pages, every 16 million.
+// Allocations smaller than 2MB use operator new, as do all allocations on platforms other than Linux. All other allocations are separate mmap() mappings, so are best suited to a few large buffers rather than many small ones.
+// numa_nodes is a bitmask of node numbers (bit 0 == node 0) for numa_preferred/bind/interleave, where 0 means every node the process is allowed to use. The policies are template parameters rather than constructor arguments because plf::bitsetb default-constructs its allocator:
+template <class element_type, huge_page_type page_type = huge_pages_2mb, numa_policy_type numa_policy = numa_default, unsigned long numa_nodes = 0>
+class huge_page_allocator
+{
+public:
+	typedef element_type				value_type;
+	typedef element_type *			pointer;
+	typedef const element_type *	const_pointer;
+	typedef element_type &			reference;
+	typedef const element_type &	const_reference;
+	typedef std::size_t				size_type;
+	typedef std::ptrdiff_t			difference_type;
+
+	template <class other_type>
+	struct rebind
+	{
+		typedef huge_page_allocator<other_type, page_type, numa_policy, numa_nodes> other;
+	};
+
+
+
+	huge_page_allocator() PLF_NOEXCEPT {}
+
+	template <class other_type>
+	huge_page_allocator(const huge_page_allocator<other_type, page_type, numa_policy, numa_nodes> &) PLF_NOEXCEPT {}
+
+
+
+	pointer allocate(const size_type number_of_elements, const void * = NULL)
+	{
+		if (number_of_elements > max_size())
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::bad_alloc();
+			#else
+				std::terminate();
+			#endif
+		}
+
+		const size_type bytes = number_of_elements * sizeof(element_type);
+		void *address;
+
+		#ifdef PLF_HUGE_PAGE_MMAP_SUPPORT
+			const size_type page_bytes = huge_page_detail::page_size(bytes, page_type);
+
+			if (page_bytes != 0)
+			{
+				address = huge_page_detail::map(huge_page_detail::mapping_length(bytes, page_bytes), page_bytes, page_type, numa_policy, numa_nodes);
+
+				if (address == NULL)
+				{
+					#ifdef PLF_EXCEPTIONS_SUPPORT
+						throw std::bad_alloc();
+					#else
+						std::terminate();
+					#endif
+				}
+
+				return static_cast<pointer>(address);
+			}
+		#endif
+
+		address = ::operator new(bytes);
+		return static_cast<pointer>(address);
+	}
+
+
+
+	void deallocate(const pointer location, const size_type number_of_elements) PLF_NOEXCEPT
+	{
+		if (location == NULL) return;
+
+		#ifdef PLF_HUGE_PAGE_MMAP_SUPPORT
+			const size_type bytes = number_of_elements * sizeof(element_type), page_bytes = huge_page_detail::page_size(bytes, page_type);
+
+			if (page_bytes != 0)
+			{
+				munmap(location, huge_page_detail::mapping_length(bytes, page_bytes));
+				return;
+			}
+		#else
+			(void)number_of_elements;
+		#endif
+
+		::operator delete(location);
+	}
+
+
+
+	size_type max_size() const PLF_NOEXCEPT
+	{
+		return std::numeric_limits<size_type>::max() / sizeof(element_type);
+	}
+
+
+
+	// C++03 allocator requirements:
+	pointer address(reference value) const PLF_NOEXCEPT
+	{
+		return &value;
+	}
+
+
+
+	const_pointer address(const_reference value) const PLF_NOEXCEPT
+	{
+		return &value;
+	}
+
+
+
+	void construct(const pointer location, const_reference value)
+	{
+		::new (static_cast<void *>(location)) element_type(value);
+	}
+
+
+
+	void destroy(const pointer location)
+	{
+		location->~element_type();
+	}
+};
+
+
+
+// Stateless, so any two instances are interchangeable:
+template <class a_type, class b_type, huge_page_type page_type, numa_policy_type numa_policy, unsigned long numa_nodes>
+bool operator == (const huge_page_allocator<a_type, page_type, numa_policy, numa_nodes> &, const huge_page_allocator<b_type, page_type, numa_policy, numa_nodes> &) PLF_NOEXCEPT
+{
+	return true;
+}
+
+
+template <class a_type, class b_type, huge_page_type page_type, numa_policy_type numa_policy, unsigned long numa_nodes>
+bool operator != (const huge_page_allocator<a_type, page_type, numa_policy, numa_nodes> &, const huge_page_allocator<b_type, page_type, numa_policy, numa_nodes> &) PLF_NOEXCEPT
+{
+	return false;
+}
+
+
+
+// Type generator for a plf::bitsetb which allocates via huge_page_allocator, ie. plf::huge_page_bitsetb<>::type values(size) or plf::huge_page_bitsetb<std::size_t, plf::huge_pages_2mb, plf::numa_interleave>::type shared(size). The results of operator &, | and ^ on these use the same allocator:
+template <typename storage_type = std::size_t, huge_page_type page_type = huge_pages_2mb, numa_policy_type numa_policy = numa_default, unsigned long numa_nodes = 0, bool hardened = false>
+struct huge_page_bitsetb
+{
+	typedef bitsetb<false, storage_type, huge_page_allocator<storage_type, page_type, numa_policy, numa_nodes>, hardened> type;
+};
+
+
+} // plf namespace
+
+
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+
+#undef PLF_HUGE_PAGE_MMAP_SUPPORT
+
+#endif // PLF_HUGE_PAGE_ALLOCATOR_H
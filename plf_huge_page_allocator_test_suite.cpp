@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "plf_huge_page_allocator.h"
+
+#ifdef __linux__
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+bool is_aligned(const void * const location, const std::size_t alignment)
+{
+	#ifdef __linux__
+		return reinterpret_cast<std::size_t>(location) % alignment == 0;
+	#else
+		(void)location;
+		(void)alignment;
+		return true; // operator new is used elsewhere
+	#endif
+}
+
+
+
+// The NUMA policy of the page at location, or -1 if unavailable (eg. mbind/get_mempolicy are not permitted, or not Linux):
+int numa_policy_of(void * const location)
+{
+	#ifdef __linux__
+		int policy = -1;
+		unsigned long nodes = 0;
+		if (syscall(SYS_get_mempolicy, &policy, &nodes, sizeof(unsigned long) * 8 + 1, location, 2) != 0) return -1; // 2 == MPOL_F_ADDR
+		return policy;
+	#else
+		(void)location;
+		return -1;
+	#endif
+}
+
+
+
+template <class bitset_type>
+bool bitset_operations_test(const std::size_t size)
+{
+	bitset_type a(size), b(size);
+	a.set_range(size / 4, size / 2);
+	b.set_range(size / 3, size);
+	b.reset(size - 1);
+
+	const bitset_type intersection = a & b;
+	bitset_type copy(intersection);
+
+	return a.count() == size / 2 - size / 4 && b.count() == size - size / 3 - 1 && intersection.count() == size / 2 - size / 3 && copy == intersection && copy.first_one() == size / 3 && b.last_one() == size - 2;
+}
+
+
+
+
+
+int main()
+{
+	{
+		message("Bitset tests\n==================================\n\n");
+
+		failpass("Small bitset test", bitset_operations_test<plf::huge_page_bitsetb<>::type>(1000) && bitset_operations_test<plf::huge_page_bitsetb<unsigned char>::type>(10007));
+		failpass("Large bitset test", bitset_operations_test<plf::huge_page_bitsetb<>::type>(100000007) && bitset_operations_test<plf::huge_page_bitsetb<unsigned int, plf::transparent_huge_pages>::type>(50000003));
+		failpass("1GB page type fallback test", bitset_operations_test<plf::huge_page_bitsetb<std::size_t, plf::huge_pages_1gb>::type>(30000001));
+
+		plf::huge_page_bitsetb<>::type values(16777216 * 3);
+		failpass("Huge page alignment test", is_aligned(values.data(), 2097152) && values.none());
+
+		values.change_size(16777216 * 5);
+		values.set(16777216 * 5 - 1);
+		failpass("Resize test", is_aligned(values.data(), 2097152) && values.count() == 1 && values.last_one() == 16777216 * 5 - 1);
+	}
+
+
+	{
+		message("Allocator tests\n==================================\n\n");
+
+		std::vector<int, plf::huge_page_allocator<int> > numbers(1000000, 5);
+		numbers.push_back(6);
+		failpass("Standard container test", numbers.size() == 1000001 && numbers[999999] == 5 && numbers.back() == 6 && is_aligned(&numbers[0], 2097152));
+
+		plf::huge_page_allocator<int> int_allocator;
+		plf::huge_page_allocator<char> char_allocator(int_allocator);
+		failpass("Rebind and equality test", int_allocator == char_allocator && !(int_allocator != char_allocator));
+
+		const std::size_t small_size = 100, large_size = 3000000;
+		int * const small = int_allocator.allocate(small_size), * const large = int_allocator.allocate(large_size);
+		small[small_size - 1] = 1;
+		large[large_size - 1] = 2;
+		failpass("Direct allocate test", small[small_size - 1] == 1 && large[large_size - 1] == 2 && is_aligned(large, 2097152));
+		int_allocator.deallocate(small, small_size);
+		int_allocator.deallocate(large, large_size);
+		if (sizeof(std::size_t) >= 8)
+		{
+			// Exercises the 1GB -> explicit 2MB -> transparent huge page fallback chain. Only the touched pages are committed:
+			plf::huge_page_allocator<char, plf::huge_pages_1gb> gigabyte_allocator;
+			const std::size_t gigabyte = std::size_t(1) << 30;
+			char * const block = gigabyte_allocator.allocate(gigabyte);
+			block[0] = 1;
+			block[gigabyte - 1] = 2;
+			failpass("1GB allocation test", block[0] == 1 && block[gigabyte - 1] == 2 && is_aligned(block, 2097152));
+			gigabyte_allocator.deallocate(block, gigabyte);
+		}
+
+	}
+
+
+	{
+		message("NUMA policy tests\n==================================\n\n");
+
+		plf::huge_page_bitsetb<std::size_t, plf::huge_pages_2mb, plf::numa_interleave>::type interleaved(100000000);
+		plf::huge_page_bitsetb<std::size_t, plf::transparent_huge_pages, plf::numa_bind, 1>::type bound(100000000);
+		plf::huge_page_bitsetb<std::size_t, plf::huge_pages_2mb, plf::numa_preferred, 1>::type preferred(100000000);
+
+		interleaved.set();
+		bound.flip();
+		preferred.set_range(0, 99999999);
+		failpass("Policy bitset operation test", interleaved.count() == 100000000 && bound.all() && preferred.count() == 99999999);
+
+		const int interleaved_policy = numa_policy_of(interleaved.data()), bound_policy = numa_policy_of(bound.data()), preferred_policy = numa_policy_of(preferred.data());
+
+		if (interleaved_policy == -1)
+		{
+			message("get_mempolicy unavailable, skipping policy checks");
+		}
+		else
+		{
+			// mbind may be refused (eg. in a container), in which case the policy stays at the default:
+			failpass("Policy applied test", (interleaved_policy == plf::numa_interleave || interleaved_policy == plf::numa_default) && (bound_policy == plf::numa_bind || bound_policy == plf::numa_default) && (preferred_policy == plf::numa_preferred || preferred_policy == plf::numa_default));
+			printf("Policies: interleave %d, bind %d, preferred %d\n", interleaved_policy, bound_policy, preferred_policy);
+		}
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
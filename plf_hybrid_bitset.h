@@ -0,0 +1,1120 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_HYBRID_BITSET_H
+#define PLF_HYBRID_BITSET_H
+
+
+#include "plf_bitsetb.h" // dense representation
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+#define PLF_CONSTEXPR
+#define PLF_CONSTFUNC
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1600
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+	#endif
+
+	#if _MSC_VER >= 1700
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+	#endif
+
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L) && _MSC_VER >= 1929
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+	#endif
+
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 3) || __GNUC__ > 4
+			#define PLF_MOVE_SEMANTICS_SUPPORT
+		#endif
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 7) || __GNUC__ > 4
+			#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#endif
+	#elif defined(__clang__)
+		#if !defined(__GLIBCXX__) && !defined(_LIBCPP_CXX03_LANG) && __clang_major__ >= 3
+			#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#endif
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+		#if __has_feature(cxx_rvalue_references) && !defined(_LIBCPP_HAS_NO_RVALUE_REFERENCES)
+			#define PLF_MOVE_SEMANTICS_SUPPORT
+		#endif
+	#else // Assume support for other compilers
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	// constexpr std::vector is required, as per plf::bitsetb's requirement for constexpr basic_string:
+	#if __cplusplus >= 202001L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) &&	_GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+	#endif
+#endif
+
+
+
+#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+	#define PLF_ALLOCATE(the_allocator, allocator_instance, size, hint)			std::allocator_traits<the_allocator>::allocate(allocator_instance, size, hint)
+	#define PLF_DEALLOCATE(the_allocator, allocator_instance, location, size)	std::allocator_traits<the_allocator>::deallocate(allocator_instance, location, size)
+	#define PLF_CONSTRUCT(the_allocator, allocator_instance, location, ...)		std::allocator_traits<the_allocator>::construct(allocator_instance, location, __VA_ARGS__)
+	#define PLF_DESTROY(the_allocator, allocator_instance, location)				std::allocator_traits<the_allocator>::destroy(allocator_instance, location)
+#else
+	#define PLF_ALLOCATE(the_allocator, allocator_instance, size, hint)			(allocator_instance).allocate(size, hint)
+	#define PLF_DEALLOCATE(the_allocator, allocator_instance, location, size)	(allocator_instance).deallocate(location, size)
+	#define PLF_CONSTRUCT(the_allocator, allocator_instance, location, argument)	::new (static_cast<void *>(location)) typename the_allocator::value_type(argument) // the C++03 construct() can only copy, which would mean an extra allocation
+	#define PLF_DESTROY(the_allocator, allocator_instance, location)				(allocator_instance).destroy(location)
+#endif
+
+
+#include <vector>
+#include <memory> // std::allocator
+#include <new> // placement new
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <limits>  // std::numeric_limits
+#include <algorithm> // std::lower_bound, std::set_union, std::set_symmetric_difference
+#include <iterator> // std::back_inserter
+
+
+
+namespace plf
+{
+
+
+// A bitset with the core of the plf::bitsetb API (see README for what is not provided) which stores either a sorted vector of the indexes of its set bits (sparse) or plain storage_type words (dense), and converts between the two automatically as its population changes:
+template<typename storage_type = std::size_t, class allocator_type = std::allocator<storage_type>, bool hardened = false>
+class hybrid_bitset : private allocator_type // Empty base class optimisation - inheriting allocator functions
+{
+private:
+	typedef std::size_t size_type;
+	typedef plf::bitsetb<false, storage_type, allocator_type, false> dense_type; // bounds-checking is done here rather than in the dense representation
+
+	#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<size_type>	index_allocator_type;
+		typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<dense_type>	dense_allocator_type;
+	#else
+		typedef typename allocator_type::template rebind<size_type>::other	index_allocator_type;
+		typedef typename allocator_type::template rebind<dense_type>::other	dense_allocator_type;
+	#endif
+
+	typedef std::vector<size_type, index_allocator_type> index_vector;
+	typedef typename index_vector::iterator index_iterator;
+	typedef typename index_vector::const_iterator const_index_iterator;
+
+	index_vector indexes; // sorted indexes of set bits while sparse, empty while dense
+	dense_type *dense; // NULL while sparse
+	size_type total_size, total_count; // total_count is only maintained while dense
+
+
+
+	// A sparse set costs one size_type per set bit, so it becomes dense once that exceeds the cost of the dense words. It only becomes sparse again once the count drops to a quarter of that, so that sets hovering around the threshold don't convert back and forth on every change:
+	PLF_CONSTFUNC size_type dense_threshold() const PLF_NOEXCEPT
+	{
+		return total_size / (sizeof(size_type) * 8);
+	}
+
+
+
+	PLF_CONSTFUNC size_type sparse_threshold() const PLF_NOEXCEPT
+	{
+		return dense_threshold() / 4;
+	}
+
+
+
+	PLF_CONSTFUNC dense_type * allocate_dense(const dense_type * const source)
+	{
+		dense_allocator_type dense_allocator(*this);
+		dense_type * const new_dense = PLF_ALLOCATE(dense_allocator_type, dense_allocator, 1, NULL);
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				if (source == NULL)
+				{
+					PLF_CONSTRUCT(dense_allocator_type, dense_allocator, new_dense, total_size);
+				}
+				else
+				{
+					PLF_CONSTRUCT(dense_allocator_type, dense_allocator, new_dense, *source);
+				}
+			}
+			catch (...)
+			{
+				PLF_DEALLOCATE(dense_allocator_type, dense_allocator, new_dense, 1);
+				throw;
+			}
+		#else
+			if (source == NULL)
+			{
+				PLF_CONSTRUCT(dense_allocator_type, dense_allocator, new_dense, total_size);
+			}
+			else
+			{
+				PLF_CONSTRUCT(dense_allocator_type, dense_allocator, new_dense, *source);
+			}
+		#endif
+
+		return new_dense;
+	}
+
+
+
+	PLF_CONSTFUNC void deallocate_dense() PLF_NOEXCEPT
+	{
+		if (dense != NULL)
+		{
+			dense_allocator_type dense_allocator(*this);
+			PLF_DESTROY(dense_allocator_type, dense_allocator, dense);
+			PLF_DEALLOCATE(dense_allocator_type, dense_allocator, dense, 1);
+			dense = NULL;
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void make_dense()
+	{
+		dense = allocate_dense(NULL);
+
+		for (const_index_iterator current = indexes.begin(); current != indexes.end(); ++current)
+		{
+			dense->set(*current);
+		}
+
+		total_count = indexes.size();
+		index_vector(indexes.get_allocator()).swap(indexes); // release the memory as well as the contents
+	}
+
+
+
+	PLF_CONSTFUNC void make_sparse()
+	{
+		index_vector new_indexes(indexes.get_allocator());
+		new_indexes.reserve(total_count);
+
+		for (size_type index = dense->first_one(); index != std::numeric_limits<size_type>::max(); index = dense->next_one(index + 1))
+		{
+			new_indexes.push_back(index);
+		}
+
+		indexes.swap(new_indexes);
+		deallocate_dense();
+	}
+
+
+
+	PLF_CONSTFUNC void update_representation()
+	{
+		if (dense == NULL)
+		{
+			if (indexes.size() > dense_threshold()) make_dense();
+		}
+		else if (total_count < sparse_threshold())
+		{
+			make_sparse();
+		}
+	}
+
+
+
+	PLF_CONSTFUNC bool contains(const size_type index) const
+	{
+		return (dense != NULL) ? (*dense)[index] : std::binary_search(indexes.begin(), indexes.end(), index);
+	}
+
+
+
+	PLF_CONSTFUNC void check_index_is_within_size(const size_type index) const
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			if (index >= total_size)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Index larger than size of bitset");
+				#else
+					std::terminate();
+				#endif
+			}
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void check_range_is_within_size(const size_type begin, const size_type end) const
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			if (begin > end || end > total_size)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::out_of_range("Range larger than size of bitset");
+				#else
+					std::terminate();
+				#endif
+			}
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void check_source_size_is_equal(const size_type source_size) const
+	{
+		if (source_size != total_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Source size is not equal to size of *this.");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+public:
+
+	PLF_CONSTFUNC explicit hybrid_bitset(const size_type size):
+		dense(NULL),
+		total_size(size),
+		total_count(0)
+	{}
+
+
+
+	PLF_CONSTFUNC hybrid_bitset(const hybrid_bitset &source):
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+			allocator_type(std::allocator_traits<allocator_type>::select_on_container_copy_construction(source)),
+		#else
+			allocator_type(source),
+		#endif
+		indexes(source.indexes.begin(), source.indexes.end(), index_allocator_type(*this)),
+		dense(NULL),
+		total_size(source.total_size),
+		total_count(source.total_count)
+	{
+		if (source.dense != NULL) dense = allocate_dense(source.dense);
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		PLF_CONSTFUNC hybrid_bitset(hybrid_bitset &&source) PLF_NOEXCEPT:
+			allocator_type(source),
+			indexes(std::move(source.indexes)),
+			dense(source.dense),
+			total_size(source.total_size),
+			total_count(source.total_count)
+		{
+			source.dense = NULL;
+			source.total_size = 0;
+			source.total_count = 0;
+		}
+	#endif
+
+
+
+	PLF_CONSTFUNC ~hybrid_bitset() PLF_NOEXCEPT
+	{
+		deallocate_dense();
+	}
+
+
+
+	PLF_CONSTFUNC hybrid_bitset & operator = (const hybrid_bitset &source)
+	{
+		if (&source != this)
+		{
+			hybrid_bitset temp(source);
+			swap(temp);
+		}
+
+		return *this;
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		PLF_CONSTFUNC hybrid_bitset & operator = (hybrid_bitset &&source) PLF_NOEXCEPT
+		{
+			assert(&source != this);
+
+			deallocate_dense();
+			indexes = std::move(source.indexes);
+			dense = source.dense;
+			total_size = source.total_size;
+			total_count = source.total_count;
+			source.dense = NULL;
+			source.total_size = 0;
+			source.total_count = 0;
+			return *this;
+		}
+	#endif
+
+
+
+	PLF_CONSTFUNC bool operator [] (const size_type index) const
+	{
+		check_index_is_within_size(index);
+		return contains(index);
+	}
+
+
+
+	PLF_CONSTFUNC bool test(const size_type index) const
+	{
+		return operator [](index);
+	}
+
+
+
+	PLF_CONSTFUNC bool is_sparse() const PLF_NOEXCEPT
+	{
+		return dense == NULL;
+	}
+
+
+
+	PLF_CONSTFUNC void set()
+	{
+		if (total_size == 0) return;
+		if (dense == NULL) make_dense();
+
+		dense->set();
+		total_count = total_size;
+	}
+
+
+
+	// While sparse this is a sorted insert into the index vector, ie. O(number of set bits):
+	PLF_CONSTFUNC void set(const size_type index)
+	{
+		check_index_is_within_size(index);
+
+		if (dense == NULL)
+		{
+			const index_iterator location = std::lower_bound(indexes.begin(), indexes.end(), index);
+
+			if (location == indexes.end() || *location != index)
+			{
+				indexes.insert(location, index);
+				update_representation();
+			}
+		}
+		else if (!(*dense)[index])
+		{
+			dense->set(index);
+			++total_count;
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void set(const size_type index, const bool value)
+	{
+		if (value)
+		{
+			set(index);
+		}
+		else
+		{
+			reset(index);
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void set_range(const size_type begin, const size_type end)
+	{
+		check_range_is_within_size(begin, end);
+		if (begin == end) return;
+
+		if (dense == NULL)
+		{
+			const index_iterator first = std::lower_bound(indexes.begin(), indexes.end(), begin), last = std::lower_bound(first, indexes.end(), end);
+
+			if ((indexes.size() - static_cast<size_type>(last - first)) + (end - begin) <= dense_threshold())
+			{
+				const size_type offset = static_cast<size_type>(first - indexes.begin());
+				indexes.insert(indexes.erase(first, last), end - begin, size_type());
+
+				for (size_type index = begin; index != end; ++index)
+				{
+					indexes[offset + (index - begin)] = index;
+				}
+
+				return;
+			}
+
+			make_dense();
+		}
+
+		total_count += (end - begin) - dense->count_range(begin, end);
+		dense->set_range(begin, end);
+	}
+
+
+
+	PLF_CONSTFUNC void set_range(const size_type begin, const size_type end, const bool value)
+	{
+		if (value)
+		{
+			set_range(begin, end);
+		}
+		else
+		{
+			reset_range(begin, end);
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void reset() PLF_NOEXCEPT
+	{
+		deallocate_dense();
+		indexes.clear();
+		total_count = 0;
+	}
+
+
+
+	PLF_CONSTFUNC void reset(const size_type index)
+	{
+		check_index_is_within_size(index);
+
+		if (dense == NULL)
+		{
+			const index_iterator location = std::lower_bound(indexes.begin(), indexes.end(), index);
+			if (location != indexes.end() && *location == index) indexes.erase(location);
+		}
+		else if ((*dense)[index])
+		{
+			dense->reset(index);
+			--total_count;
+			update_representation();
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void reset_range(const size_type begin, const size_type end)
+	{
+		check_range_is_within_size(begin, end);
+		if (begin == end) return;
+
+		if (dense == NULL)
+		{
+			const index_iterator first = std::lower_bound(indexes.begin(), indexes.end(), begin);
+			indexes.erase(first, std::lower_bound(first, indexes.end(), end));
+		}
+		else
+		{
+			total_count -= dense->count_range(begin, end);
+			dense->reset_range(begin, end);
+			update_representation();
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void flip()
+	{
+		if (total_size == 0) return;
+		if (dense == NULL) make_dense(); // the complement of a sparse set is never sparse
+
+		dense->flip();
+		total_count = total_size - total_count;
+		update_representation();
+	}
+
+
+
+	PLF_CONSTFUNC void flip(const size_type index)
+	{
+		if (operator [](index))
+		{
+			reset(index);
+		}
+		else
+		{
+			set(index);
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void flip_range(const size_type begin, const size_type end)
+	{
+		check_range_is_within_size(begin, end);
+		if (begin == end) return;
+
+		if (dense == NULL)
+		{
+			const index_iterator first = std::lower_bound(indexes.begin(), indexes.end(), begin), last = std::lower_bound(first, indexes.end(), end);
+			const size_type existing = static_cast<size_type>(last - first), flipped = (end - begin) - existing;
+
+			if ((indexes.size() - existing) + flipped <= dense_threshold())
+			{
+				index_vector complement(indexes.get_allocator());
+				complement.reserve(flipped);
+				const_index_iterator current = first;
+
+				for (size_type index = begin; index != end; ++index)
+				{
+					if (current != last && *current == index)
+					{
+						++current;
+					}
+					else
+					{
+						complement.push_back(index);
+					}
+				}
+
+				indexes.insert(indexes.erase(first, last), complement.begin(), complement.end());
+				return;
+			}
+
+			make_dense();
+		}
+
+		total_count += (end - begin) - (2 * dense->count_range(begin, end));
+		dense->flip_range(begin, end);
+		update_representation();
+	}
+
+
+
+	PLF_CONSTFUNC size_type count() const PLF_NOEXCEPT
+	{
+		return (dense == NULL) ? indexes.size() : total_count;
+	}
+
+
+
+	PLF_CONSTFUNC size_type count_range(const size_type begin, const size_type end) const
+	{
+		check_range_is_within_size(begin, end);
+		if (begin == end) return 0;
+
+		if (dense == NULL)
+		{
+			const const_index_iterator first = std::lower_bound(indexes.begin(), indexes.end(), begin);
+			return static_cast<size_type>(std::lower_bound(first, indexes.end(), end) - first);
+		}
+
+		return dense->count_range(begin, end);
+	}
+
+
+
+	PLF_CONSTFUNC bool all() const PLF_NOEXCEPT
+	{
+		return count() == total_size;
+	}
+
+
+
+	PLF_CONSTFUNC bool any() const PLF_NOEXCEPT
+	{
+		return count() != 0;
+	}
+
+
+
+	PLF_CONSTFUNC bool none() const PLF_NOEXCEPT
+	{
+		return count() == 0;
+	}
+
+
+
+	PLF_CONSTFUNC size_type first_one() const PLF_NOEXCEPT
+	{
+		if (dense != NULL) return dense->first_one();
+		return (indexes.empty()) ? std::numeric_limits<size_type>::max() : indexes.front();
+	}
+
+
+
+	PLF_CONSTFUNC size_type next_one(const size_type index) const PLF_NOEXCEPT // note: we are searching from current position, not current position + 1
+	{
+		if (dense != NULL) return dense->next_one(index);
+
+		const const_index_iterator location = std::lower_bound(indexes.begin(), indexes.end(), index);
+		return (location == indexes.end()) ? std::numeric_limits<size_type>::max() : *location;
+	}
+
+
+
+	PLF_CONSTFUNC size_type last_one() const PLF_NOEXCEPT
+	{
+		if (dense != NULL) return dense->last_one();
+		return (indexes.empty()) ? std::numeric_limits<size_type>::max() : indexes.back();
+	}
+
+
+
+	PLF_CONSTFUNC size_type prev_one(const size_type index) const PLF_NOEXCEPT
+	{
+		if (dense != NULL) return dense->prev_one(index);
+		if (index >= total_size) return std::numeric_limits<size_type>::max();
+
+		const const_index_iterator location = std::upper_bound(indexes.begin(), indexes.end(), index);
+		return (location == indexes.begin()) ? std::numeric_limits<size_type>::max() : *(location - 1);
+	}
+
+
+
+	PLF_CONSTFUNC size_type first_zero() const PLF_NOEXCEPT
+	{
+		return next_zero(0);
+	}
+
+
+
+	PLF_CONSTFUNC size_type next_zero(size_type index) const PLF_NOEXCEPT // note: we are searching from current position, not current position + 1
+	{
+		if (dense != NULL) return dense->next_zero(index);
+		if (index >= total_size) return std::numeric_limits<size_type>::max();
+
+		// Skip over the run of set bits (if any) which starts at index:
+		for (const_index_iterator current = std::lower_bound(indexes.begin(), indexes.end(), index); current != indexes.end() && *current == index; ++current, ++index)
+		{}
+
+		return (index == total_size) ? std::numeric_limits<size_type>::max() : index;
+	}
+
+
+
+	PLF_CONSTFUNC size_type last_zero() const PLF_NOEXCEPT
+	{
+		return (total_size == 0) ? std::numeric_limits<size_type>::max() : prev_zero(total_size - 1);
+	}
+
+
+
+	PLF_CONSTFUNC size_type prev_zero(size_type index) const PLF_NOEXCEPT
+	{
+		if (dense != NULL) return dense->prev_zero(index);
+		if (index >= total_size) return std::numeric_limits<size_type>::max();
+
+		for (const_index_iterator current = std::upper_bound(indexes.begin(), indexes.end(), index); current != indexes.begin() && *--current == index; --index)
+		{
+			if (index == 0) return std::numeric_limits<size_type>::max();
+		}
+
+		return index;
+	}
+
+
+
+	// Calls function(index) for every set bit, in ascending order. While sparse this is a plain walk of the index vector:
+	template <class function_type>
+	PLF_CONSTFUNC void for_each_one(function_type function) const
+	{
+		if (dense == NULL)
+		{
+			for (const_index_iterator current = indexes.begin(); current != indexes.end(); ++current) function(*current);
+		}
+		else
+		{
+			for (size_type index = dense->first_one(); index != std::numeric_limits<size_type>::max(); index = dense->next_one(index + 1)) function(index);
+		}
+	}
+
+
+
+	// Calls function(begin, end) for every maximal run of ones in the bitset, in ascending order:
+	template <class function_type>
+	PLF_CONSTFUNC void for_each_run(function_type function) const
+	{
+		if (dense != NULL)
+		{
+			dense->for_each_run(function);
+			return;
+		}
+
+		for (const_index_iterator current = indexes.begin(); current != indexes.end();)
+		{
+			const size_type begin = *current;
+			size_type end = begin + 1;
+
+			while (++current != indexes.end() && *current == end) ++end;
+			function(begin, end);
+		}
+	}
+
+
+
+	PLF_CONSTFUNC bool operator == (const hybrid_bitset &source) const PLF_NOEXCEPT
+	{
+		if (source.total_size != total_size || source.count() != count()) return false;
+		if (dense == NULL && source.dense == NULL) return indexes == source.indexes;
+		if (dense != NULL && source.dense != NULL) return *dense == *source.dense;
+
+		// Mixed representations with equal counts are equal if every index in the sparse set is set in the dense set:
+		const hybrid_bitset &sparse_set = (dense == NULL) ? *this : source, &dense_set = (dense == NULL) ? source : *this;
+
+		for (const_index_iterator current = sparse_set.indexes.begin(); current != sparse_set.indexes.end(); ++current)
+		{
+			if (!(*dense_set.dense)[*current]) return false;
+		}
+
+		return true;
+	}
+
+
+
+	PLF_CONSTFUNC bool operator != (const hybrid_bitset &source) const PLF_NOEXCEPT
+	{
+		return !(*this == source);
+	}
+
+
+
+	PLF_CONSTFUNC size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	PLF_CONSTFUNC void change_size(const size_type new_size)
+	{
+		if (dense == NULL)
+		{
+			indexes.erase(std::lower_bound(indexes.begin(), indexes.end(), new_size), indexes.end());
+		}
+		else if (new_size == 0)
+		{
+			deallocate_dense();
+			total_count = 0;
+		}
+		else
+		{
+			if (new_size < total_size) total_count -= dense->count_range(new_size, total_size);
+			dense->change_size(new_size);
+		}
+
+		total_size = new_size;
+		update_representation();
+	}
+
+
+
+	// Each boolean operator picks its algorithm from the pair of representations. A sparse operand is applied to the other operand index-by-index, and only dense-with-dense operations touch every word:
+
+	PLF_CONSTFUNC hybrid_bitset & operator &= (const hybrid_bitset &source)
+	{
+		check_source_size_is_equal(source.total_size);
+
+		if (dense == NULL) // The result is a subset of *this, so filter our indexes in-place
+		{
+			index_iterator output = indexes.begin();
+
+			for (const_index_iterator current = indexes.begin(); current != indexes.end(); ++current)
+			{
+				if (source.contains(*current)) *output++ = *current;
+			}
+
+			indexes.erase(output, indexes.end());
+		}
+		else if (source.dense == NULL) // The result is a subset of source, so it will be sparse
+		{
+			index_vector new_indexes(indexes.get_allocator());
+
+			for (const_index_iterator current = source.indexes.begin(); current != source.indexes.end(); ++current)
+			{
+				if ((*dense)[*current]) new_indexes.push_back(*current);
+			}
+
+			deallocate_dense();
+			indexes.swap(new_indexes);
+		}
+		else
+		{
+			*dense &= *source.dense;
+			total_count = dense->count();
+			update_representation();
+		}
+
+		return *this;
+	}
+
+
+
+	PLF_CONSTFUNC hybrid_bitset operator & (const hybrid_bitset &source) const
+	{
+		// Copy the sparse operand if there is one, as the result cannot be larger than it:
+		hybrid_bitset result((dense != NULL && source.dense == NULL) ? source : *this);
+		result &= (dense != NULL && source.dense == NULL) ? *this : source;
+		return result;
+	}
+
+
+
+	PLF_CONSTFUNC hybrid_bitset & operator |= (const hybrid_bitset &source)
+	{
+		check_source_size_is_equal(source.total_size);
+
+		if (source.dense == NULL)
+		{
+			if (dense == NULL)
+			{
+				index_vector new_indexes(indexes.get_allocator());
+				new_indexes.reserve(indexes.size() + source.indexes.size());
+				std::set_union(indexes.begin(), indexes.end(), source.indexes.begin(), source.indexes.end(), std::back_inserter(new_indexes));
+				indexes.swap(new_indexes);
+				update_representation();
+			}
+			else
+			{
+				for (const_index_iterator current = source.indexes.begin(); current != source.indexes.end(); ++current)
+				{
+					if (!(*dense)[*current])
+					{
+						dense->set(*current);
+						++total_count;
+					}
+				}
+			}
+		}
+		else if (dense == NULL) // Start from a copy of source's words and add our indexes
+		{
+			dense = allocate_dense(source.dense);
+			total_count = source.total_count;
+
+			for (const_index_iterator current = indexes.begin(); current != indexes.end(); ++current)
+			{
+				if (!(*dense)[*current])
+				{
+					dense->set(*current);
+					++total_count;
+				}
+			}
+
+			index_vector(indexes.get_allocator()).swap(indexes);
+		}
+		else
+		{
+			*dense |= *source.dense;
+			total_count = dense->count();
+		}
+
+		return *this;
+	}
+
+
+
+	PLF_CONSTFUNC hybrid_bitset operator | (const hybrid_bitset &source) const
+	{
+		// Copy the dense operand if there is one, so that the other operand is applied index-by-index:
+		hybrid_bitset result((dense == NULL && source.dense != NULL) ? source : *this);
+		result |= (dense == NULL && source.dense != NULL) ? *this : source;
+		return result;
+	}
+
+
+
+	PLF_CONSTFUNC hybrid_bitset & operator ^= (const hybrid_bitset &source)
+	{
+		check_source_size_is_equal(source.total_size);
+
+		if (source.dense == NULL)
+		{
+			if (dense == NULL)
+			{
+				index_vector new_indexes(indexes.get_allocator());
+				new_indexes.reserve(indexes.size() + source.indexes.size());
+				std::set_symmetric_difference(indexes.begin(), indexes.end(), source.indexes.begin(), source.indexes.end(), std::back_inserter(new_indexes));
+				indexes.swap(new_indexes);
+			}
+			else
+			{
+				for (const_index_iterator current = source.indexes.begin(); current != source.indexes.end(); ++current)
+				{
+					total_count = ((*dense)[*current]) ? total_count - 1 : total_count + 1;
+					dense->flip(*current);
+				}
+			}
+		}
+		else if (dense == NULL)
+		{
+			dense = allocate_dense(source.dense);
+			total_count = source.total_count;
+
+			for (const_index_iterator current = indexes.begin(); current != indexes.end(); ++current)
+			{
+				total_count = ((*dense)[*current]) ? total_count - 1 : total_count + 1;
+				dense->flip(*current);
+			}
+
+			index_vector(indexes.get_allocator()).swap(indexes);
+		}
+		else
+		{
+			*dense ^= *source.dense;
+			total_count = dense->count();
+		}
+
+		update_representation();
+		return *this;
+	}
+
+
+
+	PLF_CONSTFUNC hybrid_bitset operator ^ (const hybrid_bitset &source) const
+	{
+		hybrid_bitset result((dense == NULL && source.dense != NULL) ? source : *this);
+		result ^= (dense == NULL && source.dense != NULL) ? *this : source;
+		return result;
+	}
+
+
+
+	PLF_CONSTFUNC hybrid_bitset operator ~ () const
+	{
+		hybrid_bitset result(*this);
+		result.flip();
+		return result;
+	}
+
+
+
+	PLF_CONSTFUNC bool is_subset_of(const hybrid_bitset &source) const
+	{
+		check_source_size_is_equal(source.total_size);
+		if (count() > source.count()) return false;
+		if (dense != NULL && source.dense != NULL) return dense->is_subset_of(*source.dense);
+
+		// Otherwise *this has no more set bits than a sparse set, so test them individually:
+		for (size_type index = first_one(); index != std::numeric_limits<size_type>::max(); index = next_one(index + 1))
+		{
+			if (!source.contains(index)) return false;
+		}
+
+		return true;
+	}
+
+
+
+	PLF_CONSTFUNC bool is_superset_of(const hybrid_bitset &source) const
+	{
+		return source.is_subset_of(*this);
+	}
+
+
+
+	PLF_CONSTFUNC bool intersects(const hybrid_bitset &source) const
+	{
+		check_source_size_is_equal(source.total_size);
+		if (dense != NULL && source.dense != NULL) return dense->intersects(*source.dense);
+
+		const hybrid_bitset &sparse_set = (dense == NULL) ? *this : source, &other_set = (dense == NULL) ? source : *this;
+
+		for (const_index_iterator current = sparse_set.indexes.begin(); current != sparse_set.indexes.end(); ++current)
+		{
+			if (other_set.contains(*current)) return true;
+		}
+
+		return false;
+	}
+
+
+
+	PLF_CONSTFUNC bool is_disjoint(const hybrid_bitset &source) const
+	{
+		return !intersects(source);
+	}
+
+
+
+	PLF_CONSTFUNC void swap(hybrid_bitset &source) PLF_NOEXCEPT
+	{
+		indexes.swap(source.indexes);
+		std::swap(dense, source.dense);
+		std::swap(total_size, source.total_size);
+		std::swap(total_count, source.total_count);
+	}
+};
+
+
+
+template <typename storage_type, class allocator_type, bool hardened>
+void swap (plf::hybrid_bitset<storage_type, allocator_type, hardened> &a, plf::hybrid_bitset<storage_type, allocator_type, hardened> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+
+} // plf namespace
+
+
+#undef PLF_MOVE_SEMANTICS_SUPPORT
+#undef PLF_ALLOCATOR_TRAITS_SUPPORT
+#undef PLF_CONSTFUNC
+#undef PLF_CONSTEXPR
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+
+#undef PLF_ALLOCATE
+#undef PLF_DEALLOCATE
+#undef PLF_CONSTRUCT
+#undef PLF_DESTROY
+
+#endif // PLF_HYBRID_BITSET_H
@@ -0,0 +1,351 @@
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include "plf_hybrid_bitset.h"
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+typedef plf::hybrid_bitset<> hybrid_type;
+
+
+// Compares every query against a std::vector<bool> holding the expected contents:
+bool matches(const hybrid_type &values, const std::vector<bool> &expected)
+{
+	const std::size_t size = expected.size(), not_found = std::numeric_limits<std::size_t>::max();
+	std::size_t expected_count = 0, expected_next_one = not_found, expected_next_zero = not_found;
+
+	if (values.size() != size) return false;
+
+	for (std::size_t index = size; index-- != 0;) // backwards, so that the next one/zero at or after index is known
+	{
+		if (expected[index])
+		{
+			++expected_count;
+			expected_next_one = index;
+		}
+		else
+		{
+			expected_next_zero = index;
+		}
+
+		if (values[index] != expected[index] || values.next_one(index) != expected_next_one || values.next_zero(index) != expected_next_zero) return false;
+	}
+
+	std::size_t expected_prev_one = not_found, expected_prev_zero = not_found;
+
+	for (std::size_t index = 0; index != size; ++index)
+	{
+		if (expected[index])
+		{
+			expected_prev_one = index;
+		}
+		else
+		{
+			expected_prev_zero = index;
+		}
+
+		if (values.prev_one(index) != expected_prev_one || values.prev_zero(index) != expected_prev_zero) return false;
+	}
+
+	return values.count() == expected_count && values.first_one() == values.next_one(0) && values.last_one() == expected_prev_one && values.last_zero() == expected_prev_zero && values.all() == (expected_count == size) && values.none() == (expected_count == 0);
+}
+
+
+
+struct index_collector
+{
+	std::vector<std::size_t> *indexes;
+
+	explicit index_collector(std::vector<std::size_t> &destination): indexes(&destination) {}
+
+	void operator () (const std::size_t index)
+	{
+		indexes->push_back(index);
+	}
+};
+
+
+
+struct run_collector
+{
+	std::vector<std::pair<std::size_t, std::size_t> > *runs;
+
+	explicit run_collector(std::vector<std::pair<std::size_t, std::size_t> > &destination): runs(&destination) {}
+
+	void operator () (const std::size_t begin, const std::size_t end)
+	{
+		runs->push_back(std::make_pair(begin, end));
+	}
+};
+
+
+
+// Fills both with random bits at roughly one-in-one_in density:
+void random_fill(hybrid_type &values, std::vector<bool> &expected, const unsigned int one_in)
+{
+	values.reset();
+
+	for (std::size_t index = 0; index != expected.size(); ++index)
+	{
+		expected[index] = (rand() % one_in) == 0;
+		if (expected[index]) values.set(index);
+	}
+}
+
+
+
+
+
+int main()
+{
+	srand(5);
+
+	{
+		message("Representation tests\n==================================\n\n");
+
+		hybrid_type values(6400); // dense above 100 set bits, sparse again below 25
+
+		failpass("Starts sparse test", values.is_sparse() && values.none() && values.first_one() == std::numeric_limits<std::size_t>::max() && values.first_zero() == 0);
+
+		for (std::size_t index = 0; index != 100; ++index) values.set(index * 64);
+
+		failpass("Sparse at threshold test", values.is_sparse() && values.count() == 100);
+
+		values.set(1);
+		failpass("Becomes dense above threshold test", !values.is_sparse() && values.count() == 101 && values[1] && values[6336]);
+
+		for (std::size_t index = 0; index != 70; ++index) values.reset(index * 64);
+
+		failpass("Stays dense with hysteresis test", !values.is_sparse() && values.count() == 31);
+
+		values.reset_range(0, 6400 - (6 * 64));
+		failpass("Becomes sparse below threshold test", values.is_sparse() && values.count() == 6 && values.first_one() == 6400 - (6 * 64));
+
+		values.set_range(100, 150);
+		failpass("Sparse set_range test", values.is_sparse() && values.count() == 56 && values.count_range(100, 200) == 50);
+
+		values.set_range(1000, 1100);
+		failpass("Dense set_range test", !values.is_sparse() && values.count() == 156 && values.next_zero(1000) == 1100);
+
+		values.set();
+		failpass("Set all test", !values.is_sparse() && values.all());
+
+		values.reset();
+		failpass("Reset all test", values.is_sparse() && values.none());
+
+		values.flip();
+		failpass("Flip all test", values.all());
+	}
+
+
+	{
+		message("Randomized single-bitset tests\n==================================\n\n");
+
+		const std::size_t sizes[] = {1, 63, 64, 65, 1000, 5000};
+		const unsigned int densities[] = {2, 50, 500};
+		bool single_passed = true, range_passed = true, iteration_passed = true, resize_passed = true;
+
+		for (unsigned int size_index = 0; size_index != 6; ++size_index)
+		{
+			const std::size_t size = sizes[size_index];
+
+			for (unsigned int density_index = 0; density_index != 3; ++density_index)
+			{
+				hybrid_type values(size);
+				std::vector<bool> expected(size);
+				random_fill(values, expected, densities[density_index]);
+				single_passed = single_passed && matches(values, expected);
+
+				for (unsigned int counter = 0; counter != 40; ++counter)
+				{
+					std::size_t begin = rand() % size, end = rand() % (size + 1);
+					if (begin > end) std::swap(begin, end);
+
+					switch (counter % 5)
+					{
+						case 0: values.set_range(begin, end); for (std::size_t index = begin; index != end; ++index) expected[index] = true; break;
+						case 1: values.reset_range(begin, end); for (std::size_t index = begin; index != end; ++index) expected[index] = false; break;
+						case 2: values.flip_range(begin, end); for (std::size_t index = begin; index != end; ++index) expected[index] = !expected[index]; break;
+						case 3: values.flip(begin); expected[begin] = !expected[begin]; break;
+						default: values.set(begin, !expected[begin]); expected[begin] = !expected[begin]; break;
+					}
+
+					range_passed = range_passed && matches(values, expected);
+
+					std::size_t expected_in_range = 0;
+					for (std::size_t index = begin; index != end; ++index) expected_in_range += expected[index];
+					range_passed = range_passed && values.count_range(begin, end) == expected_in_range;
+				}
+
+				std::vector<std::size_t> ones, expected_ones;
+				values.for_each_one(index_collector(ones));
+				for (std::size_t index = 0; index != size; ++index) if (expected[index]) expected_ones.push_back(index);
+
+				std::vector<std::pair<std::size_t, std::size_t> > runs;
+				std::size_t run_total = 0;
+				values.for_each_run(run_collector(runs));
+				for (std::size_t index = 0; index != runs.size(); ++index) run_total += runs[index].second - runs[index].first;
+
+				iteration_passed = iteration_passed && ones == expected_ones && run_total == values.count() && (runs.empty() || (runs.front().first == values.first_one() && runs.back().second == values.last_one() + 1));
+
+				const std::size_t new_size = size / 2 + 1;
+				values.change_size(new_size);
+				expected.resize(new_size);
+				resize_passed = resize_passed && matches(values, expected);
+				values.change_size(size);
+				expected.resize(size);
+				resize_passed = resize_passed && matches(values, expected);
+			}
+		}
+
+		failpass("Random fill test", single_passed);
+		failpass("Random range and single-bit operations test", range_passed);
+		failpass("for_each_one/for_each_run test", iteration_passed);
+		failpass("change_size test", resize_passed);
+	}
+
+
+	{
+		message("Representation pair tests\n==================================\n\n");
+
+		const std::size_t size = 4000;
+		const unsigned int densities[] = {400, 3}; // one sparse, one dense
+		bool and_passed = true, or_passed = true, xor_passed = true, not_passed = true, relation_passed = true;
+
+		for (unsigned int a_density = 0; a_density != 2; ++a_density)
+		{
+			for (unsigned int b_density = 0; b_density != 2; ++b_density)
+			{
+				hybrid_type a(size), b(size);
+				std::vector<bool> expected_a(size), expected_b(size), expected_and(size), expected_or(size), expected_xor(size), expected_not(size);
+				random_fill(a, expected_a, densities[a_density]);
+				random_fill(b, expected_b, densities[b_density]);
+
+				bool expected_intersects = false, expected_subset = true;
+
+				for (std::size_t index = 0; index != size; ++index)
+				{
+					expected_and[index] = expected_a[index] && expected_b[index];
+					expected_or[index] = expected_a[index] || expected_b[index];
+					expected_xor[index] = expected_a[index] != expected_b[index];
+					expected_not[index] = !expected_a[index];
+					expected_intersects = expected_intersects || expected_and[index];
+					expected_subset = expected_subset && (!expected_a[index] || expected_b[index]);
+				}
+
+				hybrid_type result(a);
+				result &= b;
+				and_passed = and_passed && matches(result, expected_and) && matches(a & b, expected_and);
+
+				result = a;
+				result |= b;
+				or_passed = or_passed && matches(result, expected_or) && matches(a | b, expected_or);
+
+				result = a;
+				result ^= b;
+				xor_passed = xor_passed && matches(result, expected_xor) && matches(a ^ b, expected_xor);
+
+				not_passed = not_passed && matches(~a, expected_not);
+
+				relation_passed = relation_passed && a.intersects(b) == expected_intersects && a.is_subset_of(b) == expected_subset && (a & b).is_subset_of(a) && (a | b).is_superset_of(b) && a.is_disjoint(a ^ a);
+				relation_passed = relation_passed && (a == a) && (a != b) && ((a & b) | (a ^ b)) == (a | b);
+			}
+		}
+
+		failpass("And test", and_passed);
+		failpass("Or test", or_passed);
+		failpass("Xor test", xor_passed);
+		failpass("Not test", not_passed);
+		failpass("Subset/intersects/equality test", relation_passed);
+
+		hybrid_type sparse(size), dense(size);
+		sparse.set_range(0, 30);
+		dense.set_range(0, 100);
+		dense.reset_range(30, 100); // within the hysteresis band, so still dense
+		failpass("Mixed-representation equality test", sparse.is_sparse() && !dense.is_sparse() && sparse == dense && dense == sparse && sparse.is_subset_of(dense) && dense.is_subset_of(sparse));
+
+		hybrid_type small_size(100);
+		bool length_error_thrown = false;
+
+		try
+		{
+			small_size &= sparse;
+		}
+		catch (std::length_error &)
+		{
+			length_error_thrown = true;
+		}
+
+		failpass("Size mismatch test", length_error_thrown);
+	}
+
+
+	{
+		message("Copy and move tests\n==================================\n\n");
+
+		hybrid_type values(3000);
+		values.set_range(0, 2000);
+		hybrid_type copy(values);
+		failpass("Dense copy test", copy == values && !copy.is_sparse());
+
+		values.reset_range(5, 2000);
+		copy = values;
+		failpass("Sparse copy assignment test", copy == values && copy.is_sparse() && copy.count() == 5);
+
+		swap(copy, values);
+		failpass("Swap test", copy.count() == 5 && values.count() == 5);
+
+		#if defined(__cplusplus) && __cplusplus >= 201103L
+			hybrid_type moved(std::move(copy));
+			failpass("Move construct test", moved.count() == 5 && copy.size() == 0);
+		#endif
+
+		plf::hybrid_bitset<unsigned char, std::allocator<unsigned char>, true> hardened(10);
+		bool out_of_range_thrown = false;
+
+		try
+		{
+			hardened.set_range(5, 11);
+		}
+		catch (std::out_of_range &)
+		{
+			out_of_range_thrown = true;
+		}
+
+		hardened.set_range(5, 10);
+		failpass("Hardened range test", out_of_range_thrown && hardened.count() == 5 && hardened.last_one() == 9);
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
@@ -0,0 +1,679 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_PACKED_BITSET_H
+#define PLF_PACKED_BITSET_H
+
+
+#include "plf_bitsetb.h" // plf::popcount
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+#define PLF_CONSTEXPR
+#define PLF_CONSTFUNC
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1600
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+	#endif
+
+	#if _MSC_VER >= 1700
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+	#endif
+
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept(!user_supplied_buffer)
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L) && _MSC_VER >= 1929
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+		#define PLF_CPP20_SUPPORT
+	#endif
+
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 3) || __GNUC__ > 4
+			#define PLF_MOVE_SEMANTICS_SUPPORT
+		#endif
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept(!user_supplied_buffer)
+		#endif
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 7) || __GNUC__ > 4
+			#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#endif
+	#elif defined(__clang__)
+		#if !defined(__GLIBCXX__) && !defined(_LIBCPP_CXX03_LANG) && __clang_major__ >= 3
+			#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#endif
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept(!user_supplied_buffer)
+		#endif
+		#if __has_feature(cxx_rvalue_references) && !defined(_LIBCPP_HAS_NO_RVALUE_REFERENCES)
+			#define PLF_MOVE_SEMANTICS_SUPPORT
+		#endif
+	#else // Assume support for other compilers
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept(!user_supplied_buffer)
+	#endif
+
+	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	#if __cplusplus >= 202001L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) &&	_GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
+		#undef PLF_CONSTFUNC
+		#define PLF_CONSTFUNC constexpr
+		#define PLF_CPP20_SUPPORT
+	#endif
+#endif
+
+
+
+#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+	#define PLF_ALLOCATE(the_allocator, allocator_instance, size, hint)			std::allocator_traits<the_allocator>::allocate(allocator_instance, size, hint)
+	#define PLF_DEALLOCATE(the_allocator, allocator_instance, location, size)	std::allocator_traits<the_allocator>::deallocate(allocator_instance, location, size)
+#else
+	#define PLF_ALLOCATE(the_allocator, allocator_instance, size, hint)			(allocator_instance).allocate(size, hint)
+	#define PLF_DEALLOCATE(the_allocator, allocator_instance, location, size)	(allocator_instance).deallocate(location, size)
+#endif
+
+
+
+#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
+#define PLF_ELEMENTS_PER_WORD (PLF_TYPE_BITWIDTH / bits_per_element)
+#define PLF_ARRAY_CAPACITY_CALC(number_of_elements) (((number_of_elements) + PLF_ELEMENTS_PER_WORD - 1) / PLF_ELEMENTS_PER_WORD) // ie. round up to nearest unit of storage
+#define PLF_ARRAY_CAPACITY PLF_ARRAY_CAPACITY_CALC(total_size)
+
+
+#ifdef __AVX2__
+	#include <immintrin.h>
+#endif
+
+#include <cassert>
+#include <memory> // std::uninitialized_copy, allocator
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <limits>  // std::numeric_limits
+#include <algorithm> // std::fill_n, std::copy, std::equal
+
+#ifdef PLF_CPP20_SUPPORT
+	#include <type_traits> // std::is_constant_evaluated
+#endif
+
+
+
+namespace plf
+{
+
+
+// An array of small unsigned integers (counters, ages, quotient filter slots) packed bits_per_element to an element, with the same buffer and allocator model as plf::bitsetb. Elements never straddle storage_type boundaries, so each storage_type holds PLF_ELEMENTS_PER_WORD elements and whole-word operations work on all of its elements at once via SWAR (SIMD-within-a-register) arithmetic.
+// As per plf::bitset, elements beyond size() in the final storage_type are always zero.
+template<unsigned int bits_per_element, bool user_supplied_buffer = false, typename storage_type = std::size_t, class allocator_type = std::allocator<storage_type>, bool hardened = false>
+class packed_bitset : private allocator_type // Empty base class optimisation - inheriting allocator functions
+{
+public:
+	typedef std::size_t size_type;
+	typedef unsigned int value_type;
+
+	static const value_type max_value = (1u << bits_per_element) - 1;
+
+private:
+	typedef char bits_per_element_must_be_1_2_4_or_8[(bits_per_element == 1 || bits_per_element == 2 || bits_per_element == 4 || bits_per_element == 8) ? 1 : -1]; // C++03 static_assert
+
+	// Per-element bit patterns - the lowest bit of every element, the highest bit of every element, and all but the highest bit of every element:
+	static const storage_type low_bits = static_cast<storage_type>(static_cast<storage_type>(~storage_type(0)) / max_value);
+	static const storage_type high_bits = static_cast<storage_type>(low_bits << (bits_per_element - 1));
+	static const storage_type value_bits = static_cast<storage_type>(high_bits - low_bits);
+
+	storage_type *buffer;
+	size_type total_size;
+
+
+
+	// Returns the high bit of every nonzero element:
+	static PLF_CONSTFUNC storage_type nonzero_elements(const storage_type word) PLF_NOEXCEPT
+	{
+		return static_cast<storage_type>((static_cast<storage_type>((word & value_bits) + value_bits) | word) & high_bits);
+	}
+
+
+
+	// Returns the high bit of every element >= value. The lower bits of each element are compared by subtracting from them with the high bit pre-set, so that no borrow can cross into the next element, then the high bits are combined according to value's high bit:
+	static PLF_CONSTFUNC storage_type elements_at_least(const storage_type word, const value_type value) PLF_NOEXCEPT
+	{
+		const storage_type lower_at_least = static_cast<storage_type>(static_cast<storage_type>((word & value_bits) | high_bits) - static_cast<storage_type>((value & (max_value >> 1)) * low_bits)) & high_bits;
+		return static_cast<storage_type>((value >> (bits_per_element - 1)) ? (word & lower_at_least) : ((word & high_bits) | lower_at_least));
+	}
+
+
+
+	// Mask covering elements [begin_subindex, end_subindex) of a storage_type, end_subindex > 0:
+	static PLF_CONSTFUNC storage_type elements_mask(const size_type begin_subindex, const size_type end_subindex) PLF_NOEXCEPT
+	{
+		return static_cast<storage_type>((std::numeric_limits<storage_type>::max() << (begin_subindex * bits_per_element)) & (std::numeric_limits<storage_type>::max() >> (PLF_TYPE_BITWIDTH - (end_subindex * bits_per_element))));
+	}
+
+
+
+	PLF_CONSTFUNC void set_overflow_to_zero() PLF_NOEXCEPT
+	{
+		if (total_size % PLF_ELEMENTS_PER_WORD != 0) buffer[PLF_ARRAY_CAPACITY - 1] &= elements_mask(0, total_size % PLF_ELEMENTS_PER_WORD);
+	}
+
+
+
+	PLF_CONSTFUNC void check_index_is_within_size(const size_type index) const
+	{
+		if (index >= total_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::out_of_range("Index larger than size of packed_bitset");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void check_range_is_within_size(const size_type begin, const size_type end) const
+	{
+		if (begin > end || end > total_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::out_of_range("Range outside of packed_bitset");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void check_value(const value_type value) const
+	{
+		if (value > max_value)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::out_of_range("Value larger than max_value");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+public:
+
+	// If reset_supplied_buffer is false, a user-supplied buffer's existing contents are adopted as-is, as per plf::bitsetb:
+	PLF_CONSTFUNC packed_bitset(const size_type size, storage_type * const supplied_buffer = NULL, const bool reset_supplied_buffer = true):
+		buffer((user_supplied_buffer) ? supplied_buffer : PLF_ALLOCATE(allocator_type, *this, PLF_ARRAY_CAPACITY_CALC(size), this)),
+		total_size(size)
+	{
+		if (!user_supplied_buffer || reset_supplied_buffer)
+		{
+			reset();
+		}
+		else
+		{
+			set_overflow_to_zero();
+		}
+	}
+
+
+
+	PLF_CONSTFUNC packed_bitset(const packed_bitset &source, storage_type * const supplied_buffer = NULL):
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+			allocator_type(std::allocator_traits<allocator_type>::select_on_container_copy_construction(source)),
+		#else
+			allocator_type(source),
+		#endif
+		buffer((user_supplied_buffer) ? supplied_buffer : PLF_ALLOCATE(allocator_type, *this, PLF_ARRAY_CAPACITY_CALC(source.total_size), this)),
+		total_size(source.total_size)
+	{
+		std::uninitialized_copy(source.buffer, source.buffer + PLF_ARRAY_CAPACITY, buffer);
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		PLF_CONSTFUNC packed_bitset(packed_bitset &&source) PLF_NOEXCEPT:
+			buffer(source.buffer),
+			total_size(source.total_size)
+		{
+			source.buffer = NULL;
+			source.total_size = 0;
+		}
+	#endif
+
+
+
+	PLF_CONSTFUNC ~packed_bitset() PLF_NOEXCEPT
+	{
+		if PLF_CONSTEXPR (!user_supplied_buffer)
+		{
+			PLF_DEALLOCATE(allocator_type, *this, buffer, PLF_ARRAY_CAPACITY);
+		}
+	}
+
+
+
+	PLF_CONSTFUNC value_type operator [] (const size_type index) const
+	{
+		if PLF_CONSTEXPR (hardened) check_index_is_within_size(index);
+		return static_cast<value_type>((buffer[index / PLF_ELEMENTS_PER_WORD] >> ((index % PLF_ELEMENTS_PER_WORD) * bits_per_element)) & max_value);
+	}
+
+
+
+	PLF_CONSTFUNC value_type at(const size_type index) const
+	{
+		if PLF_CONSTEXPR (!hardened) check_index_is_within_size(index); // If hardened, will be checked in []
+		return operator [](index);
+	}
+
+
+
+	PLF_CONSTFUNC void set(const size_type index, const value_type value)
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			check_index_is_within_size(index);
+			check_value(value);
+		}
+
+		const size_type word_index = index / PLF_ELEMENTS_PER_WORD, shift = (index % PLF_ELEMENTS_PER_WORD) * bits_per_element;
+		buffer[word_index] = static_cast<storage_type>((buffer[word_index] & ~(static_cast<storage_type>(max_value) << shift)) | (static_cast<storage_type>(value & max_value) << shift));
+	}
+
+
+
+	// Sets every element to value:
+	PLF_CONSTFUNC void set(const value_type value)
+	{
+		if PLF_CONSTEXPR (hardened) check_value(value);
+		std::fill_n(buffer, PLF_ARRAY_CAPACITY, static_cast<storage_type>((value & max_value) * low_bits));
+		set_overflow_to_zero();
+	}
+
+
+
+	PLF_CONSTFUNC void set_range(const size_type begin, const size_type end, const value_type value)
+	{
+		if PLF_CONSTEXPR (hardened)
+		{
+			check_range_is_within_size(begin, end);
+			check_value(value);
+		}
+
+		if (begin == end) return;
+
+		const storage_type pattern = static_cast<storage_type>((value & max_value) * low_bits);
+		const size_type begin_word = begin / PLF_ELEMENTS_PER_WORD, end_word = (end - 1) / PLF_ELEMENTS_PER_WORD;
+
+		for (size_type word_index = begin_word; word_index <= end_word; ++word_index)
+		{
+			const storage_type mask = elements_mask((word_index == begin_word) ? begin % PLF_ELEMENTS_PER_WORD : 0, (word_index == end_word) ? ((end - 1) % PLF_ELEMENTS_PER_WORD) + 1 : PLF_ELEMENTS_PER_WORD);
+			buffer[word_index] = static_cast<storage_type>((buffer[word_index] & ~mask) | (pattern & mask));
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void reset() PLF_NOEXCEPT
+	{
+		std::fill_n(buffer, PLF_ARRAY_CAPACITY, storage_type(0));
+	}
+
+
+
+	PLF_CONSTFUNC void reset(const size_type index)
+	{
+		set(index, 0);
+	}
+
+
+
+	PLF_CONSTFUNC void reset_range(const size_type begin, const size_type end)
+	{
+		set_range(begin, end, 0);
+	}
+
+
+
+	// Saturating increment and decrement, ie. an element at max_value stays at max_value, and one at zero stays at zero. Both return the element's new value:
+	PLF_CONSTFUNC value_type increment(const size_type index)
+	{
+		const value_type value = operator [](index);
+		if (value == max_value) return value;
+		set(index, value + 1);
+		return value + 1;
+	}
+
+
+
+	PLF_CONSTFUNC value_type decrement(const size_type index)
+	{
+		const value_type value = operator [](index);
+		if (value == 0) return value;
+		set(index, value - 1);
+		return value - 1;
+	}
+
+
+
+	// The ranged and whole-array versions add one to every element below max_value (or subtract one from every nonzero element) with a single add/subtract per storage_type, as no element can carry or borrow into its neighbour:
+	PLF_CONSTFUNC void increment_range(const size_type begin, const size_type end)
+	{
+		if PLF_CONSTEXPR (hardened) check_range_is_within_size(begin, end);
+		if (begin == end) return;
+
+		const size_type begin_word = begin / PLF_ELEMENTS_PER_WORD, end_word = (end - 1) / PLF_ELEMENTS_PER_WORD;
+
+		for (size_type word_index = begin_word; word_index <= end_word; ++word_index)
+		{
+			const storage_type mask = elements_mask((word_index == begin_word) ? begin % PLF_ELEMENTS_PER_WORD : 0, (word_index == end_word) ? ((end - 1) % PLF_ELEMENTS_PER_WORD) + 1 : PLF_ELEMENTS_PER_WORD);
+			buffer[word_index] = static_cast<storage_type>(buffer[word_index] + ((nonzero_elements(static_cast<storage_type>(~buffer[word_index])) >> (bits_per_element - 1)) & mask));
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void decrement_range(const size_type begin, const size_type end)
+	{
+		if PLF_CONSTEXPR (hardened) check_range_is_within_size(begin, end);
+		if (begin == end) return;
+
+		const size_type begin_word = begin / PLF_ELEMENTS_PER_WORD, end_word = (end - 1) / PLF_ELEMENTS_PER_WORD;
+
+		for (size_type word_index = begin_word; word_index <= end_word; ++word_index)
+		{
+			const storage_type mask = elements_mask((word_index == begin_word) ? begin % PLF_ELEMENTS_PER_WORD : 0, (word_index == end_word) ? ((end - 1) % PLF_ELEMENTS_PER_WORD) + 1 : PLF_ELEMENTS_PER_WORD);
+			buffer[word_index] = static_cast<storage_type>(buffer[word_index] - ((nonzero_elements(buffer[word_index]) >> (bits_per_element - 1)) & mask));
+		}
+	}
+
+
+
+	PLF_CONSTFUNC void increment_all() PLF_NOEXCEPT
+	{
+		for (size_type word_index = 0, end = PLF_ARRAY_CAPACITY; word_index != end; ++word_index)
+		{
+			buffer[word_index] = static_cast<storage_type>(buffer[word_index] + (nonzero_elements(static_cast<storage_type>(~buffer[word_index])) >> (bits_per_element - 1)));
+		}
+
+		set_overflow_to_zero();
+	}
+
+
+
+	// eg. ageing every entry of an age-map or counting filter by one step:
+	PLF_CONSTFUNC void decrement_all() PLF_NOEXCEPT
+	{
+		for (size_type word_index = 0, end = PLF_ARRAY_CAPACITY; word_index != end; ++word_index)
+		{
+			buffer[word_index] = static_cast<storage_type>(buffer[word_index] - (nonzero_elements(buffer[word_index]) >> (bits_per_element - 1)));
+		}
+	}
+
+
+
+	// Number of elements >= value:
+	PLF_CONSTFUNC size_type count_at_least(const value_type value) const PLF_NOEXCEPT
+	{
+		if (value == 0) return total_size;
+		if (value > max_value) return 0;
+
+		// Elements beyond size() are zero, so are never counted from here on:
+		size_type total = 0, word_index = 0;
+		const size_type end = PLF_ARRAY_CAPACITY;
+
+		#ifdef __AVX2__
+			#ifdef PLF_CPP20_SUPPORT
+				if (!std::is_constant_evaluated())
+			#endif
+			{
+				// No element crosses a byte boundary, so the SWAR comparison can be done on 8-bit lanes, with each element's high bit then shifted up to bit 7 of its byte for movemask:
+				const unsigned char byte_low_bits = static_cast<unsigned char>(255u / max_value), byte_high_bits = static_cast<unsigned char>(byte_low_bits << (bits_per_element - 1));
+				const __m256i low_vector = _mm256_set1_epi8(static_cast<char>(byte_high_bits - byte_low_bits)), high_vector = _mm256_set1_epi8(static_cast<char>(byte_high_bits)), subtrahend = _mm256_set1_epi8(static_cast<char>((value & (max_value >> 1)) * byte_low_bits));
+				const bool value_high_bit = static_cast<bool>(value >> (bits_per_element - 1));
+				const unsigned char * const bytes = reinterpret_cast<const unsigned char *>(buffer);
+
+				size_type block_index = 0;
+
+				for (const size_type number_of_blocks = (end * sizeof(storage_type)) / 32; block_index != number_of_blocks; ++block_index)
+				{
+					const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes + (block_index * 32)));
+					const __m256i lower_at_least = _mm256_and_si256(_mm256_sub_epi8(_mm256_or_si256(_mm256_and_si256(words, low_vector), high_vector), subtrahend), high_vector);
+					const __m256i at_least = (value_high_bit) ? _mm256_and_si256(words, lower_at_least) : _mm256_or_si256(_mm256_and_si256(words, high_vector), lower_at_least);
+
+					for (unsigned int shift = 0; shift != 8; shift += bits_per_element)
+					{
+						total += plf::popcount(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_slli_epi64(at_least, static_cast<int>(shift)))));
+					}
+				}
+
+				word_index = (block_index * 32) / sizeof(storage_type);
+			}
+		#endif
+
+		for (; word_index != end; ++word_index) total += plf::popcount(elements_at_least(buffer[word_index], value));
+		return total;
+	}
+
+
+
+	// Number of nonzero elements:
+	PLF_CONSTFUNC size_type count() const PLF_NOEXCEPT
+	{
+		return count_at_least(1);
+	}
+
+
+
+	PLF_CONSTFUNC size_type count_range(const size_type begin, const size_type end) const
+	{
+		if PLF_CONSTEXPR (hardened) check_range_is_within_size(begin, end);
+		if (begin == end) return 0;
+
+		size_type total = 0;
+		const size_type begin_word = begin / PLF_ELEMENTS_PER_WORD, end_word = (end - 1) / PLF_ELEMENTS_PER_WORD;
+
+		for (size_type word_index = begin_word; word_index <= end_word; ++word_index)
+		{
+			const storage_type mask = elements_mask((word_index == begin_word) ? begin % PLF_ELEMENTS_PER_WORD : 0, (word_index == end_word) ? ((end - 1) % PLF_ELEMENTS_PER_WORD) + 1 : PLF_ELEMENTS_PER_WORD);
+			total += plf::popcount(static_cast<storage_type>(nonzero_elements(buffer[word_index]) & mask));
+		}
+
+		return total;
+	}
+
+
+
+	PLF_CONSTFUNC bool any() const PLF_NOEXCEPT
+	{
+		for (size_type word_index = 0, end = PLF_ARRAY_CAPACITY; word_index != end; ++word_index)
+		{
+			if (buffer[word_index] != 0) return true;
+		}
+
+		return false;
+	}
+
+
+
+	PLF_CONSTFUNC bool none() const PLF_NOEXCEPT
+	{
+		return !any();
+	}
+
+
+
+	// Returns the index of the first element >= value at or after index, or std::numeric_limits<size_type>::max() if there is none:
+	PLF_CONSTFUNC size_type next_at_least(const size_type index, const value_type value) const PLF_NOEXCEPT
+	{
+		if (index >= total_size || value > max_value) return std::numeric_limits<size_type>::max();
+
+		size_type word_index = index / PLF_ELEMENTS_PER_WORD;
+		storage_type found = static_cast<storage_type>(elements_at_least(buffer[word_index], value) & (std::numeric_limits<storage_type>::max() << ((index % PLF_ELEMENTS_PER_WORD) * bits_per_element)));
+
+		for (const size_type end = PLF_ARRAY_CAPACITY; ;)
+		{
+			if (found != 0)
+			{
+				const size_type result = (word_index * PLF_ELEMENTS_PER_WORD) + (plf::count_trailing_zeros(found) / bits_per_element);
+				return (result < total_size) ? result : std::numeric_limits<size_type>::max(); // value == 0 also matches the overflow elements
+			}
+
+			if (++word_index == end) return std::numeric_limits<size_type>::max();
+			found = elements_at_least(buffer[word_index], value);
+		}
+	}
+
+
+
+	PLF_CONSTFUNC size_type next_nonzero(const size_type index) const PLF_NOEXCEPT
+	{
+		return next_at_least(index, 1);
+	}
+
+
+
+	PLF_CONSTFUNC size_type first_nonzero() const PLF_NOEXCEPT
+	{
+		return next_at_least(0, 1);
+	}
+
+
+
+	PLF_CONSTFUNC void operator = (const packed_bitset &source)
+	{
+		if (source.total_size != total_size)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Source size is not equal to size of *this.");
+			#else
+				std::terminate();
+			#endif
+		}
+
+		std::copy(source.buffer, source.buffer + PLF_ARRAY_CAPACITY, buffer);
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		PLF_CONSTFUNC void operator = (packed_bitset &&source) PLF_NOEXCEPT
+		{
+			assert(source.buffer != NULL);
+			assert(&source != this);
+
+			if PLF_CONSTEXPR (!user_supplied_buffer)
+			{
+				PLF_DEALLOCATE(allocator_type, *this, buffer, PLF_ARRAY_CAPACITY);
+			}
+
+			buffer = source.buffer;
+			total_size = source.total_size;
+			source.buffer = NULL;
+			source.total_size = 0;
+		}
+	#endif
+
+
+
+ 	PLF_CONSTFUNC bool operator == (const packed_bitset &source) const PLF_NOEXCEPT
+	{
+ 		return (source.total_size == total_size) && std::equal(source.buffer, source.buffer + PLF_ARRAY_CAPACITY, buffer);
+	}
+
+
+
+ 	PLF_CONSTFUNC bool operator != (const packed_bitset &source) const PLF_NOEXCEPT
+	{
+		return !(*this == source);
+	}
+
+
+
+	PLF_CONSTFUNC size_type size() const PLF_NOEXCEPT
+ 	{
+ 		return total_size;
+ 	}
+
+
+
+	// The packed storage words. Not named data(), as size() counts elements rather than bits, so passing a packed_bitset to functions expecting a bitset's data() and size() would silently read the wrong number of bits:
+	PLF_CONSTFUNC storage_type * words() PLF_NOEXCEPT
+	{
+		return buffer;
+	}
+
+
+
+	PLF_CONSTFUNC const storage_type * words() const PLF_NOEXCEPT
+	{
+		return buffer;
+	}
+};
+
+
+} // plf namespace
+
+
+#undef PLF_MOVE_SEMANTICS_SUPPORT
+#undef PLF_ALLOCATOR_TRAITS_SUPPORT
+#undef PLF_CPP20_SUPPORT
+#undef PLF_CONSTFUNC
+#undef PLF_CONSTEXPR
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+
+#undef PLF_ALLOCATE
+#undef PLF_DEALLOCATE
+
+#undef PLF_TYPE_BITWIDTH
+#undef PLF_ELEMENTS_PER_WORD
+#undef PLF_ARRAY_CAPACITY_CALC
+#undef PLF_ARRAY_CAPACITY
+
+#endif // PLF_PACKED_BITSET_H
@@ -0,0 +1,242 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "plf_packed_bitset.h"
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+
+
+template <class packed_type>
+bool matches(const packed_type &values, const std::vector<unsigned int> &expected)
+{
+	if (values.size() != expected.size()) return false;
+
+	for (std::size_t index = 0; index != expected.size(); ++index)
+	{
+		if (values[index] != expected[index]) return false;
+	}
+
+	for (unsigned int minimum = 0; minimum <= packed_type::max_value + 1; ++minimum)
+	{
+		std::size_t expected_count = 0;
+		for (std::size_t index = 0; index != expected.size(); ++index) expected_count += (expected[index] >= minimum);
+		if (values.count_at_least(minimum) != expected_count) return false;
+	}
+
+	// Spot-check ranged counts and searches from random positions:
+	for (unsigned int round = 0; round != 20 && !expected.empty(); ++round)
+	{
+		std::size_t begin = static_cast<std::size_t>(rand()) % expected.size(), end = static_cast<std::size_t>(rand()) % (expected.size() + 1);
+		if (begin > end) std::swap(begin, end);
+
+		std::size_t expected_count = 0;
+		for (std::size_t index = begin; index != end; ++index) expected_count += (expected[index] != 0);
+		if (values.count_range(begin, end) != expected_count) return false;
+
+		const unsigned int minimum = static_cast<unsigned int>(rand()) % (packed_type::max_value + 1);
+		std::size_t expected_index = begin;
+		while (expected_index != expected.size() && expected[expected_index] < minimum) ++expected_index;
+		if (expected_index == expected.size()) expected_index = std::numeric_limits<std::size_t>::max();
+		if (values.next_at_least(begin, minimum) != expected_index) return false;
+	}
+
+	return true;
+}
+
+
+
+template <unsigned int bits_per_element, typename storage_type>
+bool random_operations_test(const std::size_t size)
+{
+	typedef plf::packed_bitset<bits_per_element, false, storage_type> packed_type;
+	const unsigned int max_value = packed_type::max_value;
+
+	packed_type values(size);
+	std::vector<unsigned int> expected(size, 0);
+	bool passed = matches(values, expected) && values.none();
+
+	for (unsigned int round = 0; round != 300 && passed; ++round)
+	{
+		std::size_t begin = static_cast<std::size_t>(rand()) % size, end = static_cast<std::size_t>(rand()) % (size + 1);
+		if (begin > end) std::swap(begin, end);
+		const unsigned int value = static_cast<unsigned int>(rand()) % (max_value + 1);
+
+		switch (rand() % 8)
+		{
+			case 0:
+				values.set(begin, value);
+				expected[begin] = value;
+				break;
+			case 1:
+				values.set_range(begin, end, value);
+				for (std::size_t index = begin; index != end; ++index) expected[index] = value;
+				break;
+			case 2:
+				values.increment_range(begin, end);
+				for (std::size_t index = begin; index != end; ++index) if (expected[index] != max_value) ++expected[index];
+				break;
+			case 3:
+				values.decrement_range(begin, end);
+				for (std::size_t index = begin; index != end; ++index) if (expected[index] != 0) --expected[index];
+				break;
+			case 4:
+				values.increment_all();
+				for (std::size_t index = 0; index != size; ++index) if (expected[index] != max_value) ++expected[index];
+				break;
+			case 5:
+				values.decrement_all();
+				for (std::size_t index = 0; index != size; ++index) if (expected[index] != 0) --expected[index];
+				break;
+			case 6:
+				passed = values.increment(begin) == ((expected[begin] != max_value) ? ++expected[begin] : expected[begin]);
+				break;
+			default:
+				passed = values.decrement(begin) == ((expected[begin] != 0) ? --expected[begin] : expected[begin]);
+		}
+
+		if (round % 10 == 0) passed = passed && matches(values, expected);
+	}
+
+	// Saturate everything, then check that no increments leaked into the unused elements of the final storage_type:
+	values.set(max_value);
+	values.increment_all();
+	std::vector<unsigned int> saturated(size, max_value);
+	passed = passed && matches(values, saturated) && values.count() == size;
+
+	values.reset();
+	return passed && values.none() && values.first_nonzero() == std::numeric_limits<std::size_t>::max();
+}
+
+
+
+
+
+int main()
+{
+	srand(11);
+
+	{
+		message("Element width tests\n==================================\n\n");
+
+		failpass("1-bit elements test", random_operations_test<1, unsigned long long>(64 * 20 + 13) && random_operations_test<1, unsigned char>(8 * 40 + 3));
+		failpass("2-bit elements test", random_operations_test<2, unsigned long long>(32 * 30 + 5) && random_operations_test<2, unsigned int>(16 * 30 + 1));
+		failpass("4-bit elements test", random_operations_test<4, unsigned long long>(16 * 50 + 7) && random_operations_test<4, unsigned char>(2 * 100 + 1));
+		failpass("8-bit elements test", random_operations_test<8, unsigned long long>(8 * 100 + 3) && random_operations_test<8, unsigned char>(333));
+	}
+
+
+	{
+		message("Counting filter tests\n==================================\n\n");
+
+		plf::packed_bitset<4> counters(100000);
+		counters.set_range(1000, 2000, 3);
+		counters.set_range(1500, 1600, 15);
+		counters.increment_range(1550, 50000);
+
+		failpass("Count at least test", counters.count_at_least(1) == 1000 + 48000 && counters.count_at_least(4) == 100 + 400 && counters.count_at_least(15) == 100);
+		failpass("Count range test", counters.count_range(0, 1000) == 0 && counters.count_range(990, 1010) == 10 && counters.count() == 49000);
+		failpass("Next test", counters.next_nonzero(0) == 1000 && counters.next_at_least(0, 15) == 1500 && counters.next_at_least(1600, 4) == 1600 && counters.next_nonzero(50000) == std::numeric_limits<std::size_t>::max());
+
+		for (unsigned int age = 0; age != 4; ++age) counters.decrement_all();
+		failpass("Age-out test", counters.count() == 100 && counters.first_nonzero() == 1500 && counters[1550] == 11);
+
+		plf::packed_bitset<4> copy(counters);
+		failpass("Copy test", copy == counters && copy.count() == 100);
+		copy.reset(1500);
+		failpass("Inequality test", copy != counters && copy.first_nonzero() == 1501);
+		plf::packed_bitset<4, false, unsigned long long> nibbles(32);
+		nibbles.set(1, 5);
+		nibbles.set(17, 9);
+		failpass("words() test", nibbles.words()[0] == 0x50 && nibbles.words()[1] == 0x90);
+
+	}
+
+
+	{
+		message("Borrowed buffer tests\n==================================\n\n");
+
+		std::vector<unsigned int> buffer(10, 0xFFFFFFFF);
+		{
+			plf::packed_bitset<2, true, unsigned int> ages(70, &buffer[0]);
+			failpass("Reset supplied buffer test", ages.none());
+			ages.set(69, 2);
+			ages.set(0, 1);
+		}
+
+		plf::packed_bitset<2, true, unsigned int> reopened(70, &buffer[0], false);
+		failpass("Adopt supplied buffer test", reopened[69] == 2 && reopened[0] == 1 && reopened.count() == 2);
+
+		buffer[4] = 0xFFFFFFFF; // elements 64-79, of which 70-79 are beyond size()
+		plf::packed_bitset<2, true, unsigned int> overflowed(70, &buffer[0], false);
+		failpass("Adopted overflow elements test", overflowed.count() == 7 && overflowed.count_at_least(3) == 6);
+	}
+
+
+	{
+		message("Hardened tests\n==================================\n\n");
+
+		plf::packed_bitset<4, false, std::size_t, std::allocator<std::size_t>, true> values(100);
+		bool index_thrown = false, value_thrown = false, range_thrown = false;
+
+		try
+		{
+			values.set(100, 1);
+		}
+		catch (std::out_of_range &)
+		{
+			index_thrown = true;
+		}
+
+		try
+		{
+			values.set(5, 16);
+		}
+		catch (std::out_of_range &)
+		{
+			value_thrown = true;
+		}
+
+		try
+		{
+			values.increment_range(50, 101);
+		}
+		catch (std::out_of_range &)
+		{
+			range_thrown = true;
+		}
+
+		values.set_range(0, 100, 9);
+		failpass("Hardened checks test", index_thrown && value_thrown && range_thrown && values.count_at_least(9) == 100 && values.at(99) == 9);
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}
@@ -0,0 +1,452 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// Computing For Good License v1.01 (https://plflib.org/computing_for_good_license.htm):
+// This code is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this code.
+//
+// Permission is granted to use this code by anyone and for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+//
+// 1. 	The origin of this code must not be misrepresented; you must not claim that you wrote the original code. If you use this code in software, an acknowledgement in the product documentation would be appreciated but is not required.
+// 2. 	Altered code versions must be plainly marked as such, and must not be misrepresented as being the original code.
+// 3. 	This notice may not be removed or altered from any code distribution, including altered code versions.
+// 4. 	This code and altered code versions may not be used by groups, companies, individuals or in software whose primary or partial purpose is to:
+// 	 a.	 Promote addiction or substance-based intoxication.
+// 	 b.	 Cause harm to, or violate the rights of, other sentient beings.
+// 	 c.	 Distribute, obtain or utilize software, media or other materials without the consent of the owners.
+// 	 d.	 Deliberately spread misinformation or encourage dishonesty.
+// 	 e.	 Pursue personal profit at the cost of broad-scale environmental harm.
+
+
+
+#ifndef PLF_SLOT_ALLOCATOR_H
+#define PLF_SLOT_ALLOCATOR_H
+
+
+#include "plf_bitsetb.h" // occupancy and summary levels
+
+
+// Compiler-specific defines:
+
+// defaults before potential redefinitions:
+#define PLF_NOEXCEPT throw()
+#define PLF_EXCEPTIONS_SUPPORT
+#define PLF_CONSTEXPR
+
+
+#if ((defined(__clang__) || defined(__GNUC__)) && !defined(__EXCEPTIONS)) || (defined(_MSC_VER) && !defined(_CPPUNWIND))
+	#undef PLF_EXCEPTIONS_SUPPORT
+	#include <exception> // std::terminate
+#endif
+
+
+#if defined(_MSC_VER) && !defined(__clang__) && !defined(__GNUC__)
+	#if _MSC_VER >= 1900
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	#if defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L) && _MSC_VER >= 1929
+		#define PLF_CPP20_SUPPORT
+	#endif
+#elif defined(__cplusplus) && __cplusplus >= 201103L // C++11 support, at least
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || __GNUC__ > 4
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#elif defined(__clang__)
+		#if __has_feature(cxx_noexcept)
+			#undef PLF_NOEXCEPT
+			#define PLF_NOEXCEPT noexcept
+		#endif
+	#else // Assume support for other compilers
+		#undef PLF_NOEXCEPT
+		#define PLF_NOEXCEPT noexcept
+	#endif
+
+	#if __cplusplus >= 201703L && ((defined(__clang__) && ((__clang_major__ == 3 && __clang_minor__ == 9) || __clang_major__ > 3)) || (defined(__GNUC__) && __GNUC__ >= 7) || (!defined(__clang__) && !defined(__GNUC__))) // assume correct C++17 implementation for non-gcc/clang compilers
+		#undef PLF_CONSTEXPR
+		#define PLF_CONSTEXPR constexpr
+	#endif
+
+	#if __cplusplus >= 202001L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) &&	_GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
+		#define PLF_CPP20_SUPPORT
+	#endif
+#endif
+
+
+#define PLF_TYPE_BITWIDTH (sizeof(storage_type) * 8)
+
+
+#include <memory> // std::allocator
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <limits>  // std::numeric_limits
+
+
+
+namespace plf
+{
+
+
+// Hands out indexes of free slots in a fixed-size pool, eg. for an object pool. The occupancy bitset has a summary level above it - one bit per occupancy storage_type, set when that storage_type has no free slots - so finding a free slot skips PLF_TYPE_BITWIDTH^2 occupied slots per summary storage_type searched, rather than degrading linearly as the pool fills. Searches start from a hint cursor (the storage_type most recently allocated from or released into), so that successive allocations stay close together and typically take the first storage_type tried.
+// The occupancy level is a plf::bitsetb<user_supplied_buffer, ...>, so that the pool's occupancy can live in (and be adopted from) user-supplied memory.
+template<bool user_supplied_buffer = false, typename storage_type = std::size_t, class allocator_type = std::allocator<storage_type>, bool hardened = false>
+class slot_allocator
+{
+public:
+	typedef std::size_t size_type;
+	typedef bitsetb<user_supplied_buffer, storage_type, allocator_type> occupancy_type;
+
+private:
+	occupancy_type occupied;
+	bitsetb<false, storage_type, allocator_type> full_words;
+	size_type hint, total_allocated;
+
+
+
+	storage_type word_mask(const size_type word_index) const PLF_NOEXCEPT
+	{
+		return (word_index != full_words.size() - 1 || occupied.size() % PLF_TYPE_BITWIDTH == 0) ? std::numeric_limits<storage_type>::max() : static_cast<storage_type>(std::numeric_limits<storage_type>::max() >> (PLF_TYPE_BITWIDTH - (occupied.size() % PLF_TYPE_BITWIDTH)));
+	}
+
+
+
+	void update_summary(const size_type first_word, const size_type last_word) PLF_NOEXCEPT
+	{
+		for (size_type word_index = first_word; word_index <= last_word; ++word_index) full_words.set(word_index, occupied.data()[word_index] == word_mask(word_index));
+	}
+
+
+
+	// Index of the first storage_type with a free slot, searching from the hint and wrapping around, or std::numeric_limits<size_type>::max() if the pool is full:
+	size_type find_free_word() PLF_NOEXCEPT
+	{
+		if (total_allocated == occupied.size()) return std::numeric_limits<size_type>::max();
+
+		const size_type word_index = full_words.next_zero(hint);
+		return (word_index != std::numeric_limits<size_type>::max()) ? word_index : full_words.next_zero(0);
+	}
+
+
+
+	// First free slot at or after index, skipping full storage_types via the summary level:
+	size_type next_free(const size_type index) PLF_NOEXCEPT
+	{
+		if (index >= occupied.size()) return std::numeric_limits<size_type>::max();
+
+		const size_type word_index = full_words.next_zero(index / PLF_TYPE_BITWIDTH);
+		if (word_index == std::numeric_limits<size_type>::max()) return word_index;
+		return occupied.next_zero((word_index == index / PLF_TYPE_BITWIDTH) ? index : word_index * PLF_TYPE_BITWIDTH);
+	}
+
+
+
+	void check_range_is_within_size(const size_type begin, const size_type end) const
+	{
+		if (begin >= end || end > occupied.size())
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::out_of_range("Slot index larger than size of slot_allocator");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	void check_slots_are_allocated(const size_type begin, const size_type end) const
+	{
+		check_range_is_within_size(begin, end);
+
+		if (occupied.count_range(begin, end) != end - begin)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::invalid_argument("Not all slots are allocated, cannot release.");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+public:
+
+	// If reset_supplied_buffer is false, the existing occupancy in a user-supplied buffer is adopted (eg. a pool restored from disk), as per plf::bitsetb. number_of_slots must be > 0:
+	explicit slot_allocator(const size_type number_of_slots, storage_type * const supplied_buffer = NULL, const bool reset_supplied_buffer = true):
+		occupied(number_of_slots, supplied_buffer, reset_supplied_buffer),
+		full_words((number_of_slots + PLF_TYPE_BITWIDTH - 1) / PLF_TYPE_BITWIDTH),
+		hint(0),
+		total_allocated(0)
+	{
+		if (user_supplied_buffer && !reset_supplied_buffer)
+		{
+			total_allocated = occupied.count();
+			update_summary(0, full_words.size() - 1);
+		}
+	}
+
+
+
+	// Returns the index of the claimed slot, or std::numeric_limits<size_type>::max() if the pool is full:
+	size_type allocate() PLF_NOEXCEPT
+	{
+		const size_type word_index = find_free_word();
+		if (word_index == std::numeric_limits<size_type>::max()) return word_index;
+
+		storage_type &word = occupied.data()[word_index];
+		const size_type bit_index = plf::count_trailing_zeros(static_cast<storage_type>(~word));
+
+		word |= storage_type(1) << bit_index;
+		if (word == word_mask(word_index)) full_words.set(word_index);
+
+		hint = word_index;
+		++total_allocated;
+		return (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+	}
+
+
+
+	// Claims up to number_of_slots slots, writing their indexes to results. Takes every free slot in a storage_type before moving on to the next. Returns the number of slots claimed, which is only less than number_of_slots if the pool is full:
+	size_type allocate(size_type * const results, const size_type number_of_slots) PLF_NOEXCEPT
+	{
+		size_type claimed = 0;
+
+		while (claimed != number_of_slots)
+		{
+			const size_type word_index = find_free_word();
+			if (word_index == std::numeric_limits<size_type>::max()) break;
+
+			const storage_type mask = word_mask(word_index);
+			storage_type word = occupied.data()[word_index];
+
+			for (storage_type free_slots = static_cast<storage_type>(~word & mask); free_slots != 0 && claimed != number_of_slots; free_slots &= static_cast<storage_type>(free_slots - 1))
+			{
+				const size_type bit_index = plf::count_trailing_zeros(free_slots);
+				word |= storage_type(1) << bit_index;
+				results[claimed++] = (word_index * PLF_TYPE_BITWIDTH) + bit_index;
+			}
+
+			occupied.data()[word_index] = word;
+			if (word == mask) full_words.set(word_index);
+
+			hint = word_index;
+		}
+
+		total_allocated += claimed;
+		return claimed;
+	}
+
+
+
+	// Claims length adjacent slots, returning the index of the first, or std::numeric_limits<size_type>::max() if there is no free run that long. First-fit from the start of the pool:
+	size_type allocate_contiguous(const size_type length) PLF_NOEXCEPT
+	{
+		if (length == 0 || length > occupied.size() - total_allocated) return std::numeric_limits<size_type>::max();
+		if (length == 1) return allocate();
+
+		const size_type first_free = next_free(0); // skips leading full storage_types via the summary level
+		const size_type begin = (first_free == std::numeric_limits<size_type>::max()) ? first_free : occupied.find_zero_run(length, first_free);
+		if (begin == std::numeric_limits<size_type>::max()) return begin;
+
+		occupied.set_range(begin, begin + length);
+		update_summary(begin / PLF_TYPE_BITWIDTH, (begin + length - 1) / PLF_TYPE_BITWIDTH);
+		total_allocated += length;
+		return begin;
+	}
+
+
+
+	void release(const size_type index)
+	{
+		if PLF_CONSTEXPR (hardened) check_slots_are_allocated(index, index + 1);
+
+		occupied.reset(index);
+		hint = index / PLF_TYPE_BITWIDTH;
+		full_words.reset(hint);
+		--total_allocated;
+	}
+
+
+
+	void release_contiguous(const size_type begin, const size_type length)
+	{
+		if (length == 0) return;
+
+		if PLF_CONSTEXPR (hardened) check_slots_are_allocated(begin, begin + length);
+
+		occupied.reset_range(begin, begin + length);
+		full_words.reset_range(begin / PLF_TYPE_BITWIDTH, ((begin + length - 1) / PLF_TYPE_BITWIDTH) + 1);
+		hint = begin / PLF_TYPE_BITWIDTH;
+		total_allocated -= length;
+	}
+
+
+
+	bool is_allocated(const size_type index) const
+	{
+		if PLF_CONSTEXPR (hardened) check_range_is_within_size(index, index + 1);
+		return occupied[index];
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		occupied.reset();
+		full_words.reset();
+		hint = total_allocated = 0;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return occupied.size();
+	}
+
+
+
+	size_type allocated() const PLF_NOEXCEPT
+	{
+		return total_allocated;
+	}
+
+
+
+	size_type available() const PLF_NOEXCEPT
+	{
+		return occupied.size() - total_allocated;
+	}
+
+
+
+	const occupancy_type & occupancy() const PLF_NOEXCEPT
+	{
+		return occupied;
+	}
+};
+
+
+
+// A per-thread front end for a slot_allocator which is shared between threads, intended to be declared thread_local (or otherwise owned by a single thread). Slots are claimed from and returned to the shared allocator in batches of cache_capacity / 2, with shared_mutex (anything with lock() and unlock(), eg. std::mutex) held only during those batch operations - so most allocate() and release() calls touch no shared state at all.
+// Slots held in a cache count as allocated in the shared allocator. Any remaining are returned on destruction, or via flush():
+template <class slot_allocator_type, class mutex_type, std::size_t cache_capacity = 64>
+class slot_allocator_cache
+{
+public:
+	typedef std::size_t size_type;
+
+private:
+	slot_allocator_type &shared;
+	mutex_type &shared_mutex;
+	size_type cached[cache_capacity];
+	size_type number_cached;
+
+	typedef char cache_capacity_must_be_at_least_2[(cache_capacity >= 2) ? 1 : -1]; // C++03 static_assert
+
+
+	struct scoped_lock // std::lock_guard is C++11
+	{
+		mutex_type &locked;
+
+		explicit scoped_lock(mutex_type &mutex): locked(mutex)
+		{
+			locked.lock();
+		}
+
+		~scoped_lock()
+		{
+			locked.unlock();
+		}
+	};
+
+
+
+	// Returns the oldest number_to_return cached slots to the shared allocator:
+	void return_slots(const size_type number_to_return)
+	{
+		{
+			scoped_lock lock(shared_mutex);
+			for (size_type index = 0; index != number_to_return; ++index) shared.release(cached[index]);
+		}
+
+		for (size_type index = number_to_return; index != number_cached; ++index) cached[index - number_to_return] = cached[index];
+		number_cached -= number_to_return;
+	}
+
+
+	slot_allocator_cache(const slot_allocator_cache &); // non-copyable, as the cached slots are owned by exactly one cache
+	void operator = (const slot_allocator_cache &);
+
+
+public:
+
+	slot_allocator_cache(slot_allocator_type &shared_allocator, mutex_type &mutex):
+		shared(shared_allocator),
+		shared_mutex(mutex),
+		number_cached(0)
+	{}
+
+
+
+	~slot_allocator_cache()
+	{
+		flush();
+	}
+
+
+
+	// Returns std::numeric_limits<size_type>::max() if both the cache and the shared pool are empty:
+	size_type allocate()
+	{
+		if (number_cached == 0)
+		{
+			scoped_lock lock(shared_mutex);
+			number_cached = shared.allocate(cached, cache_capacity / 2);
+			if (number_cached == 0) return std::numeric_limits<size_type>::max();
+		}
+
+		return cached[--number_cached]; // most recently released first, as it is most likely to be in cache
+	}
+
+
+
+	void release(const size_type index)
+	{
+		if (number_cached == cache_capacity) return_slots(cache_capacity / 2);
+		cached[number_cached++] = index;
+	}
+
+
+
+	void flush()
+	{
+		if (number_cached != 0) return_slots(number_cached);
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return number_cached;
+	}
+};
+
+
+} // plf namespace
+
+
+#undef PLF_CPP20_SUPPORT
+#undef PLF_CONSTEXPR
+#undef PLF_NOEXCEPT
+#undef PLF_EXCEPTIONS_SUPPORT
+
+#undef PLF_TYPE_BITWIDTH
+
+#endif // PLF_SLOT_ALLOCATOR_H
@@ -0,0 +1,231 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include "plf_slot_allocator.h"
+
+#if __cplusplus >= 201103L
+	#include <thread>
+	#include <mutex>
+#endif
+
+
+void message(const char *message_text)
+{
+	printf("%s\n", message_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail. Press ENTER to quit.");
+		getchar();
+		abort();
+	}
+}
+
+
+
+struct counting_mutex // single-threaded stand-in for std::mutex
+{
+	unsigned int locks, depth;
+
+	counting_mutex(): locks(0), depth(0) {}
+
+	void lock()
+	{
+		++locks;
+		++depth;
+	}
+
+	void unlock()
+	{
+		--depth;
+	}
+};
+
+
+
+#if __cplusplus >= 201103L
+	typedef plf::slot_allocator<> shared_allocator_type;
+
+	void thread_workload(shared_allocator_type &shared, std::mutex &mutex, std::vector<std::size_t> &claimed)
+	{
+		thread_local plf::slot_allocator_cache<shared_allocator_type, std::mutex> cache(shared, mutex);
+
+		for (unsigned int round = 0; round != 1000; ++round)
+		{
+			const std::size_t first = cache.allocate(), second = cache.allocate();
+			cache.release(first);
+			claimed.push_back(second);
+		}
+
+		cache.flush();
+	}
+#endif
+
+
+
+
+
+int main()
+{
+	{
+		message("Allocation tests\n==================================\n\n");
+
+		plf::slot_allocator<> slots(1000);
+		std::vector<bool> seen(1000, false);
+		bool unique = true;
+
+		for (std::size_t counter = 0; counter != 1000; ++counter)
+		{
+			const std::size_t index = slots.allocate();
+			unique = unique && index < 1000 && !seen[index];
+			if (index < 1000) seen[index] = true;
+		}
+
+		failpass("Allocate every slot test", unique && slots.allocated() == 1000 && slots.available() == 0 && slots.occupancy().count() == 1000);
+		failpass("Full pool test", slots.allocate() == std::numeric_limits<std::size_t>::max());
+
+		slots.release(500);
+		slots.release(3);
+		failpass("Release test", slots.allocated() == 998 && !slots.is_allocated(500) && !slots.is_allocated(3));
+
+		const std::size_t first = slots.allocate(), second = slots.allocate();
+		failpass("Reuse released slots test", ((first == 3 && second == 500) || (first == 500 && second == 3)) && slots.allocate() == std::numeric_limits<std::size_t>::max());
+
+		slots.clear();
+		failpass("Clear test", slots.allocated() == 0 && slots.allocate() == 0);
+	}
+
+
+	{
+		message("Batch allocation tests\n==================================\n\n");
+
+		plf::slot_allocator<false, unsigned int> slots(100);
+		for (std::size_t index = 0; index < 100; index += 3) slots.allocate(); // slots 0-33 allocated
+
+		std::vector<std::size_t> results(100);
+		const std::size_t claimed = slots.allocate(&results[0], 100);
+		std::sort(results.begin(), results.begin() + claimed);
+
+		failpass("Batch claims remaining slots test", claimed == 66 && std::adjacent_find(results.begin(), results.begin() + claimed) == results.begin() + claimed && results[0] == 34 && results[65] == 99);
+		failpass("Batch full pool test", slots.allocated() == 100 && slots.allocate(&results[0], 10) == 0);
+	}
+
+
+	{
+		message("Contiguous allocation tests\n==================================\n\n");
+
+		plf::slot_allocator<> slots(300);
+		std::vector<std::size_t> results(300);
+		slots.allocate(&results[0], 300);
+
+		for (std::size_t index = 10; index != 14; ++index) slots.release(index); // run of 4
+		for (std::size_t index = 64; index != 200; ++index) slots.release(index); // run of 136, crossing storage_type boundaries
+
+		failpass("First-fit test", slots.allocate_contiguous(3) == 10 && slots.allocate_contiguous(2) == 64 && slots.allocate_contiguous(100) == 66);
+		failpass("Too-long run test", slots.allocate_contiguous(35) == std::numeric_limits<std::size_t>::max() && slots.allocate_contiguous(34) == 166);
+
+		slots.release_contiguous(66, 100);
+		failpass("Release contiguous test", slots.allocated() == 300 - 101 && slots.allocate_contiguous(101) == std::numeric_limits<std::size_t>::max() && slots.allocate_contiguous(100) == 66 && slots.available() == 1);
+	}
+
+
+	{
+		message("User-supplied buffer tests\n==================================\n\n");
+
+		std::vector<std::size_t> buffer(2, 0);
+		buffer[0] = ~std::size_t(0); // slots 0-63 allocated (or 0-31 for 32-bit size_t)
+		buffer[1] = 1;
+
+		plf::slot_allocator<true> slots(sizeof(std::size_t) * 8 + 10, &buffer[0], false);
+		failpass("Adopt occupancy test", slots.allocated() == sizeof(std::size_t) * 8 + 1 && slots.allocate() == sizeof(std::size_t) * 8 + 1);
+	}
+
+
+	{
+		message("Hardened tests\n==================================\n\n");
+
+		plf::slot_allocator<false, std::size_t, std::allocator<std::size_t>, true> slots(100);
+		slots.allocate();
+		bool double_release_thrown = false, range_thrown = false;
+
+		slots.release(0);
+
+		try
+		{
+			slots.release(0);
+		}
+		catch (std::invalid_argument &)
+		{
+			double_release_thrown = true;
+		}
+
+		try
+		{
+			slots.release_contiguous(90, 11);
+		}
+		catch (std::out_of_range &)
+		{
+			range_thrown = true;
+		}
+
+		failpass("Hardened release tests", double_release_thrown && range_thrown && slots.allocated() == 0);
+	}
+
+
+	{
+		message("Cache tests\n==================================\n\n");
+
+		plf::slot_allocator<> shared(1000);
+		counting_mutex mutex;
+
+		{
+			plf::slot_allocator_cache<plf::slot_allocator<>, counting_mutex, 16> cache(shared, mutex);
+
+			std::vector<std::size_t> claimed;
+			for (std::size_t counter = 0; counter != 100; ++counter) claimed.push_back(cache.allocate());
+
+			std::vector<std::size_t> sorted(claimed);
+			std::sort(sorted.begin(), sorted.end());
+			failpass("Cache allocate test", std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end() && mutex.locks == 13 && mutex.depth == 0);
+
+			for (std::size_t counter = 0; counter != 100; ++counter) cache.release(claimed[counter]);
+			failpass("Cache release test", cache.size() <= 16 && shared.allocated() == cache.size() && mutex.depth == 0);
+		}
+
+		failpass("Cache flush on destruction test", shared.allocated() == 0);
+
+		#if __cplusplus >= 201103L
+			plf::slot_allocator<> large_shared(5000);
+			std::mutex shared_mutex;
+			std::vector<std::size_t> claimed[4];
+			std::thread threads[4];
+
+			for (unsigned int index = 0; index != 4; ++index) threads[index] = std::thread(thread_workload, std::ref(large_shared), std::ref(shared_mutex), std::ref(claimed[index]));
+			for (unsigned int index = 0; index != 4; ++index) threads[index].join();
+
+			std::vector<std::size_t> all;
+			for (unsigned int index = 0; index != 4; ++index) all.insert(all.end(), claimed[index].begin(), claimed[index].end());
+			std::sort(all.begin(), all.end());
+
+			failpass("Multithreaded cache test", all.size() == 4000 && std::adjacent_find(all.begin(), all.end()) == all.end() && all.back() < 5000 && large_shared.allocated() == 4000);
+		#endif
+	}
+
+
+	printf("Press ENTER to quit");
+	getchar();
+
+
+	return 0;
+}